@@ -2,11 +2,21 @@
 
 // Includes
 #include "app_delegate.hxx"
+#include "engines/asset/asset_engine.hxx"
 #include "engines/firebase/firebase_engine.hxx"
 #include "engines/fmod/fmod_engine.hxx"
 #include "engines/language/language_engine.hxx"
+#include "scenes/benchmark/map_benchmark_scene.hxx"
+#include "scenes/benchmark/parse_benchmark_scene.hxx"
+#include "scenes/benchmark/particle_benchmark_scene.hxx"
+#include "scenes/benchmark/physics_benchmark_scene.hxx"
+#include "scenes/benchmark/render_benchmark_scene.hxx"
+#include "scenes/benchmark/scheduler_benchmark_scene.hxx"
+#include "scenes/game/base_game_scene.hxx"
 #include "scenes/intro/intro_scene.hxx"
 #include "utils/data/data_utils.hxx"
+#include "utils/particle/particle_utils.hxx"
+#include "utils/snapshot/snapshot_utils.hxx"
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID or CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
 #include "utils/archive/archive_utils.hxx"
@@ -30,14 +40,24 @@ bool AppDelegate::applicationDidFinishLaunching() {
   initDatabase();
   initFirebase();
   copyLoadAssets();
+  initParticles();
   createAndRunScene();
   return true;
 }
 
+void AppDelegate::applicationDidReceiveMemoryWarning() {
+  // Drop every texture that isn't on screen. Anything needed again is reloaded by the next scene.
+  AssetEngine::getInstance()->purge();
+}
+
 void AppDelegate::applicationDidEnterBackground() {
   Director::getInstance()->stopAnimation();
   AudioUtils::getInstance()->pauseMixer();
 
+  // The OS may kill the app while it is in the background. Save the game so it can be resumed.
+  const auto game_scene = dynamic_cast<BaseGameScene*>(Director::getInstance()->getRunningScene());
+  if (game_scene not_eq nullptr) game_scene->saveSnapshot();
+
   // Destroy the instance of the language engine just in case the user changes the
   // system language
   LanguageEngine::destroyInstance();
@@ -105,13 +125,39 @@ void AppDelegate::initFirebase() { FirebaseEngine::getInstance(); }
 
 void AppDelegate::copyLoadAssets() {
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID or CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
-  auto data = FileUtils::getInstance()->getDataFromFile(
-      FileUtils::getInstance()->fullPathForFilename(__ARCHIVE_NAME__));
+  // The archive is mapped where it can be, so it is written out without being copied into memory first.
+  const auto view = FileUtils::getInstance()->mapFile(__ARCHIVE_NAME__);
+  if (view == nullptr or view->isNull()) return;
+
+  Data data;
+  data.fastSet(const_cast<unsigned char*>(view->getBytes()), view->getSize());
   FileUtils::getInstance()->writeDataToFile(data,
                                             FileUtils::getInstance()->getWritablePath() + __ARCHIVE_NAME__);
+
+  // The bytes belong to the view.
+  data.fastSet(nullptr, 0);
 #endif
 }
 
+void AppDelegate::initParticles() { ParticleUtils::loadAtlas(); }
+
 void AppDelegate::createAndRunScene() {
+#ifdef __APP_DELEGATE_BENCHMARK__
+  Director::getInstance()->runWithScene(__APP_DELEGATE_BENCHMARK__::create());
+  return;
+#endif
+
+  GameSnapshot snapshot;
+  if (SnapshotUtils::load(snapshot)) {
+    const auto scene = SceneUtils::resumeScene(snapshot);
+
+    // A snapshot is only ever resumed once, so a snapshot that fails to restore can't trap the player.
+    SnapshotUtils::clear();
+    if (scene not_eq nullptr) {
+      Director::getInstance()->runWithScene(scene);
+      return;
+    }
+  }
+
   Director::getInstance()->runWithScene(IntroScene::create(IntroScene::generateParams(), nullptr));
 }
@@ -37,6 +37,16 @@
 #define __APP_DELEGATE_RECT_LG_G6__ Rect(Vec2(0, 0), Size(720, 1440))
 #define __APP_DELEGATE_RECT_LG_G6_SMALL__ Rect(Vec2(0, 0), Size(360, 720))
 
+/**
+ * Benchmarks. Uncomment one to run it in place of the game.
+ */
+// #define __APP_DELEGATE_BENCHMARK__ RenderBenchmarkScene
+// #define __APP_DELEGATE_BENCHMARK__ PhysicsBenchmarkScene
+// #define __APP_DELEGATE_BENCHMARK__ MapBenchmarkScene
+// #define __APP_DELEGATE_BENCHMARK__ ParticleBenchmarkScene
+// #define __APP_DELEGATE_BENCHMARK__ ParseBenchmarkScene
+// #define __APP_DELEGATE_BENCHMARK__ SchedulerBenchmarkScene
+
 /**
  * Includes
  */
@@ -54,6 +64,11 @@ class AppDelegate : Application {
    */
   virtual ~AppDelegate();
 
+  /**
+   * Called when the OS warns that memory is low. Must be called on the GL thread.
+   */
+  static void applicationDidReceiveMemoryWarning();
+
  protected:
   /**
    * The values of glContextAttrs that determine the context of the game. This will takes effect
@@ -108,7 +123,13 @@ class AppDelegate : Application {
   static void copyLoadAssets();
 
   /**
-   * Creates and instance of scenes and runs the application.
+   * Caches the particle atlas. Must run after the archive has been copied.
+   */
+  static void initParticles();
+
+  /**
+   * Creates and instance of scenes and runs the application. If a snapshot was left behind when the app was
+   * last sent to the background, the game scene is resumed instead of starting from the intro.
    */
   static void createAndRunScene();
 
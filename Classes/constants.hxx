@@ -34,6 +34,7 @@
 #define __FLIP__ "flip"
 #define __FONT__ "font"
 #define __FILE_NAME__ "file_name"
+#define __FRAMES__ "frames"
 #define __GIDS__ "gids"
 #define __H_ALIGNMENT__ "h_alignment"
 #define __ID__ "id"
@@ -70,6 +71,7 @@
 #define __SIZE__ "size"
 #define __SELECTED_IMAGE__ "selected_image"
 #define __SCRIPT__ "script"
+#define __SEED__ "seed"
 #define __SPEED__ "speed"
 #define __SPIN__ "spin"
 #define __SPRITES__ "sprites"
@@ -85,6 +87,18 @@
 #define __V_ALIGNMENT__ "v_alignment"
 #define __ZINDEX__ "z_index"
 
+/**
+ * Trace category used by game-side CC_PROFILER_TRACE_CATEGORY markers
+ */
+#define __TRACE_CATEGORY__ "evermaze"
+
+/**
+ * Physics. Most cells the broadphase spatial hash is given, and how long a body has to stand still before it
+ * is put to sleep, in seconds.
+ */
+#define __PHYSICS_SPATIAL_HASH_CELLS__ 4096
+#define __PHYSICS_SLEEP_THRESHOLD__ 0.5f
+
 /**
  * Setting Keys
  */
@@ -0,0 +1,151 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "asset_engine.hxx"
+#include "utils/archive/archive_utils.hxx"
+
+// Singleton Declaration
+atomic<AssetEngine*> AssetEngine::instance_;
+mutex AssetEngine::instance_mutex_;
+
+AssetEngine::AssetEngine() = default;
+
+AssetEngine::~AssetEngine() = default;
+
+AssetEngine* AssetEngine::getInstance() {
+  auto init = instance_.load(memory_order_relaxed);
+  atomic_thread_fence(memory_order_acquire);
+
+  if (init == nullptr) {
+    // Invoke lock guards.
+    lock_guard<mutex> lock(instance_mutex_);
+    init = instance_.load(memory_order_relaxed);
+
+    // Initialize a new instance if we are still null
+    if (init == nullptr) {
+      init = new (nothrow) AssetEngine();
+
+      // Release guards
+      atomic_thread_fence(memory_order_release);
+
+      // Store new AssetEngine Instance
+      instance_.store(init, memory_order_relaxed);
+    }
+  }
+
+  // Return
+  return init;
+}
+
+void AssetEngine::destroyInstance() { CC_SAFE_DELETE(instance_); }
+
+void AssetEngine::acquire(const string& texture, const string& pack,
+                          const function<void(Texture2D*)>& callback) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "AssetEngine::acquire");
+  auto& group = groups_[texture];
+  group.references++;
+  group.last_used = ++tick_;
+
+  if (group.texture not_eq nullptr) {
+    callback(group.texture);
+    return;
+  }
+
+  // Only the first scene to ask for the group loads it, anyone else waits for that load.
+  group.pending.emplace_back(callback);
+  if (group.pending.size() > 1) return;
+
+  Director::getInstance()->getTextureCache()->addImageAsync(texture, [=](Texture2D* loaded) {
+    loaded->setAntiAliasTexParameters();
+    loaded->retain();
+
+    auto& group = groups_.at(texture);
+    group.texture = loaded;
+    group.bytes =
+        size_t(loaded->getPixelsWide()) * loaded->getPixelsHigh() * loaded->getBitsPerPixelForFormat() / 8;
+    resident_bytes_ += group.bytes;
+
+    // Cache the sprite frames using the loaded texture. This is the only time the pack is parsed.
+    auto plist = ArchiveUtils::loadValueMap(pack);
+    SpriteFrameCache::getInstance()->addSpriteFramesWithDictionary(plist, loaded);
+    if (plist.find(__FRAMES__) not_eq plist.end())
+      for (const auto& frame : plist.at(__FRAMES__).asValueMap()) {
+        const auto sprite_frame = SpriteFrameCache::getInstance()->getSpriteFrameByName(frame.first);
+        if (sprite_frame == nullptr) continue;
+        sprite_frame->retain();
+        group.frames.emplace_back(sprite_frame);
+      }
+
+    // Callbacks may acquire or release groups, so they run from a local list.
+    const auto pending = move(group.pending);
+    group.pending.clear();
+    for (const auto& function : pending) function(loaded);
+
+    trim();
+  });
+}
+
+void AssetEngine::release(const string& texture) {
+  const auto itr = groups_.find(texture);
+  if (itr == groups_.end()) return;
+
+  CCASSERT(itr->second.references > 0, "AssetEngine: Group released more times than it was acquired...");
+  itr->second.references--;
+  trim();
+}
+
+void AssetEngine::purge() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "AssetEngine::purge");
+  for (auto itr = groups_.begin(); itr not_eq groups_.end();) {
+    if (itr->second.references == 0 and itr->second.texture not_eq nullptr) {
+      evict(itr->second);
+      itr = groups_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+
+  // Anything else the engine cached, like font atlases, has to be rebuilt from scratch by the next user.
+  Director::getInstance()->purgeCachedData();
+  __CCLOGWITHFUNCTION("Resident textures: %zu bytes", resident_bytes_);
+}
+
+void AssetEngine::sweep() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "AssetEngine::sweep");
+  // Frames hold on to their texture, so unused frames have to go first.
+  SpriteFrameCache::getInstance()->removeUnusedSpriteFrames();
+  Director::getInstance()->getTextureCache()->removeUnusedTextures();
+}
+
+void AssetEngine::setBudget(const size_t budget) {
+  budget_ = budget;
+  trim();
+}
+
+size_t AssetEngine::getResidentBytes() const { return resident_bytes_; }
+
+void AssetEngine::trim() {
+  while (resident_bytes_ > budget_) {
+    auto oldest = groups_.end();
+    for (auto itr = groups_.begin(); itr not_eq groups_.end(); ++itr)
+      if (itr->second.references == 0 and itr->second.texture not_eq nullptr and
+          (oldest == groups_.end() or itr->second.last_used < oldest->second.last_used))
+        oldest = itr;
+
+    // Everything left is in use.
+    if (oldest == groups_.end()) return;
+
+    __CCLOGWITHFUNCTION("Evicting: %s", oldest->first.c_str());
+    evict(oldest->second);
+    groups_.erase(oldest);
+  }
+}
+
+void AssetEngine::evict(AssetGroup& group) {
+  for (const auto& frame : group.frames) frame->release();
+  SpriteFrameCache::getInstance()->removeSpriteFramesFromTexture(group.texture);
+
+  group.texture->release();
+  Director::getInstance()->getTextureCache()->removeTexture(group.texture);
+  resident_bytes_ -= group.bytes;
+}
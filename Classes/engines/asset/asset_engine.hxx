@@ -0,0 +1,142 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __ASSET_ENGINE_HXX__
+#define __ASSET_ENGINE_HXX__
+
+/**
+ * Default number of bytes of texture memory that can stay resident after the scenes using it have exited.
+ */
+#define __ASSET_MEMORY_BUDGET__ (64 * 1024 * 1024)
+
+/**
+ * Includes
+ */
+#include "globals.hxx"
+
+/**
+ * A texture and the sprite frames of its pack, as declared by the `texture` and `pack` of a scene script.
+ */
+struct AssetGroup {
+  // Loaded texture, nullptr while it is still being decoded.
+  Texture2D* texture{nullptr};
+
+  // Sprite frames of the pack. Retained so SpriteFrameCache::removeUnusedSpriteFrames() never drops them.
+  vector<SpriteFrame*> frames;
+
+  // Number of scenes currently using the group.
+  int references{0};
+
+  // Size of the texture in bytes.
+  size_t bytes{0};
+
+  // Value of AssetEngine#tick_ when the group was last acquired. The oldest unused group is evicted first.
+  uint64_t last_used{0};
+
+  // Callbacks waiting on the texture to finish loading.
+  vector<function<void(Texture2D*)>> pending;
+};
+
+class AssetEngine {
+  /**
+   * Constructor.
+   */
+  explicit AssetEngine();
+
+  /**
+   * Destructor.
+   */
+  virtual ~AssetEngine();
+
+ public:
+  /**
+   * Gets singleton instance of this class. If the instance is null, it will initialize it.
+   *
+   * @returns ~ The singleton instance of the AssetEngine.
+   *
+   * @note ~ This was implemented using acquire and release fences. Since the instance is wraped
+   * in a C++11 atomic type, we can manipulate it using relaxed atomic operations.
+   */
+  static AssetEngine* getInstance();
+
+  /**
+   * Destroys the instance of this class.
+   */
+  static void destroyInstance();
+
+  /**
+   * Takes a reference to a texture and its pack, loading them if they aren't already resident. Groups stay
+   * resident after their last reference is released, so going back to a scene is usually a cache hit.
+   *
+   * @param texture  ~ Path of the texture in the archive.
+   * @param pack     ~ Path of the plist with the sprite frames of the texture.
+   * @param callback ~ Called with the texture once the group is resident. Called immediately on a hit.
+   */
+  void acquire(const string& texture, const string& pack, const function<void(Texture2D*)>& callback);
+
+  /**
+   * Releases a reference taken with AssetEngine::acquire(). The group is only evicted once it is unused and
+   * the resident groups are over the budget.
+   *
+   * @param texture ~ Path of the texture in the archive.
+   */
+  void release(const string& texture);
+
+  /**
+   * Evicts every unused group and purges the engine caches. Called when the OS warns that memory is low.
+   */
+  void purge();
+
+  /**
+   * Drops textures that were loaded outside of any group, like tilesets, and that nothing uses anymore.
+   * Groups retain their texture and frames, so they are left to the budget.
+   */
+  void sweep();
+
+  /**
+   * Sets the number of bytes of texture memory that can stay resident, evicting unused groups if needed.
+   *
+   * @param budget ~ Budget in bytes.
+   */
+  void setBudget(size_t budget);
+
+  /**
+   * Gets the number of bytes of texture memory used by resident groups.
+   */
+  size_t getResidentBytes() const;
+
+ private:
+  /**
+   * Evicts the least recently used groups that are unused until the resident groups fit in the budget.
+   */
+  void trim();
+
+  /**
+   * Removes a group from the caches and releases everything it holds.
+   *
+   * @param group ~ Group to evict. Must be loaded and unused.
+   */
+  void evict(AssetGroup& group);
+
+  // Groups by texture path.
+  unordered_map<string, AssetGroup> groups_;
+
+  // Bytes of texture memory used by resident groups.
+  size_t resident_bytes_{0};
+
+  // Bytes of texture memory that can stay resident.
+  size_t budget_{__ASSET_MEMORY_BUDGET__};
+
+  // Incremented each time a group is acquired.
+  uint64_t tick_{0};
+
+  // Singleton instance of this class.
+  static atomic<AssetEngine*> instance_;
+
+  // Mutex to make accessing the singleton thread-safe
+  static mutex instance_mutex_;
+
+  // __DISALLOW_COPY_AND_ASSIGN__
+  __DISALLOW_COPY_AND_ASSIGN__(AssetEngine)
+};
+
+#endif  // __ASSET_ENGINE_HXX__
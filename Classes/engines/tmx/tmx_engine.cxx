@@ -40,6 +40,8 @@ TmxEngine* TmxEngine::getInstance() {
 void TmxEngine::destroyInstance() { CC_SAFE_DELETE(instance_); }
 
 void TmxEngine::cache(TMXTiledMap* map, const Modes mode) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxEngine::cache");
+
   // Check the cache to see if we have already cached a tmx object for this map before
   if (tmx_object_cache_.find(map->getName()) not_eq tmx_object_cache_.end()) return;
 
@@ -50,6 +52,36 @@ void TmxEngine::cache(TMXTiledMap* map, const Modes mode) {
     tmx_object_cache_.erase(tmx_object_cache_.begin(), itr);
   }
 
+  // Cache TmxObject
+  tmx_object_cache_.emplace(map->getName(), new TmxObject(*map, getConfig(mode)));
+}
+
+void TmxEngine::cache(TmxChunkMap* map, const Modes mode) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxEngine::cache");
+
+  // Chunked maps never share objects since each one holds only the chunks that map has streamed in. Any
+  // previous object with this name is still owned by its own map.
+  const auto tmx_object = new TmxObject(map->getMapSize(), map->getChunkSize(), getConfig(mode));
+  tmx_object_cache_[map->getName()] = tmx_object;
+  map->setTmxObject(tmx_object);
+}
+
+void TmxEngine::uncache(const string& key, const TmxObject* object) {
+  const auto itr = tmx_object_cache_.find(key);
+  if (itr not_eq tmx_object_cache_.end() and itr->second == object) tmx_object_cache_.erase(itr);
+}
+
+void TmxEngine::warm(const Modes mode) {
+  AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, [](void*) {}, nullptr, [=]() {
+    CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxEngine::warm");
+    getConfig(mode);
+  });
+}
+
+ValueVector TmxEngine::getConfig(const Modes mode) {
+  lock_guard<mutex> lock(config_mutex_);
+
+  // If the cache limit has been reached, We should clear half the cache from the top
   if (tmx_config_cache_.size() > __TMX_CONFIG_CACHE_LIMIT__ - 1) {
     auto itr = tmx_config_cache_.begin();
     advance(itr, __TMX_CONFIG_CACHE_LIMIT__ / 2);
@@ -74,8 +106,7 @@ void TmxEngine::cache(TMXTiledMap* map, const Modes mode) {
       tmx_config_cache_.emplace(TILES, ArchiveUtils::loadValueVector(__TMX_TILES_CONFIG__));
   }
 
-  // Cache TmxObject
-  tmx_object_cache_.emplace(map->getName(), new TmxObject(*map, tmx_config_cache_.at(mode)));
+  return tmx_config_cache_.at(mode);
 }
 
 TmxObject* TmxEngine::getTmxObject(const string& key) {
@@ -13,7 +13,7 @@
  * Config files to construct TmxObjects
  */
 #define __TMX_CONTROLS_CONFIG__ "configs/tmx_controls.plist"
-#define __TMX_ESCAPE_CONFIG__ "configs/tmx_tutorial.plist"
+#define __TMX_ESCAPE_CONFIG__ "configs/tmx_escape.plist"
 #define __TMX_ENERGY_CONFIG__ "configs/tmx_tutorial.plist"
 #define __TMX_SEARCH_CONFIG__ "configs/tmx_tutorial.plist"
 #define __TMX_SURVIVE_CONFIG__ "configs/tmx_tutorial.plist"
@@ -24,6 +24,7 @@
  * Includes
  */
 #include "globals.hxx"
+#include "objects/tmx/tmx_chunk_map.hxx"
 #include "objects/tmx/tmx_object.hxx"
 
 /**
@@ -71,6 +72,31 @@ class TmxEngine {
    */
   void cache(TMXTiledMap* map, Modes mode);
 
+  /**
+   * Caches an empty TMX object for the chunked `map`. The object is filled in as the map streams chunks, and
+   * is owned by the map rather than this cache.
+   *
+   * @param map  ~ Chunked TMX map.
+   * @param mode ~ Mode needed to load the correct info file for the tmx object.
+   */
+  void cache(TmxChunkMap* map, Modes mode);
+
+  /**
+   * Removes the TmxObject cached with `key`, as long as it is still `object`.
+   *
+   * @param key    ~ The key of the TmxObject to remove.
+   * @param object ~ The TmxObject expected to be cached with `key`.
+   */
+  void uncache(const string& key, const TmxObject* object);
+
+  /**
+   * Loads the info for `mode` on a worker thread so it is ready by the time a map is cached. Used when
+   * resuming from a snapshot, while the scene is still loading its texture.
+   *
+   * @param mode ~ Mode that the next map will be cached with.
+   */
+  void warm(Modes mode);
+
   /**
    * Gets the TmxObject that has been cached by with the key
    *
@@ -81,6 +107,15 @@ class TmxEngine {
   TmxObject* getTmxObject(const string& key);
 
  private:
+  /**
+   * Gets the info used to construct TmxObjects for a mode, loading it into the cache if needed.
+   *
+   * @param mode ~ Mode to get the info for.
+   *
+   * @note ~ Returned by value since warm() may evict entries from another thread.
+   */
+  ValueVector getConfig(Modes mode);
+
   // Map hold tmx objects that have already been processed.
   unordered_map<string, TmxObject*> tmx_object_cache_;
 
@@ -88,6 +123,9 @@ class TmxEngine {
   // same modes for quite some time.
   unordered_map<Modes, ValueVector> tmx_config_cache_;
 
+  // Mutex guarding `tmx_config_cache_` since TmxEngine::warm() fills it from a worker thread.
+  mutex config_mutex_;
+
   // Singleton instance of this class.
   static atomic<TmxEngine*> instance_;
 
@@ -3,19 +3,20 @@
 // Includes
 #include "base_entity.hxx"
 #include "engines/tmx/tmx_engine.hxx"
+#include "utils/particle/particle_utils.hxx"
 
-BaseEntity::BaseEntity(BaseGameScene* scene, ValueMap params, const string& tmx_layer)
+BaseEntity::BaseEntity(BaseGameScene* scene, const ValueMap& params, const string& tmx_layer)
     : direction_(NONE),
       game_scene_(*scene),
-      stats_(std::move(params)),
+      stats_(params),
       current_point_(Point(-1, -1)),
       movement_(decimal<3>(0)),
       speed_changer_(decimal<3>(0)),
       can_move_(true),
       tiles_(*TmxEngine::getInstance()->getTmxObject(game_scene_.map_->getName())) {
   // Initialize the entity and set parameters
-  auto data = ArchiveUtils::loadValueMap(stats_.at(__ENTITY_FILE__).asString());
-  initWithDictionary(data);
+  // Llurkers of the same type share a file, so the parsed dictionary is cached.
+  initWithDictionary(ParticleUtils::loadDictionary(stats_.at(__ENTITY_FILE__).asString()));
   setPositionType(PositionType::RELATIVE);
   ParticleSystemQuad::setName(stats_.at(__ENTITY_ID__).asString());
   ParticleSystemQuad::setCascadeOpacityEnabled(true);
@@ -47,3 +48,22 @@ void BaseEntity::setCurrentTmxLayer(const string& layer) {
 }
 
 string BaseEntity::getCurrentTmxLayer() const { return current_tmx_layer_; }
+
+EntitySnapshot BaseEntity::getSnapshot() const {
+  EntitySnapshot snapshot;
+  snapshot.point = current_point_;
+  snapshot.position = getPosition();
+  snapshot.direction = direction_;
+  snapshot.movement = movement_.getUnbiased();
+  snapshot.tmx_layer = current_tmx_layer_;
+  return snapshot;
+}
+
+void BaseEntity::restoreSnapshot(const EntitySnapshot& snapshot) {
+  // The layer goes first since it rebuilds the collision list the entity paths against.
+  setCurrentTmxLayer(snapshot.tmx_layer);
+  current_point_ = snapshot.point;
+  direction_ = Directions(snapshot.direction);
+  movement_.setUnbiased(snapshot.movement);
+  setPosition(snapshot.position);
+}
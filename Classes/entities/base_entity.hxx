@@ -18,9 +18,11 @@
  * Includes
  */
 #include "globals.hxx"
+#include "objects/compact/compact_value.hxx"
 #include "objects/decimal/decimal_object.hxx"
 #include "scenes/game/base_game_scene.hxx"
 #include "utils/path/path_utils.hxx"
+#include "utils/snapshot/snapshot_utils.hxx"
 
 /**
  * Namespaces
@@ -39,7 +41,7 @@ class BaseEntity : public ParticleSystemQuad {
    * @param params    ~ The params of the entity
    * @param tmx_layer ~ The layer to set as a current layer for walls and traversal
    */
-  explicit BaseEntity(BaseGameScene* scene, ValueMap params, const string& tmx_layer);
+  explicit BaseEntity(BaseGameScene* scene, const ValueMap& params, const string& tmx_layer);
 
   /**
    * Virtual Destructor.
@@ -58,8 +60,8 @@ class BaseEntity : public ParticleSystemQuad {
   BaseGameScene& game_scene_;
 
   // The stats of the entity. This can vary between different types but are ultimate keep for the life of the
-  // entity
-  ValueMap stats_;
+  // entity. Kept compact since some stats are read every frame.
+  CompactDocument stats_;
 
   // Current point of the entity
   Point current_point_;
@@ -117,6 +119,20 @@ class BaseEntity : public ParticleSystemQuad {
    */
   string getCurrentTmxLayer() const;
 
+  /**
+   * Captures the tile, position and movement of the entity.
+   *
+   * @returns ~ Snapshot of the entity.
+   */
+  virtual EntitySnapshot getSnapshot() const;
+
+  /**
+   * Puts the entity back in the state captured by BaseEntity::getSnapshot().
+   *
+   * @param snapshot ~ Snapshot of the entity.
+   */
+  void restoreSnapshot(const EntitySnapshot& snapshot);
+
  private:
   // __DISALLOW_COPY_AND_ASSIGN__
   __DISALLOW_COPY_AND_ASSIGN__(BaseEntity)
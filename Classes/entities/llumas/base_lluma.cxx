@@ -6,7 +6,7 @@
 #include "ivory/ivory_lluma.hxx"
 
 BaseLluma::BaseLluma(BaseGameScene& scene, SwipeGesture& gesture, ValueMap params, const string& tmx_layer)
-    : BaseEntity(&scene, move(params), tmx_layer),
+    : BaseEntity(&scene, params, tmx_layer),
       precision_(__FRAME_SKIPPING__),
       override_swipe_(false),
       gesture_(gesture) {
@@ -32,6 +32,8 @@ BaseLluma* BaseLluma::createLluma(BaseGameScene* scene, SwipeGesture* gesture, c
 }
 
 void BaseLluma::updateEntity() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "BaseLluma::updateEntity");
+
   // This is used to stop the lluma from moving at anytime and at any position. much more granular
   // than waiting for movement_ to reach zero.
   if (not can_move_) return;
@@ -7,10 +7,11 @@
 #include "utils/path/path_utils.hxx"
 
 BaseLlurker::BaseLlurker(BaseGameScene& scene, ValueMap params, const string& tmx_layer)
-    : BaseEntity(&scene, move(params), tmx_layer),
+    : BaseEntity(&scene, params, tmx_layer),
       chase_(false),
       generate_index_(stats_.at(__BASE_LLURKER_GENERATOR_INDEX__).asInt()),
-      gen_(random_device{}()) {
+      random_(scene.random_),
+      type_(XIMOIS) {
   // Set up the llurkers physics body
   auto physics = PhysicsBody::createCircle(ParticleSystem::getTexture()->getContentSize().width / 5,
                                            PhysicsMaterial(1, 1, 1));
@@ -28,13 +29,23 @@ BaseLlurker::~BaseLlurker() = default;
 
 BaseLlurker* BaseLlurker::createLlurker(BaseGameScene* scene, const Llurkers llurker,
                                         const string& tmx_layer) {
-  if (llurker == XIMOIS) return new Ximois(scene, tmx_layer);
-  // if (llurker == CERBERUS) return new Cerberus(layer);
-  // if (llurker == ADDROSS) return new Addross(layer);
-  return nullptr;
+  BaseLlurker* ret = nullptr;
+  if (llurker == XIMOIS) ret = new Ximois(scene, tmx_layer);
+  // if (llurker == CERBERUS) ret = new Cerberus(layer);
+  // if (llurker == ADDROSS) ret = new Addross(layer);
+  if (ret not_eq nullptr) ret->type_ = llurker;
+  return ret;
+}
+
+EntitySnapshot BaseLlurker::getSnapshot() const {
+  auto snapshot = BaseEntity::getSnapshot();
+  snapshot.type = type_;
+  return snapshot;
 }
 
 void BaseLlurker::updateEntity() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "BaseLlurker::updateEntity");
+
   // This is used to stop the llurker from moving at anytime and at any position. much more granular than
   // waiting for movement_ to reach zero
   if (not can_move_ or not game_scene_.player_->getCanMove() or current_point_ == Point(-1, -1)) return;
@@ -50,7 +61,8 @@ void BaseLlurker::updateEntity() {
     // If the llurker is close enough to the place, the will start to "chase the player by constantly the
     // distance to the player
     const auto distance = Heuristic::manhattan(current_point_, game_scene_.player_->getCurrentPoint());
-    const auto chase_index = stats_.at(__BASE_LLURKER_CHASE_DISTANCE__).asInt();
+    static const CompactAtom chase_distance(__BASE_LLURKER_CHASE_DISTANCE__);
+    const auto chase_index = stats_.at(chase_distance).asInt();
 
     if (distance <= chase_index and not chase_) {
       __CCLOGWITHFUNCTION("Initializing Chase...");
@@ -119,6 +131,8 @@ void BaseLlurker::updatePosition() {
 }
 
 void BaseLlurker::updatePathQueue() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "BaseLlurker::updatePathQueue");
+
   // Clear path_queue.
   path_queue_.clear();
 
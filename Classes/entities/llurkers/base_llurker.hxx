@@ -50,6 +50,11 @@ class BaseLlurker : public BaseEntity {
   static BaseLlurker* createLlurker(BaseGameScene* scene, Llurkers llurker,
                                     const string& tmx_layer = string("ui"));
 
+  /**
+   * @see BaseEntity::getSnapshot()
+   */
+  EntitySnapshot getSnapshot() const override;
+
   /**
    * @see BaseEntity::updateEntity()
    */
@@ -96,8 +101,11 @@ class BaseLlurker : public BaseEntity {
   // in search for the player
   deque<Point> path_queue_;
 
-  // Mersenne Twister pseudo-random number generator with random seed
-  mt19937 gen_;
+  // Generator of the game scene. Shared by every llurker so the whole run follows a single seed.
+  RandomObject& random_;
+
+  // The type of llurker this was created as.
+  Llurkers type_;
 
  private:
   // __DISALLOW_COPY_AND_ASSIGN__(typeName)
@@ -34,11 +34,13 @@ void Ximois::onCalculate(const Point from, const Point to) {
   if (not chase_) {
     // Generate a random number between 1 - 100. If the llurkers generate index is higher than the random
     // number, the llurker will go straight to the last known place of the player.
-    uniform_int_distribution<> d(1, 100);
-    if (d(gen_) < generate_index_)
+    if (random_.nextInt(1, 100) < generate_index_) {
       CCLOG("Navigating directly to player Index: %i", int(generate_index_));
-    else
-      target = tiles_.getRandomPoint("spawn")->first;
+    } else {
+      // Chunked maps may not have any spawn tiles loaded, in which case the player is the only target.
+      const auto point = tiles_.getRandomPoint("spawn", random_);
+      if (point not_eq Point(-1, -1)) target = point;
+    }
 
     // Increase generated index
     generate_index_ += 4;
@@ -0,0 +1,279 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "compact_value.hxx"
+
+/**
+ * Every interned name. Names are kept in the nodes of `ids`, which never move, and `names` points at them by
+ * atom.
+ */
+struct AtomTable {
+  mutex lock;
+  unordered_map<string, uint32_t> ids;
+  vector<const string*> names;
+};
+
+/**
+ * Gets the atom table. Constructed on first use, since atoms are also interned by static locals.
+ */
+static AtomTable& getAtomTable() {
+  static AtomTable table;
+  return table;
+}
+
+static_assert(sizeof(CompactValue) == 16, "CompactValue should fit in 16 bytes");
+
+/**
+ * Rounds `size` up to the alignment of the arena.
+ */
+static size_t alignSize(const size_t size) { return (size + 7) & ~size_t(7); }
+
+CompactAtom::CompactAtom(const string& name) {
+  auto& table = getAtomTable();
+  lock_guard<mutex> lock(table.lock);
+
+  const auto result = table.ids.emplace(name, uint32_t(table.names.size()));
+  if (result.second) table.names.push_back(&result.first->first);
+  id_ = result.first->second;
+}
+
+CompactAtom::CompactAtom(const char* name) : CompactAtom(string(name)) {}
+
+const string& CompactAtom::getName() const {
+  auto& table = getAtomTable();
+  lock_guard<mutex> lock(table.lock);
+  return *table.names[id_];
+}
+
+CompactValue::CompactValue() : type_(uint8_t(Value::Type::NONE)), size_(0), integer_(0) {}
+
+bool CompactValue::asBool() const {
+  switch (getType()) {
+    case Value::Type::BOOLEAN:
+      return boolean_;
+    case Value::Type::BYTE:
+    case Value::Type::INTEGER:
+    case Value::Type::UNSIGNED:
+      return integer_ not_eq 0;
+    case Value::Type::FLOAT:
+    case Value::Type::DOUBLE:
+      return double_ not_eq 0;
+    case Value::Type::STRING:
+      return strcmp(getCString(), "0") not_eq 0 and strcmp(getCString(), "false") not_eq 0;
+    default:
+      CCASSERT(false, "CompactValue: only base types can be converted to bool...");
+      return false;
+  }
+}
+
+int CompactValue::asInt() const {
+  switch (getType()) {
+    case Value::Type::BYTE:
+    case Value::Type::INTEGER:
+    case Value::Type::UNSIGNED:
+      return int(integer_);
+    case Value::Type::FLOAT:
+    case Value::Type::DOUBLE:
+      return int(double_);
+    case Value::Type::BOOLEAN:
+      return boolean_ ? 1 : 0;
+    case Value::Type::STRING:
+      return atoi(getCString());
+    default:
+      CCASSERT(false, "CompactValue: only base types can be converted to int...");
+      return 0;
+  }
+}
+
+float CompactValue::asFloat() const { return float(asDouble()); }
+
+double CompactValue::asDouble() const {
+  switch (getType()) {
+    case Value::Type::FLOAT:
+    case Value::Type::DOUBLE:
+      return double_;
+    case Value::Type::BYTE:
+    case Value::Type::INTEGER:
+    case Value::Type::UNSIGNED:
+      return double(integer_);
+    case Value::Type::BOOLEAN:
+      return boolean_ ? 1.0 : 0.0;
+    case Value::Type::STRING:
+      return utils::atof(getCString());
+    default:
+      CCASSERT(false, "CompactValue: only base types can be converted to double...");
+      return 0.0;
+  }
+}
+
+string CompactValue::asString() const {
+  if (getType() == Value::Type::STRING) return string(getCString(), size_);
+
+  // Numbers are rare as strings, so let Value keep the formatting in one place.
+  return toValue().asString();
+}
+
+const char* CompactValue::getCString() const {
+  CCASSERT(getType() == Value::Type::STRING, "CompactValue: value is not a string...");
+  return size_ < sizeof(inline_) ? inline_ : string_;
+}
+
+const CompactValue& CompactValue::operator[](const size_t index) const {
+  CCASSERT(getType() == Value::Type::VECTOR and index < size_, "CompactValue: index out of range...");
+  return vector_[index];
+}
+
+const CompactValue* CompactValue::find(const CompactAtom& key) const {
+  CCASSERT(getType() == Value::Type::MAP, "CompactValue: value is not a map...");
+  const auto entry = lower_bound(begin(), end(), key, [](const CompactEntry& entry, const CompactAtom& atom) {
+    return entry.key < atom;
+  });
+  return entry not_eq end() and entry->key == key ? &entry->value : nullptr;
+}
+
+const CompactValue& CompactValue::at(const CompactAtom& key) const {
+  const auto value = find(key);
+  CCASSERT(value not_eq nullptr, "CompactValue: key not found...");
+  return *value;
+}
+
+const CompactEntry* CompactValue::begin() const { return getType() == Value::Type::MAP ? map_ : nullptr; }
+
+const CompactEntry* CompactValue::end() const {
+  return getType() == Value::Type::MAP ? map_ + size_ : nullptr;
+}
+
+Value CompactValue::toValue() const {
+  switch (getType()) {
+    case Value::Type::BYTE:
+      return Value(static_cast<unsigned char>(integer_));
+    case Value::Type::INTEGER:
+      return Value(int(integer_));
+    case Value::Type::UNSIGNED:
+      return Value(static_cast<unsigned int>(integer_));
+    case Value::Type::FLOAT:
+      return Value(float(double_));
+    case Value::Type::DOUBLE:
+      return Value(double_);
+    case Value::Type::BOOLEAN:
+      return Value(boolean_);
+    case Value::Type::STRING:
+      return Value(string(getCString(), size_));
+    case Value::Type::VECTOR: {
+      ValueVector vector;
+      vector.reserve(size_);
+      for (auto i = 0u; i < size_; i++) vector.push_back(vector_[i].toValue());
+      return Value(std::move(vector));
+    }
+    case Value::Type::MAP: {
+      ValueMap map;
+      map.reserve(size_);
+      for (const auto& entry : *this) map.emplace(entry.key.getName(), entry.value.toValue());
+      return Value(std::move(map));
+    }
+    default:
+      return Value();
+  }
+}
+
+CompactDocument::CompactDocument() : used_(0) { root_.type_ = uint8_t(Value::Type::MAP); }
+
+CompactDocument::CompactDocument(const ValueMap& map) : arena_(new char[measure(map)]), used_(0) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "CompactDocument::CompactDocument");
+  build(root_, map);
+}
+
+ValueMap CompactDocument::toValueMap() const { return root_.toValue().asValueMap(); }
+
+size_t CompactDocument::measure(const Value& value) {
+  switch (value.getType()) {
+    case Value::Type::STRING: {
+      const auto length = value.asString().size();
+      return length < sizeof(CompactValue::inline_) ? 0 : alignSize(length + 1);
+    }
+    case Value::Type::VECTOR: {
+      auto size = alignSize(value.asValueVector().size() * sizeof(CompactValue));
+      for (const auto& element : value.asValueVector()) size += measure(element);
+      return size;
+    }
+    case Value::Type::MAP:
+      return measure(value.asValueMap());
+    default:
+      return 0;
+  }
+}
+
+size_t CompactDocument::measure(const ValueMap& map) {
+  auto size = alignSize(map.size() * sizeof(CompactEntry));
+  for (const auto& entry : map) size += measure(entry.second);
+  return size;
+}
+
+void* CompactDocument::allocate(const size_t size) {
+  const auto memory = arena_.get() + used_;
+  used_ += alignSize(size);
+  return memory;
+}
+
+void CompactDocument::build(CompactValue& out, const Value& value) {
+  out.type_ = uint8_t(value.getType());
+  switch (value.getType()) {
+    case Value::Type::BYTE:
+    case Value::Type::INTEGER:
+      out.integer_ = value.asInt();
+      break;
+    case Value::Type::UNSIGNED:
+      out.integer_ = value.asUnsignedInt();
+      break;
+    case Value::Type::FLOAT:
+    case Value::Type::DOUBLE:
+      out.double_ = value.asDouble();
+      break;
+    case Value::Type::BOOLEAN:
+      out.boolean_ = value.asBool();
+      break;
+    case Value::Type::STRING: {
+      const auto text = value.asString();
+      out.size_ = uint32_t(text.size());
+      if (text.size() < sizeof(out.inline_)) {
+        memcpy(out.inline_, text.c_str(), text.size() + 1);
+      } else {
+        const auto memory = static_cast<char*>(allocate(text.size() + 1));
+        memcpy(memory, text.c_str(), text.size() + 1);
+        out.string_ = memory;
+      }
+      break;
+    }
+    case Value::Type::VECTOR: {
+      const auto& vector = value.asValueVector();
+      const auto elements = static_cast<CompactValue*>(allocate(vector.size() * sizeof(CompactValue)));
+      for (auto i = 0u; i < vector.size(); i++) build(*new (elements + i) CompactValue(), vector[i]);
+      out.size_ = uint32_t(vector.size());
+      out.vector_ = elements;
+      break;
+    }
+    case Value::Type::MAP:
+      build(out, value.asValueMap());
+      break;
+    default:
+      out.type_ = uint8_t(Value::Type::NONE);
+      break;
+  }
+}
+
+void CompactDocument::build(CompactValue& out, const ValueMap& map) {
+  const auto entries = static_cast<CompactEntry*>(allocate(map.size() * sizeof(CompactEntry)));
+  auto entry = entries;
+  for (const auto& pair : map) {
+    new (entry) CompactEntry{CompactAtom(pair.first), CompactValue()};
+    build(entry->value, pair.second);
+    ++entry;
+  }
+
+  // Sorted by atom so lookups can binary search.
+  sort(entries, entry, [](const CompactEntry& a, const CompactEntry& b) { return a.key < b.key; });
+
+  out.type_ = uint8_t(Value::Type::MAP);
+  out.size_ = uint32_t(map.size());
+  out.map_ = entries;
+}
@@ -0,0 +1,229 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __COMPACT_VALUE_HXX__
+#define __COMPACT_VALUE_HXX__
+
+/**
+ * Includes
+ */
+#include "globals.hxx"
+
+/**
+ * Interned ValueMap key. Interning hashes the name once, after that atoms compare and sort as integers.
+ * Converting from a string is implicit so existing keys keep working, but code that looks a key up every
+ * frame should intern it once (e.g. in a static local) and keep the atom.
+ */
+class CompactAtom {
+ public:
+  /**
+   * Constructor. Interns `name`, which is thread safe.
+   *
+   * @param name ~ Name of the key.
+   */
+  CompactAtom(const string& name);
+
+  CompactAtom(const char* name);
+
+  /**
+   * Gets the name the atom was interned from.
+   */
+  const string& getName() const;
+
+  /**
+   * Getter for {@link CompactAtom#id_}
+   */
+  uint32_t getId() const { return id_; }
+
+  bool operator==(const CompactAtom& other) const { return id_ == other.id_; }
+
+  bool operator!=(const CompactAtom& other) const { return id_ not_eq other.id_; }
+
+  bool operator<(const CompactAtom& other) const { return id_ < other.id_; }
+
+ private:
+  // Index of the name in the atom table. Atoms are never released.
+  uint32_t id_;
+};
+
+struct CompactEntry;
+
+/**
+ * Read only, 16 byte counterpart of cocos2d::Value that lives in a CompactDocument. Strings of up to 7
+ * characters are stored inline, longer strings, vectors and maps point into the document's arena. Maps are
+ * sorted by atom, so a lookup is a binary search over integers instead of hashing a string.
+ */
+class CompactValue {
+ public:
+  /**
+   * Constructor. Creates a Value::Type::NONE value.
+   */
+  CompactValue();
+
+  /**
+   * Gets the type of the Value this was built from. Value::Type::INT_KEY_MAP is not supported and is stored
+   * as Value::Type::NONE.
+   */
+  Value::Type getType() const { return Value::Type(type_); }
+
+  bool isNull() const { return getType() == Value::Type::NONE; }
+
+  /**
+   * Converts the value the same way the matching cocos2d::Value getter does.
+   */
+  bool asBool() const;
+
+  int asInt() const;
+
+  float asFloat() const;
+
+  double asDouble() const;
+
+  string asString() const;
+
+  /**
+   * Gets a string value without copying it. Only valid for Value::Type::STRING.
+   */
+  const char* getCString() const;
+
+  /**
+   * Gets the number of elements of a vector or map, or the length of a string.
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * Gets an element of a vector.
+   *
+   * @param index ~ Index of the element.
+   */
+  const CompactValue& operator[](size_t index) const;
+
+  /**
+   * Looks a key up in a map.
+   *
+   * @param key ~ Key to look for.
+   *
+   * @returns ~ The value of the key or nullptr if the map doesn't contain it.
+   */
+  const CompactValue* find(const CompactAtom& key) const;
+
+  /**
+   * Looks a key up in a map. Like ValueMap::at, the key must be in the map.
+   *
+   * @param key ~ Key to look for.
+   */
+  const CompactValue& at(const CompactAtom& key) const;
+
+  /**
+   * Iterates over the entries of a map, sorted by atom.
+   */
+  const CompactEntry* begin() const;
+
+  const CompactEntry* end() const;
+
+  /**
+   * Converts the value back to a cocos2d::Value, including every child of a vector or map.
+   */
+  Value toValue() const;
+
+ private:
+  friend class CompactDocument;
+
+  // Value::Type of the value.
+  uint8_t type_;
+
+  // Length of a string, or number of elements of a vector or map.
+  uint32_t size_;
+
+  union {
+    bool boolean_;
+    int64_t integer_;
+    double double_;
+    char inline_[8];
+    const char* string_;
+    const CompactValue* vector_;
+    const CompactEntry* map_;
+  };
+};
+
+/**
+ * Key and value pair of a map in a CompactDocument.
+ */
+struct CompactEntry {
+  CompactAtom key;
+  CompactValue value;
+};
+
+/**
+ * Compact copy of a ValueMap. Everything the document needs is measured first and then built in a single
+ * arena allocation, which is released with the document.
+ */
+class CompactDocument {
+ public:
+  /**
+   * Constructor. Creates an empty document.
+   */
+  CompactDocument();
+
+  /**
+   * Constructor.
+   *
+   * @param map ~ Map to copy into the document.
+   */
+  explicit CompactDocument(const ValueMap& map);
+
+  /**
+   * Gets the root map of the document.
+   */
+  const CompactValue& getRoot() const { return root_; }
+
+  /**
+   * Shortcuts for looking up keys of the root map.
+   */
+  const CompactValue* find(const CompactAtom& key) const { return root_.find(key); }
+
+  const CompactValue& at(const CompactAtom& key) const { return root_.at(key); }
+
+  /**
+   * Converts the document back to a ValueMap.
+   */
+  ValueMap toValueMap() const;
+
+ private:
+  /**
+   * Gets the arena bytes needed by a value and its children.
+   */
+  static size_t measure(const Value& value);
+
+  static size_t measure(const ValueMap& map);
+
+  /**
+   * Reserves `size` bytes of the arena, rounded up to keep the next allocation aligned.
+   */
+  void* allocate(size_t size);
+
+  /**
+   * Copies a value and its children into the arena.
+   *
+   * @param out   ~ Value to build.
+   * @param value ~ Value to copy.
+   */
+  void build(CompactValue& out, const Value& value);
+
+  void build(CompactValue& out, const ValueMap& map);
+
+  // Storage of every string, vector and map of the document.
+  unique_ptr<char[]> arena_;
+
+  // Bytes of `arena_` handed out so far.
+  size_t used_;
+
+  // Root map.
+  CompactValue root_;
+
+  /**
+   * __DISALLOW_COPY_AND_ASSIGN__
+   */
+  __DISALLOW_COPY_AND_ASSIGN__(CompactDocument)
+};
+
+#endif  // __COMPACT_VALUE_HXX__
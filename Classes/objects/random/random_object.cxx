@@ -0,0 +1,63 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "random_object.hxx"
+#include <random>
+
+/**
+ * Rotates `x` left by `k` bits.
+ */
+static uint64_t rotl(const uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+
+RandomObject::RandomObject(const uint32_t seed) : seed_(seed) {
+  // The state is expanded from the seed with splitmix64, which can't produce an all zero state.
+  auto x = uint64_t(seed);
+  for (auto& state : state_) {
+    auto z = (x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    state = z ^ (z >> 31);
+  }
+}
+
+uint32_t RandomObject::generateSeed() { return random_device{}(); }
+
+RandomObject::result_type RandomObject::operator()() {
+  const auto result = rotl(state_[1] * 5, 7) * 9;
+  const auto t = state_[1] << 17;
+
+  state_[2] ^= state_[0];
+  state_[3] ^= state_[1];
+  state_[1] ^= state_[2];
+  state_[0] ^= state_[3];
+  state_[2] ^= t;
+  state_[3] = rotl(state_[3], 45);
+
+  return result;
+}
+
+int RandomObject::nextInt(const int min, const int max) {
+  CCASSERT(min <= max, "RandomObject: min must not be greater than max...");
+  const auto range = uint64_t(int64_t(max) - int64_t(min)) + 1;
+
+  // Values past the last whole multiple of `range` are rejected so every value is equally likely.
+  const auto limit = UINT64_MAX - UINT64_MAX % range;
+  auto value = (*this)();
+  while (value >= limit) value = (*this)();
+
+  return int(int64_t(min) + int64_t(value % range));
+}
+
+double RandomObject::nextDouble() {
+  // The top 53 bits fill the mantissa of the double exactly.
+  return double((*this)() >> 11) / 9007199254740992.0;
+}
+
+uint32_t RandomObject::getSeed() const { return seed_; }
+
+array<uint64_t, 4> RandomObject::getState() const { return {{state_[0], state_[1], state_[2], state_[3]}}; }
+
+void RandomObject::setState(const array<uint64_t, 4>& state) {
+  CCASSERT(state[0] or state[1] or state[2] or state[3], "RandomObject: State must not be all zero...");
+  copy(state.begin(), state.end(), state_);
+}
@@ -0,0 +1,81 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __RANDOM_OBJECT_HXX__
+#define __RANDOM_OBJECT_HXX__
+
+/**
+ * Includes
+ */
+#include <array>
+#include "globals.hxx"
+
+/**
+ * Seeded xoshiro256** pseudo-random number generator. Every BaseGameScene owns one, so everything random in
+ * a run can be reproduced from the seed alone. Unlike the standard distributions, the values returned by
+ * RandomObject::nextInt() and RandomObject::nextDouble() are the same on every platform.
+ */
+class RandomObject {
+ public:
+  using result_type = uint64_t;
+
+  /**
+   * Constructor.
+   *
+   * @param seed ~ Seed of the sequence. The same seed always produces the same sequence.
+   */
+  explicit RandomObject(uint32_t seed);
+
+  /**
+   * Generates a random seed from the OS entropy source. This is slow, so it should only be used once per run.
+   */
+  static uint32_t generateSeed();
+
+  /**
+   * Gets the next 64 bits of the sequence. Also makes RandomObject usable as a standard random engine.
+   */
+  result_type operator()();
+
+  /**
+   * Gets a uniformly distributed integer.
+   *
+   * @param min ~ Smallest value that can be returned.
+   * @param max ~ Largest value that can be returned.
+   */
+  int nextInt(int min, int max);
+
+  /**
+   * Gets a uniformly distributed double in [0, 1).
+   */
+  double nextDouble();
+
+  /**
+   * Getter for {@link RandomObject#seed_}
+   */
+  uint32_t getSeed() const;
+
+  /**
+   * Gets the current state of the sequence, so it can be saved and continued later with
+   * RandomObject::setState().
+   */
+  array<uint64_t, 4> getState() const;
+
+  /**
+   * Continues the sequence from a state returned by RandomObject::getState().
+   *
+   * @param state ~ xoshiro256** state. Must not be all zero.
+   */
+  void setState(const array<uint64_t, 4>& state);
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() { return UINT64_MAX; }
+
+ private:
+  // Seed the state was generated from.
+  uint32_t seed_;
+
+  // xoshiro256** state.
+  uint64_t state_[4];
+};
+
+#endif  // __RANDOM_OBJECT_HXX__
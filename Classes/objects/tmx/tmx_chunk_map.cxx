@@ -0,0 +1,187 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "tmx_chunk_map.hxx"
+#include "engines/tmx/tmx_engine.hxx"
+#include "utils/archive/archive_utils.hxx"
+
+/**
+ * A single chunk of a chunked map. TMXTiledMap only exposes building from a parsed TMXMapInfo to subclasses,
+ * so this lets chunks skip parsing the XML a second time on the main thread.
+ */
+class TmxChunkNode : public TMXTiledMap {
+ public:
+  static TmxChunkNode* create(TMXMapInfo* info) {
+    const auto ret = new (nothrow) TmxChunkNode();
+    ret->buildWithMapInfo(info);
+    ret->autorelease();
+    return ret;
+  }
+};
+
+TmxChunkMap::TmxChunkMap() = default;
+
+TmxChunkMap::~TmxChunkMap() {
+  // The TmxObject belongs to this map, so make sure nothing can find it in the cache anymore.
+  TmxEngine::getInstance()->uncache(getName(), tmx_object_);
+  CC_SAFE_DELETE(tmx_object_);
+}
+
+TmxChunkMap* TmxChunkMap::create(const string& directory) {
+  auto ret = new (nothrow) TmxChunkMap();
+  if (ret and ret->initWithDirectory(directory)) {
+    ret->autorelease();
+    return ret;
+  }
+  CC_SAFE_DELETE(ret);
+  return nullptr;
+}
+
+bool TmxChunkMap::initWithDirectory(const string& directory) {
+  const auto manifest = ArchiveUtils::loadValueMap(directory + __TMX_CHUNK_MANIFEST__);
+  Globals::assertValueMap(manifest, {__TMX_CHUNK_WIDTH__, __TMX_CHUNK_HEIGHT__, __TMX_CHUNK_SIZE__});
+
+  directory_ = directory;
+  chunk_size_ = manifest.at(__TMX_CHUNK_SIZE__).asInt();
+  if (chunk_size_ <= 0) {
+    __CCLOGWITHFUNCTION("Invalid chunk size in: %s", directory.c_str());
+    return false;
+  }
+
+  // Size the map to cover the whole maze even though only a few chunks will ever be resident.
+  const auto tile = manifest.find(__TMX_CHUNK_TILE_SIZE__) not_eq manifest.end()
+                        ? manifest.at(__TMX_CHUNK_TILE_SIZE__).asFloat()
+                        : 108.0f;
+  _mapSize = Size(manifest.at(__TMX_CHUNK_WIDTH__).asFloat(), manifest.at(__TMX_CHUNK_HEIGHT__).asFloat());
+  _tileSize = Size(tile, tile);
+  _tmxFile = directory;
+  setContentSize(CC_SIZE_PIXELS_TO_POINTS(Size(_mapSize.width * tile, _mapSize.height * tile)));
+
+  chunks_wide_ = int(ceil(_mapSize.width / chunk_size_));
+  chunks_high_ = int(ceil(_mapSize.height / chunk_size_));
+
+  // Default the spawn to the center of the map
+  const auto spawn_x = manifest.find(__TMX_CHUNK_SPAWN_X__);
+  const auto spawn_y = manifest.find(__TMX_CHUNK_SPAWN_Y__);
+  spawn_ = Point(spawn_x not_eq manifest.end() ? spawn_x->second.asFloat() : floor(_mapSize.width / 2),
+                 spawn_y not_eq manifest.end() ? spawn_y->second.asFloat() : floor(_mapSize.height / 2));
+  return true;
+}
+
+void TmxChunkMap::setTmxObject(TmxObject* tmx_object) {
+  CCASSERT(tmx_object not_eq nullptr and tmx_object->isChunked(),
+           "TmxChunkMap: TmxObject must be created for a chunked map...");
+  tmx_object_ = tmx_object;
+}
+
+int TmxChunkMap::getChunkSize() const { return chunk_size_; }
+
+Point TmxChunkMap::getSpawnPoint() const { return spawn_; }
+
+void TmxChunkMap::focus(const Point& point, const bool async) {
+  CCASSERT(tmx_object_ not_eq nullptr, "TmxChunkMap: TmxObject must be set before focusing the map...");
+  if (point.x < 0 or point.y < 0 or point.x >= _mapSize.width or point.y >= _mapSize.height) return;
+
+  // Nothing changes until the point crosses into another chunk
+  const auto center = Point(floor(point.x / chunk_size_), floor(point.y / chunk_size_));
+  if (center == focus_) return;
+  focus_ = center;
+
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxChunkMap::focus");
+
+  // Evict chunks that have drifted out of range. Collect first since eviction modifies `chunks_`.
+  vector<int> evictions;
+  for (const auto& chunk : chunks_)
+    if (not isWanted(chunk.first)) evictions.emplace_back(chunk.first);
+  for_each(evictions.begin(), evictions.end(), [&](const int index) { evict(index); });
+
+  // Request every chunk in range that isn't already resident or on its way.
+  const auto min_x = max(int(center.x) - __TMX_CHUNK_LOAD_RADIUS__, 0);
+  const auto min_y = max(int(center.y) - __TMX_CHUNK_LOAD_RADIUS__, 0);
+  const auto max_x = min(int(center.x) + __TMX_CHUNK_LOAD_RADIUS__, chunks_wide_ - 1);
+  const auto max_y = min(int(center.y) + __TMX_CHUNK_LOAD_RADIUS__, chunks_high_ - 1);
+  for (auto y = min_y; y <= max_y; y++)
+    for (auto x = min_x; x <= max_x; x++) {
+      const auto index = y * chunks_wide_ + x;
+      if (chunks_.find(index) not_eq chunks_.end() or pending_.find(index) not_eq pending_.end()) continue;
+      load(x, y, async);
+    }
+}
+
+void TmxChunkMap::load(const int x, const int y, const bool async) {
+  const auto index = y * chunks_wide_ + x;
+  const auto origin = Point(x * chunk_size_, y * chunk_size_);
+  const auto file = StringUtils::format(__TMX_CHUNK_FILE__, directory_.c_str(), x, y);
+
+  // State handed from the worker thread to the main thread.
+  const auto info = make_shared<TMXMapInfo*>(nullptr);
+  const auto chunk = make_shared<TmxChunk>();
+
+  // Reading, parsing and generating tiles never touches the scene graph, so it is safe off the main thread.
+  const auto task = [=]() {
+    CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxChunkMap::load");
+    const auto map_info = new (nothrow) TMXMapInfo();
+    const auto parsed = map_info->initWithXML(ArchiveUtils::loadString(file), string());
+    if (parsed and not map_info->getTilesets().empty())
+      *chunk = tmx_object_->buildChunk(*map_info, index, origin);
+    *info = map_info;
+  };
+
+  if (not async) {
+    task();
+    attach(*info, *chunk);
+    return;
+  }
+
+  // Keep the map alive until the chunk comes back since the scene may be torn down in the meantime.
+  pending_.emplace(index);
+  retain();
+  AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO,
+                                        [=](void*) {
+                                          pending_.erase(index);
+                                          attach(*info, *chunk);
+                                          release();
+                                        },
+                                        nullptr, task);
+}
+
+void TmxChunkMap::attach(TMXMapInfo* info, const TmxChunk& chunk) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxChunkMap::attach");
+
+  // Drop chunks that failed to load, or that the focus moved away from while they were loading.
+  if (chunk.index < 0 or not isWanted(chunk.index) or chunks_.find(chunk.index) not_eq chunks_.end()) {
+    if (chunk.index < 0) __CCLOGWITHFUNCTION("Failed to load chunk in: %s", directory_.c_str());
+    CC_SAFE_RELEASE(info);
+    return;
+  }
+
+  // TMX rows run top to bottom, so chunks are placed from the top of the map down.
+  const auto node = TmxChunkNode::create(info);
+  const auto& area = chunk.area;
+  node->setPosition(CC_POINT_PIXELS_TO_POINTS(
+      Vec2(area.getMinX() * _tileSize.width, (_mapSize.height - area.getMaxY()) * _tileSize.height)));
+  node->setCascadeOpacityEnabled(true);
+  addChild(node, 0, chunk.index);
+  CC_SAFE_RELEASE(info);
+
+  // Tiles become visible to queries and pathfinding at the same time as the nodes.
+  chunks_.emplace(chunk.index, node);
+  tmx_object_->insertChunk(chunk);
+}
+
+void TmxChunkMap::evict(const int index) {
+  const auto itr = chunks_.find(index);
+  if (itr == chunks_.end()) return;
+
+  // Remove the tiles of the chunk before the nodes so nothing can path into it.
+  const auto origin = Point(index % chunks_wide_ * chunk_size_, index / chunks_wide_ * chunk_size_);
+  tmx_object_->eraseChunk(index, Rect(origin, itr->second->getMapSize()));
+  itr->second->removeFromParent();
+  chunks_.erase(itr);
+}
+
+bool TmxChunkMap::isWanted(const int index) const {
+  const auto x = index % chunks_wide_;
+  const auto y = index / chunks_wide_;
+  return max(abs(x - int(focus_.x)), abs(y - int(focus_.y))) <= __TMX_CHUNK_EVICT_RADIUS__;
+}
@@ -0,0 +1,160 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __TMX_CHUNK_MAP_HXX__
+#define __TMX_CHUNK_MAP_HXX__
+
+/**
+ * Chunked map layout. A chunked map is a directory in the archive holding a manifest and one TMX file per
+ * chunk named `chunk_<x>_<y>.tmx`, where x and y are the position of the chunk in the chunk grid. They are
+ * made from a regular TMX map with xTmx/chunk_tmx.py.
+ */
+#define __TMX_CHUNK_MANIFEST__ "manifest.plist"
+#define __TMX_CHUNK_FILE__ "%schunk_%d_%d.tmx"
+
+/**
+ * Manifest Keys
+ */
+#define __TMX_CHUNK_WIDTH__ "width"
+#define __TMX_CHUNK_HEIGHT__ "height"
+#define __TMX_CHUNK_SIZE__ "chunk_size"
+#define __TMX_CHUNK_TILE_SIZE__ "tile_size"
+#define __TMX_CHUNK_SPAWN_X__ "spawn_x"
+#define __TMX_CHUNK_SPAWN_Y__ "spawn_y"
+
+/**
+ * Streaming radii, in chunks. Chunks are evicted further out than they are loaded so walking back and forth
+ * over a chunk border doesn't thrash.
+ */
+#define __TMX_CHUNK_LOAD_RADIUS__ 1
+#define __TMX_CHUNK_EVICT_RADIUS__ 2
+
+/**
+ * Includes
+ */
+#include <unordered_set>
+#include "globals.hxx"
+#include "objects/tmx/tmx_object.hxx"
+
+/**
+ * TmxChunkMap
+ */
+class TmxChunkMap : public TMXTiledMap {
+ public:
+  /**
+   * Creates a chunked map from the manifest in `directory`. No chunks are loaded until
+   * TmxChunkMap::focus() is called.
+   *
+   * @param directory ~ Path to the chunked map in the archive, ending in a `/`.
+   *
+   * @returns ~ Autoreleased TmxChunkMap, or nullptr if the manifest is invalid.
+   */
+  static TmxChunkMap* create(const string& directory);
+
+  /**
+   * Sets the TmxObject that chunk tiles are merged into. The map takes ownership of the object.
+   *
+   * @param tmx_object ~ Empty TmxObject created for this map.
+   */
+  void setTmxObject(TmxObject* tmx_object);
+
+  /**
+   * Getter for {@link TmxChunkMap#chunk_size_}
+   */
+  int getChunkSize() const;
+
+  /**
+   * Gets the point the player should spawn around, as defined by the manifest.
+   */
+  Point getSpawnPoint() const;
+
+  /**
+   * Moves the focus of the map to `point`. Chunks within __TMX_CHUNK_LOAD_RADIUS__ are requested and chunks
+   * beyond __TMX_CHUNK_EVICT_RADIUS__ are evicted. Does nothing if `point` is in the chunk already in focus.
+   *
+   * @param point ~ Point in the whole map, usually the players current point.
+   * @param async ~ Load and parse chunks on a worker thread. Pass false to block until they are built.
+   */
+  void focus(const Point& point, bool async = true);
+
+ protected:
+  /**
+   * Constructor.
+   */
+  explicit TmxChunkMap();
+
+  /**
+   * Destructor.
+   */
+  virtual ~TmxChunkMap();
+
+  /**
+   * Reads the manifest and sizes the map to cover every chunk.
+   *
+   * @param directory ~ Path to the chunked map in the archive.
+   */
+  bool initWithDirectory(const string& directory);
+
+  /**
+   * Loads, parses and builds the tiles of a chunk, then attaches it on the main thread.
+   *
+   * @param x     ~ Column of the chunk in the chunk grid.
+   * @param y     ~ Row of the chunk in the chunk grid.
+   * @param async ~ Run the load on a worker thread.
+   */
+  void load(int x, int y, bool async);
+
+  /**
+   * Builds the nodes of a parsed chunk and merges its tiles into the TmxObject.
+   *
+   * @param info  ~ Parsed chunk. Released by this function.
+   * @param chunk ~ Tiles generated for the chunk.
+   */
+  void attach(TMXMapInfo* info, const TmxChunk& chunk);
+
+  /**
+   * Removes the nodes of a chunk and its tiles from the TmxObject.
+   *
+   * @param index ~ Index of the chunk in the chunk grid.
+   */
+  void evict(int index);
+
+  /**
+   * Checks if a chunk is close enough to the focus to be kept resident.
+   *
+   * @param index ~ Index of the chunk in the chunk grid.
+   */
+  bool isWanted(int index) const;
+
+  // Path to the chunked map in the archive.
+  string directory_;
+
+  // Width and height of a chunk in tiles.
+  int chunk_size_{0};
+
+  // Size of the chunk grid.
+  int chunks_wide_{0};
+  int chunks_high_{0};
+
+  // Point the player should spawn around.
+  Point spawn_;
+
+  // Chunk in the chunk grid that is currently in focus.
+  Point focus_{-1, -1};
+
+  // Nodes of the chunks that are resident, by chunk index.
+  unordered_map<int, TMXTiledMap*> chunks_;
+
+  // Chunks that are being loaded on a worker thread.
+  unordered_set<int> pending_;
+
+  // TmxObject that tiles of resident chunks are merged into.
+  TmxObject* tmx_object_{};
+
+ private:
+  /**
+   * __DISALLOW_COPY_AND_ASSIGN__
+   */
+  __DISALLOW_COPY_AND_ASSIGN__(TmxChunkMap)
+};
+
+#endif  // __TMX_CHUNK_MAP_HXX__
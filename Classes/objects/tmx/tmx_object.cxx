@@ -2,14 +2,10 @@
 
 // Includes
 #include "tmx_object.hxx"
-#include <random>
 #include "utils/archive/archive_utils.hxx"
 
-TmxObject::TmxObject(const TMXTiledMap& map, const ValueVector& info) {
-  // Get center point of calculation
-  const auto div = Globals::getScreenPosition();
-  const auto size = map.getMapSize();
-
+TmxObject::TmxObject(const TMXTiledMap& map, const ValueVector& info)
+    : size_(map.getMapSize()), center_(Globals::getScreenPosition()) {
   for_each(info.begin(), info.end(), [&](const Value& data) -> void {
     const auto& values = data.asValueMap();
 
@@ -30,50 +26,52 @@ TmxObject::TmxObject(const TMXTiledMap& map, const ValueVector& info) {
     Vec2H positions;
     vector<Point> collistions;
 
-    // By default, inverse positions are not enable. So check to see that they are
-    const auto use_positions =
-        values.find(__INVERSE__) not_eq values.end() and values.at(__INVERSE__).asBool();
-    const auto use_collistions =
-        values.find(__COLLISIONS__) not_eq values.end() and values.at(__COLLISIONS__).asBool();
-
-    // Loop through all of the iteration of the map to generate the correct tiles.
-    for (auto px = 0; px < size.width; px++)
-      for (auto py = 0; py < size.height; py++) {
-        // The point we are currently evaluating.
-        const auto point = Point(px, py);
-
-        // Assure the tile is not null
-        if (tmx_layer->getTileAt(point) == nullptr) {
-          if (use_collistions) collistions.emplace_back(point);
-          continue;
-        }
-
-        // If the value set has GIDs, Assure that the gid of the tile is part of this list
-        if (values.find(__GIDS__) not_eq values.end()) {
-          const auto& gids = values.at(__GIDS__).asValueMap();
-          const auto& gid = tmx_layer->getTileGIDAt(point);
-          if (gids.find(to_string(gid)) == gids.end()) continue;
-        }
-
-        // Calculate location on screen and construct position object
-        const auto vx = div.x - ((size.width - 1) / 2 - px) * 108;
-        const auto vy = div.y + ((size.height - 1) / 2 - py) * 108;
-        const auto position = Vec2(vx, vy);
-
-        // Insert tiles into the maps
-        points.emplace(point, position);
-        if (use_positions) positions.emplace(position, point);
-      }
+    // Generate the tiles for the whole map.
+    generateTiles(values, [&](const Point& point) { return tmx_layer->getTileGIDAt(point); },
+                  Rect(Vec2::ZERO, size_), points, positions, collistions);
+
+    // Flat list of the points for random access.
+    vector<Point> list;
+    list.reserve(points.size());
+    for (const auto& point : points) list.emplace_back(point.first);
 
     // Emplace maps. The positions is only added if necessary and defined in the values
     point_map_.emplace(name, points);
+    point_list_map_.emplace(name, move(list));
     if (not positions.empty()) positions_map_.emplace(name, positions);
     if (not collistions.empty()) collistions_map_.emplace(name, collistions);
   });
 }
 
+TmxObject::TmxObject(const Size& size, const int chunk_size, const ValueVector& info)
+    : size_(size),
+      center_(Globals::getScreenPosition()),
+      info_(info),
+      chunk_size_(chunk_size),
+      chunks_wide_(int(ceil(size.width / chunk_size))) {
+  CCASSERT(chunk_size_ > 0, "TmxObject: Chunk size must be greater than 0...");
+
+  for_each(info_.begin(), info_.end(), [&](const Value& data) -> void {
+    const auto& values = data.asValueMap();
+
+    // Run assertions on required data
+    CCASSERT(values.find(__NAME__) not_eq values.end(), "TmxObject: No name was found...");
+    CCASSERT(values.find(__LAYER__) not_eq values.end(), "TmxObject: No layer was found...");
+    const auto name = values.at(__NAME__).asString();
+
+    // Nothing is loaded yet, but every map must exist so lookups are valid before the first chunk arrives.
+    point_map_.emplace(name, PointH());
+    point_list_map_.emplace(name, vector<Point>());
+    if (values.find(__INVERSE__) not_eq values.end() and values.at(__INVERSE__).asBool())
+      positions_map_.emplace(name, Vec2H());
+    if (values.find(__COLLISIONS__) not_eq values.end() and values.at(__COLLISIONS__).asBool())
+      collistions_map_.emplace(name, vector<Point>());
+  });
+}
+
 TmxObject::~TmxObject() {
   point_map_.clear();
+  point_list_map_.clear();
   positions_map_.clear();
 }
 
@@ -113,24 +111,161 @@ Vec2H::const_iterator TmxObject::getPositionPair(const Vec2& position, const str
                  [position](const pair<Vec2, Point> pair) { return position == pair.first; });
 }
 
-// ReSharper disable once CppLocalVariableMayBeConst
-PointH::const_iterator TmxObject::getRandomPoint(const string& layer) {
-  const auto& info = point_map_.at(layer);
-  auto engine = mt19937(random_device{}());
-  auto distrobution = uniform_int_distribution<>(0, int(info.size()) - 1);
-  auto it = info.begin();
+Point TmxObject::getRandomPoint(const string& layer, RandomObject& random) {
+  const auto& list = point_list_map_.at(layer);
+  if (list.empty()) return Point(-1, -1);
+  return list[random.nextInt(0, int(list.size()) - 1)];
+}
 
-  std::advance(it, distrobution(engine));
-  return it;
+Vec2 TmxObject::getRandomPosition(const string& layer, RandomObject& random) {
+  const auto& list = point_list_map_.at(layer);
+  if (list.empty()) return Vec2(-1, -1);
+  return point_map_.at(layer).at(list[random.nextInt(0, int(list.size()) - 1)]);
 }
 
-// ReSharper disable once CppLocalVariableMayBeConst
-Vec2H::const_iterator TmxObject::getRandomPosition(const string& layer) {
-  const auto& info = positions_map_.at(layer);
-  auto engine = mt19937(random_device{}());
-  auto distrobution = uniform_int_distribution<>(0, int(info.size()) - 1);
-  auto it = info.begin();
+bool TmxObject::containsCollision(const Point& point, const string& layer) {
+  // Anything outside of the loaded chunks is treated as a wall so paths never lead into unloaded space.
+  if (isChunked() and loaded_chunks_.find(getChunkIndex(point)) == loaded_chunks_.end()) return true;
+
+  const auto& info = collistions_map_.at(layer);
+  return find(info.begin(), info.end(), point) not_eq info.end();
+}
+
+TmxChunk TmxObject::buildChunk(const TMXMapInfo& info, const int index, const Point& origin) const {
+  TmxChunk chunk;
+  chunk.index = index;
+  chunk.area = Rect(origin, info.getMapSize());
+
+  for_each(info_.begin(), info_.end(), [&](const Value& data) -> void {
+    const auto& values = data.asValueMap();
+    const auto name = values.at(__NAME__).asString();
+    const auto layer = values.at(__LAYER__).asString();
+
+    // Find the layer in the parsed chunk.
+    const auto& layers = info.getLayers();
+    const auto tmx_layer = find_if(layers.begin(), layers.end(), [&](const TMXLayerInfo* layer_info) {
+      return layer_info->_name == layer;
+    });
+    CCASSERT(tmx_layer not_eq layers.end(),
+             string("TmxObject: Chunk does not contain layer by this name" + layer).c_str());
+
+    // GIDs are stored row major relative to the chunk, so points of the whole map have to be shifted back.
+    const auto& tiles = (*tmx_layer)->_tiles;
+    const auto width = int((*tmx_layer)->_layerSize.width);
+    const auto gid_at = [&](const Point& point) -> uint32_t {
+      const auto tile = tiles[int(point.x - origin.x) + int(point.y - origin.y) * width];
+      return tile & kTMXFlippedMask;
+    };
+
+    generateTiles(values, gid_at, chunk.area, chunk.points[name], chunk.positions[name],
+                  chunk.collisions[name]);
+  });
+
+  return chunk;
+}
+
+void TmxObject::insertChunk(const TmxChunk& chunk) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxObject::insertChunk");
+  CCASSERT(isChunked(), "TmxObject: Chunks can only be inserted into a chunked TmxObject...");
+
+  // Merge the chunk into the maps that already exist for every name
+  for (const auto& points : chunk.points) {
+    point_map_.at(points.first).insert(points.second.begin(), points.second.end());
+
+    auto& list = point_list_map_.at(points.first);
+    for (const auto& point : points.second) list.emplace_back(point.first);
+  }
+
+  for (const auto& positions : chunk.positions) {
+    const auto itr = positions_map_.find(positions.first);
+    if (itr not_eq positions_map_.end()) itr->second.insert(positions.second.begin(), positions.second.end());
+  }
+
+  for (const auto& collisions : chunk.collisions) {
+    const auto itr = collistions_map_.find(collisions.first);
+    if (itr not_eq collistions_map_.end())
+      itr->second.insert(itr->second.end(), collisions.second.begin(), collisions.second.end());
+  }
+
+  loaded_chunks_.emplace(chunk.index);
+}
+
+void TmxObject::eraseChunk(const int index, const Rect& area) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TmxObject::eraseChunk");
+  loaded_chunks_.erase(index);
+
+  for (auto& points : point_map_) {
+    const auto positions = positions_map_.find(points.first);
+
+    // Erase every point in the area, along with the inverse position if there is one.
+    for (auto px = area.getMinX(); px < area.getMaxX(); px++)
+      for (auto py = area.getMinY(); py < area.getMaxY(); py++) {
+        const auto itr = points.second.find(Point(px, py));
+        if (itr == points.second.end()) continue;
+        if (positions not_eq positions_map_.end()) positions->second.erase(itr->second);
+        points.second.erase(itr);
+      }
+  }
+
+  const auto in_area = [&](const Point& point) {
+    return point.x >= area.getMinX() and point.x < area.getMaxX() and point.y >= area.getMinY() and
+           point.y < area.getMaxY();
+  };
+
+  for (auto& points : point_list_map_) {
+    auto& list = points.second;
+    list.erase(remove_if(list.begin(), list.end(), in_area), list.end());
+  }
+
+  for (auto& collisions : collistions_map_) {
+    auto& walls = collisions.second;
+    walls.erase(remove_if(walls.begin(), walls.end(), in_area), walls.end());
+  }
+}
+
+int TmxObject::getChunkIndex(const Point& point) const {
+  if (not isChunked()) return -1;
+  return int(point.y) / chunk_size_ * chunks_wide_ + int(point.x) / chunk_size_;
+}
+
+bool TmxObject::isChunked() const { return chunk_size_ > 0; }
+
+void TmxObject::generateTiles(const ValueMap& values, const function<uint32_t(const Point&)>& gid_at,
+                              const Rect& area, PointH& points, Vec2H& positions,
+                              vector<Point>& collisions) const {
+  // By default, inverse positions are not enable. So check to see that they are
+  const auto use_positions =
+      values.find(__INVERSE__) not_eq values.end() and values.at(__INVERSE__).asBool();
+  const auto use_collistions =
+      values.find(__COLLISIONS__) not_eq values.end() and values.at(__COLLISIONS__).asBool();
+
+  // Loop through all of the iteration of the area to generate the correct tiles.
+  for (auto px = area.getMinX(); px < area.getMaxX(); px++)
+    for (auto py = area.getMinY(); py < area.getMaxY(); py++) {
+      // The point we are currently evaluating.
+      const auto point = Point(px, py);
+      const auto gid = gid_at(point);
+
+      // Assure the tile is not null
+      if (gid == 0) {
+        if (use_collistions) collisions.emplace_back(point);
+        continue;
+      }
+
+      // If the value set has GIDs, Assure that the gid of the tile is part of this list
+      if (values.find(__GIDS__) not_eq values.end()) {
+        const auto& gids = values.at(__GIDS__).asValueMap();
+        if (gids.find(to_string(gid)) == gids.end()) continue;
+      }
+
+      // Calculate location on screen and construct position object. Positions are always relative to the
+      // whole map so chunks line up with each other.
+      const auto vx = center_.x - ((size_.width - 1) / 2 - px) * 108;
+      const auto vy = center_.y + ((size_.height - 1) / 2 - py) * 108;
+      const auto position = Vec2(vx, vy);
 
-  std::advance(it, distrobution(engine));
-  return it;
+      // Insert tiles into the maps
+      points.emplace(point, position);
+      if (use_positions) positions.emplace(position, point);
+    }
 }
@@ -13,7 +13,9 @@
 /**
  * Includes
  */
+#include <unordered_set>
 #include "globals.hxx"
+#include "objects/random/random_object.hxx"
 #include "xxhash/xxhash.h"
 
 /**
@@ -53,6 +55,27 @@ struct Vec2Hash {
 using PointH = unordered_map<const Point, const Vec2, PointHash>;
 using Vec2H = unordered_map<const Vec2, const Point, Vec2Hash>;
 
+/**
+ * Tiles generated for a single chunk of a chunked map. These are built off the main thread with
+ * TmxObject::buildChunk() and merged on the main thread with TmxObject::insertChunk().
+ */
+struct TmxChunk {
+  // Index of the chunk in the chunk grid (row major).
+  int index{-1};
+
+  // Area of the map covered by the chunk, in tiles.
+  Rect area;
+
+  // Maps of points -> vec2 positions by name.
+  unordered_map<string, PointH> points;
+
+  // Maps of vec2 positions -> points by name.
+  unordered_map<string, Vec2H> positions;
+
+  // Collision walls by name.
+  unordered_map<string, vector<Point>> collisions;
+};
+
 /**
  * TmxObject
  */
@@ -71,6 +94,16 @@ class TmxObject : Ref {
    */
   explicit TmxObject(const TMXTiledMap& map, const ValueVector& info);
 
+  /**
+   * Construction of an empty TmxObject for a chunked map. Tiles are added and removed with
+   * TmxObject::insertChunk() and TmxObject::eraseChunk() as chunks are streamed in and out.
+   *
+   * @param size       ~ Size of the whole map in tiles.
+   * @param chunk_size ~ Width and height of a single chunk in tiles.
+   * @param info       ~ ValueVextor of info to generate the tmx-object.
+   */
+  explicit TmxObject(const Size& size, int chunk_size, const ValueVector& info);
+
   /**
    * Destructor.
    */
@@ -133,25 +166,113 @@ class TmxObject : Ref {
   Vec2H::const_iterator getPositionPair(const Vec2& position, const string& layer);
 
   /**
-   * Gets a random point pair from a point hashed map
+   * Gets a random point from the `tmx_object` by layer. Every point in the layer is equally likely.
    *
    * @param layer      ~ The layer name to search for the point.
-   * @returns ~ Pair containing the position as key and point as value.
+   * @param random     ~ Generator to draw the point from.
+   *
+   * @returns ~ Point if the layer has any, otherwise Point(-1, -1).
    */
-  PointH::const_iterator getRandomPoint(const string& layer);
+  Point getRandomPoint(const string& layer, RandomObject& random);
 
   /**
-   * Gets a random point pair from a point hashed map
+   * Gets a random position from the `tmx_object` by layer. Every position in the layer is equally likely.
    *
+   * @param layer      ~ The layer name to search for the position.
+   * @param random     ~ Generator to draw the position from.
+   *
+   * @returns ~ Position if the layer has any, otherwise Vec2(-1, -1).
+   */
+  Vec2 getRandomPosition(const string& layer, RandomObject& random);
+
+  /**
+   * Checks if a point is a collision wall for the layer. For chunked maps, every point of a chunk that is not
+   * loaded is considered a wall.
+   *
+   * @param point      ~ The point reference.
    * @param layer      ~ The layer name to search for the point.
-   * @returns ~ Pair containing the position as key and point as value.
    */
-  PointH::const_iterator getRandomPosition(const string& layer);
+  bool containsCollision(const Point& point, const string& layer);
+
+  /**
+   * Generates the tiles of a single chunk. This only reads state that is fixed at construction, so it is safe
+   * to call from a worker thread while the main thread is querying the object.
+   *
+   * @param info   ~ Parsed TMX of the chunk.
+   * @param index  ~ Index of the chunk in the chunk grid.
+   * @param origin ~ Point of the top left tile of the chunk in the whole map.
+   *
+   * @returns ~ @link TmxChunk
+   */
+  TmxChunk buildChunk(const TMXMapInfo& info, int index, const Point& origin) const;
+
+  /**
+   * Merges the tiles of a chunk into this object.
+   *
+   * @param chunk ~ Chunk generated by TmxObject::buildChunk().
+   */
+  void insertChunk(const TmxChunk& chunk);
+
+  /**
+   * Removes all of the tiles of a chunk from this object.
+   *
+   * @param index ~ Index of the chunk in the chunk grid.
+   * @param area  ~ Area of the map covered by the chunk, in tiles.
+   */
+  void eraseChunk(int index, const Rect& area);
+
+  /**
+   * Gets the index of the chunk containing `point` in the chunk grid.
+   *
+   * @param point ~ The point reference.
+   *
+   * @returns ~ Chunk index, or -1 if this object is not chunked.
+   */
+  int getChunkIndex(const Point& point) const;
+
+  /**
+   * Checks if this object was created for a chunked map.
+   */
+  bool isChunked() const;
 
  protected:
+  /**
+   * Generates the tiles of a single layer in `area`.
+   *
+   * @param values     ~ Info describing which tiles to generate.
+   * @param gid_at     ~ Function returning the GID at a point of the whole map, 0 if there is no tile.
+   * @param area       ~ Area of the map to generate, in tiles.
+   * @param points     ~ Map of points -> vec2 positions to fill.
+   * @param positions  ~ Map of vec2 positions -> points to fill.
+   * @param collisions ~ Collision walls to fill.
+   */
+  void generateTiles(const ValueMap& values, const function<uint32_t(const Point&)>& gid_at, const Rect& area,
+                     PointH& points, Vec2H& positions, vector<Point>& collisions) const;
+
+  // Size of the whole map in tiles.
+  Size size_;
+
+  // Center of the screen which the map is positioned around.
+  Vec2 center_;
+
+  // Info used to generate the tiles. Kept so chunks can be generated after construction.
+  ValueVector info_;
+
+  // Width and height of a chunk in tiles, 0 if the map is not chunked.
+  int chunk_size_{0};
+
+  // Number of chunks in a row of the chunk grid.
+  int chunks_wide_{0};
+
+  // Indexes of the chunks that are currently merged into this object.
+  unordered_set<int> loaded_chunks_;
+
   // Map containing maps of points -> vec2 positions
   unordered_map<string, PointH> point_map_;
 
+  // Map containing the same points as `point_map_` in flat lists, so random tiles can be drawn by index.
+  unordered_map<string, vector<Point>> point_list_map_;
+
   // Map containing vectors of collistion walls.
   unordered_map<string, vector<Point>> collistions_map_;
 
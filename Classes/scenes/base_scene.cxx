@@ -47,6 +47,9 @@ void BaseScene::onEnter() {
 }
 
 void BaseScene::onExit() {
+  // Release the texture and pack of the scene. They stay resident in case the next scene needs them.
+  AssetEngine::getInstance()->release(script_->at(__TEXTURE__).asString());
+
   // Unload all scripts and params
   __CCLOGWITHFUNCTION("Unloading Scene: %s", getName().c_str());
   script_.reset();
@@ -57,15 +60,15 @@ void BaseScene::onExit() {
   text_manager_.reset();
   menu_manager_.reset();
 
+  // Pooled particles have to be taken back while their parents are still alive.
+  ParticleUtils::reclaim(this);
+
   // Remove everything from the main layer
   main_layer_->removeAllChildren();
 
   // Remove everything from the scene
   removeAllChildren();
 
-  // Unload all unused textures.
-  Director::getInstance()->purgeCachedData();
-
   // Call Base
   Scene::onExit();
 }
@@ -94,14 +97,9 @@ void BaseScene::initialize() {
   // initialization.
   beforeInitialized();
 
-  // Load the texture in async
-  Director::getInstance()->getTextureCache()->addImageAsync(texture, [=](Texture2D* loaded) {
-    loaded->setAntiAliasTexParameters();
-
-    // Cache the sprite frames using the async loaded textures
-    auto plist = ArchiveUtils::loadValueMap(script_->at(__PACK__).asString());
-    SpriteFrameCache::getInstance()->addSpriteFramesWithDictionary(plist, loaded);
-
+  // Load the texture and pack in async, unless they are still resident from a previous scene.
+  const auto& pack = script_->at(__PACK__).asString();
+  AssetEngine::getInstance()->acquire(texture, pack, [=](Texture2D* /* loaded */) {
     // Initialize sprites.
     if (script_->find(__SPRITES__) != script_->end())
       sprite_manager_.reset(new (nothrow)
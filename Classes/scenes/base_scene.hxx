@@ -32,6 +32,7 @@
 /**
  * Include Engines
  */
+#include "engines/asset/asset_engine.hxx"
 #include "engines/fmod/fmod_engine.hxx"
 
 class BaseScene : public Scene {
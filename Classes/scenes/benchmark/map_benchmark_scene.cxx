@@ -0,0 +1,74 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "map_benchmark_scene.hxx"
+#include "engines/tmx/tmx_engine.hxx"
+
+MapBenchmarkScene::MapBenchmarkScene()
+    : map_(nullptr),
+      frames_(0),
+      resident_(0),
+      frame_peak_(0),
+      load_time_(chrono::steady_clock::duration::zero()),
+      focus_time_(chrono::steady_clock::duration::zero()),
+      focus_peak_(chrono::steady_clock::duration::zero()) {}
+
+MapBenchmarkScene::~MapBenchmarkScene() = default;
+
+bool MapBenchmarkScene::init() {
+  if (not Scene::init()) return false;
+
+  // Set the map up the same way BaseGameScene::initializeChunkedMap does.
+  const auto directory = string(__MAP_BENCHMARK_PATH__) + __MAP_BENCHMARK_NAME__ + "/";
+  map_ = TmxChunkMap::create(directory);
+  if (map_ == nullptr) return false;
+
+  map_->setName(directory);
+  map_->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+  map_->setPosition(Globals::getScreenPosition());
+  map_->setScale(Globals::getVisibleSize().width / map_->getContentSize().width);
+  TmxEngine::getInstance()->cache(map_, ESACPE);
+  addChild(map_);
+
+  const auto start = chrono::steady_clock::now();
+  map_->focus(map_->getSpawnPoint(), false);
+  load_time_ = chrono::steady_clock::now() - start;
+
+  scheduleUpdate();
+  return true;
+}
+
+void MapBenchmarkScene::update(const float delta) {
+  Scene::update(delta);
+
+  const auto start = chrono::steady_clock::now();
+  map_->focus(point_);
+  const auto time = chrono::steady_clock::now() - start;
+  focus_time_ += time;
+  focus_peak_ = max(focus_peak_, time);
+  resident_ = max(resident_, map_->getChildrenCount());
+  frame_peak_ = max(frame_peak_, delta);
+  frames_++;
+
+  // Walk along the row, then on to the next one.
+  const auto size = map_->getMapSize();
+  point_.x++;
+  if (point_.x < size.width) return;
+  point_ = Point(0, point_.y + 1);
+  if (point_.y < size.height) return;
+
+  CCLOG("MapBenchmarkScene: %dx%d tiles, spawn load %.3f ms, focus %.3f ms average, %.3f ms worst, "
+        "worst frame %.3f ms, %d of %d chunks resident",
+        int(size.width), int(size.height), chrono::duration<double, milli>(load_time_).count(),
+        chrono::duration<double, milli>(focus_time_).count() / frames_,
+        chrono::duration<double, milli>(focus_peak_).count(), frame_peak_ * 1000, int(resident_),
+        int(ceil(size.width / map_->getChunkSize()) * ceil(size.height / map_->getChunkSize())));
+
+  // Start walking again.
+  point_ = Point::ZERO;
+  frames_ = 0;
+  resident_ = 0;
+  frame_peak_ = 0;
+  focus_time_ = chrono::steady_clock::duration::zero();
+  focus_peak_ = chrono::steady_clock::duration::zero();
+}
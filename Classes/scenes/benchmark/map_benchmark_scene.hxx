@@ -0,0 +1,81 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __MAP_BENCHMARK_SCENE_HXX__
+#define __MAP_BENCHMARK_SCENE_HXX__
+
+/**
+ * Map Benchmark Map. The largest escape map, split into chunks by xTmx/chunk_tmx.py.
+ */
+#define __MAP_BENCHMARK_PATH__ "tmx/escape/"
+#define __MAP_BENCHMARK_NAME__ "trial_classic_39"
+
+/**
+ * Includes
+ */
+#include <chrono>
+#include "globals.hxx"
+#include "objects/tmx/tmx_chunk_map.hxx"
+
+/**
+ * Measures what streaming a chunked map costs while walking across it. The focus moves one tile per frame
+ * along every row of the map in turn, so every chunk is loaded and evicted at least once per walk. Each time
+ * a walk is finished, the blocking load around the spawn point, the average and worst time spent focusing the
+ * map in a frame, the longest frame, and the most chunks that were resident at once are logged. It can be run
+ * in place of the game by defining __APP_DELEGATE_BENCHMARK__.
+ */
+class MapBenchmarkScene : public Scene {
+ public:
+  /**
+   * Constructor.
+   */
+  explicit MapBenchmarkScene();
+
+  /**
+   * Destructor.
+   */
+  virtual ~MapBenchmarkScene();
+
+  /**
+   * @link Scene::init
+   */
+  bool init() override;
+
+  /**
+   * Moves the focus one tile further along the walk, and logs the results once the walk is finished.
+   *
+   * @param delta ~ 1 / framerate.
+   */
+  void update(float delta) override;
+
+  // Create function
+  CREATE_FUNC(MapBenchmarkScene)
+
+ protected:
+  // The map being streamed.
+  TmxChunkMap* map_;
+
+  // Point the focus is currently on.
+  Point point_;
+
+  // Frames measured in the current walk.
+  int frames_;
+
+  // Most chunks resident at once during the current walk.
+  ssize_t resident_;
+
+  // Longest frame of the current walk. Chunks are attached to the map between frames, so this is where the
+  // cost of building their nodes shows up.
+  float frame_peak_;
+
+  // Time spent blocking on the chunks around the spawn point.
+  chrono::steady_clock::duration load_time_;
+
+  // Time spent focusing the map during the current walk, and the longest a single frame took.
+  chrono::steady_clock::duration focus_time_;
+  chrono::steady_clock::duration focus_peak_;
+
+ private:
+  __DISALLOW_COPY_AND_ASSIGN__(MapBenchmarkScene)
+};
+
+#endif  // __MAP_BENCHMARK_SCENE_HXX__
@@ -0,0 +1,156 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "parse_benchmark_scene.hxx"
+#include <atomic>
+#include <cstdlib>
+#include "app/app_delegate.hxx"
+#include "utils/archive/archive_utils.hxx"
+
+// Bytes currently allocated with operator new, and the most there have been since the last measurement began.
+static atomic<size_t> allocated_bytes(0);
+static atomic<size_t> peak_bytes(0);
+
+#ifdef __APP_DELEGATE_BENCHMARK__
+// Every allocation is prefixed with its size so the matching delete can account for it. This replaces the
+// allocator of the whole app, so it is only compiled into benchmark builds.
+static const size_t allocation_header = alignof(max_align_t);
+
+static void* allocate(const size_t size) {
+  const auto block = static_cast<char*>(malloc(size + allocation_header));
+  if (block == nullptr) return nullptr;
+  *reinterpret_cast<size_t*>(block) = size;
+
+  const auto now = allocated_bytes += size;
+  auto peak = peak_bytes.load();
+  while (now > peak and not peak_bytes.compare_exchange_weak(peak, now)) {
+  }
+  return block + allocation_header;
+}
+
+static void deallocate(void* pointer) {
+  if (pointer == nullptr) return;
+  const auto block = static_cast<char*>(pointer) - allocation_header;
+  allocated_bytes -= *reinterpret_cast<size_t*>(block);
+  free(block);
+}
+
+void* operator new(const size_t size) {
+  const auto pointer = allocate(size);
+  if (pointer == nullptr) throw bad_alloc();
+  return pointer;
+}
+
+void* operator new[](const size_t size) { return operator new(size); }
+void* operator new(const size_t size, const nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](const size_t size, const nothrow_t&) noexcept { return allocate(size); }
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, const nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, const nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { deallocate(pointer); }
+#endif
+
+/**
+ * TMXMapInfo parsed through the DOM of SAXParser::parse, the way every map was parsed before parsing
+ * in place.
+ */
+class DomMapInfo : public TMXMapInfo {
+ public:
+  bool parse(const string& xml) {
+    internalInit(string(), string());
+    SAXParser parser;
+    if (not parser.init("UTF-8")) return false;
+    parser.setDelegator(this);
+    return parser.parse(xml.c_str(), xml.size());
+  }
+};
+
+/**
+ * Delegate that only counts what it is handed, so plists are parsed without building a ValueMap.
+ */
+class ElementCounter : public SAXDelegator {
+ public:
+  void startElement(void*, const char*, const char**) override { elements_++; }
+  void endElement(void*, const char*) override {}
+  void textHandler(void*, const char*, const size_t length) override { text_ += length; }
+
+ private:
+  // Elements and characters of text seen so far.
+  size_t elements_ = 0;
+  size_t text_ = 0;
+};
+
+ParseBenchmarkScene::ParseBenchmarkScene() = default;
+
+ParseBenchmarkScene::~ParseBenchmarkScene() = default;
+
+bool ParseBenchmarkScene::init() {
+  if (not Scene::init()) return false;
+  scheduleUpdate();
+  return true;
+}
+
+void ParseBenchmarkScene::update(const float delta) {
+  Scene::update(delta);
+  unscheduleUpdate();
+
+  const auto maps = load(".tmx");
+  log("maps", maps.size(), measure(maps, [](string& xml) {
+    const auto info = new DomMapInfo();
+    info->parse(xml);
+    info->release();
+  }), measure(maps, [](string& xml) {
+    const auto info = new TMXMapInfo();
+    info->initWithXML(move(xml), string());
+    info->release();
+  }));
+
+  const auto plists = load(".plist");
+  log("plists", plists.size(), measure(plists, [](string& xml) {
+    ElementCounter counter;
+    SAXParser parser;
+    parser.setDelegator(&counter);
+    parser.parse(xml.c_str(), xml.size());
+  }), measure(plists, [](string& xml) {
+    ElementCounter counter;
+    SAXParser parser;
+    parser.setDelegator(&counter);
+    parser.parseIntrusive(&xml.front(), xml.size());
+  }));
+}
+
+void ParseBenchmarkScene::log(const string& kind, const size_t files, const ParseResult& dom,
+                              const ParseResult& in_place) {
+  CCLOG("ParseBenchmarkScene: %d %s: tinyxml2 %.3f ms, %.1f KB peak; in place %.3f ms, %.1f KB peak",
+        int(files), kind.c_str(), dom.millis, dom.peak / 1024.0, in_place.millis, in_place.peak / 1024.0);
+}
+
+ParseResult ParseBenchmarkScene::measure(const vector<string>& texts, const function<void(string&)>& parse) {
+  ParseResult result{0, 0};
+  auto time = chrono::steady_clock::duration::zero();
+  for (auto run = 0; run < __PARSE_BENCHMARK_RUNS__; run++) {
+    for (const auto& text : texts) {
+      auto buffer = text;
+
+      // Only what the parse allocates on top of what is already allocated counts.
+      const auto base = allocated_bytes.load();
+      peak_bytes = base;
+
+      const auto start = chrono::steady_clock::now();
+      parse(buffer);
+      time += chrono::steady_clock::now() - start;
+      result.peak = max(result.peak, peak_bytes.load() - base);
+    }
+  }
+
+  result.millis = chrono::duration<double, milli>(time).count() / __PARSE_BENCHMARK_RUNS__;
+  return result;
+}
+
+vector<string> ParseBenchmarkScene::load(const string& extension) {
+  vector<string> texts;
+  for (const auto& file : ArchiveUtils::list(extension)) texts.emplace_back(ArchiveUtils::loadString(file));
+  return texts;
+}
@@ -0,0 +1,97 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __PARSE_BENCHMARK_SCENE_HXX__
+#define __PARSE_BENCHMARK_SCENE_HXX__
+
+/**
+ * Parse Benchmark Timing. Number of times every file is parsed by each path.
+ */
+#define __PARSE_BENCHMARK_RUNS__ 20
+
+/**
+ * Includes
+ */
+#include <chrono>
+#include "globals.hxx"
+
+/**
+ * Result of parsing a set of files with one path.
+ */
+struct ParseResult {
+  // Average time it took to parse every file once.
+  double millis;
+
+  // Most memory allocated with operator new while parsing a single file, in bytes.
+  size_t peak;
+};
+
+/**
+ * Parses every map and plist in the archive with tinyxml2, which copies the text and builds a DOM first, and
+ * then in place with rapidxml, and logs the parse time and peak memory of both. Maps go through TMXMapInfo
+ * both ways, so layer data is decoded the same way. Plists go to a delegate that only counts elements, since
+ * DictMaker handles both parsers the same. Peak memory is only tracked when __APP_DELEGATE_BENCHMARK__ is
+ * defined, which is also how the scene is run in place of the game.
+ */
+class ParseBenchmarkScene : public Scene {
+ public:
+  /**
+   * Constructor.
+   */
+  explicit ParseBenchmarkScene();
+
+  /**
+   * Destructor.
+   */
+  virtual ~ParseBenchmarkScene();
+
+  /**
+   * @link Scene::init
+   */
+  bool init() override;
+
+  /**
+   * Runs the benchmark on the first frame, once the scene is on screen.
+   *
+   * @param delta ~ 1 / framerate.
+   */
+  void update(float delta) override;
+
+  // Create function
+  CREATE_FUNC(ParseBenchmarkScene)
+
+ protected:
+  /**
+   * Parses every file __PARSE_BENCHMARK_RUNS__ times. Each file is copied before the clock starts, so a path
+   * that parses in place doesn't pay for the copy the archive already gives it.
+   *
+   * @param texts ~ Contents of the files.
+   * @param parse ~ Parses a single file, and may modify it.
+   *
+   * @returns ~ Time and peak memory of the path.
+   */
+  static ParseResult measure(const vector<string>& texts, const function<void(string&)>& parse);
+
+  /**
+   * Loads every file in the archive with an extension.
+   *
+   * @param extension ~ Extension of the files, including the dot.
+   *
+   * @returns ~ Contents of the files.
+   */
+  static vector<string> load(const string& extension);
+
+  /**
+   * Logs the results of both paths for a kind of file.
+   *
+   * @param kind     ~ Kind of file, e.g. maps.
+   * @param files    ~ Number of files parsed.
+   * @param dom      ~ Result of parsing with tinyxml2.
+   * @param in_place ~ Result of parsing in place.
+   */
+  static void log(const string& kind, size_t files, const ParseResult& dom, const ParseResult& in_place);
+
+ private:
+  __DISALLOW_COPY_AND_ASSIGN__(ParseBenchmarkScene)
+};
+
+#endif  // __PARSE_BENCHMARK_SCENE_HXX__
@@ -0,0 +1,77 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "particle_benchmark_scene.hxx"
+#include "2d/CCParticleSystemKernels.h"
+
+ParticleBenchmarkScene::ParticleBenchmarkScene(const int config)
+    : config_(config), frames_(0), update_time_(chrono::steady_clock::duration::zero()) {}
+
+ParticleBenchmarkScene::~ParticleBenchmarkScene() = default;
+
+ParticleBenchmarkScene* ParticleBenchmarkScene::create(const int config) {
+  auto scene = new (nothrow) ParticleBenchmarkScene(config % __PARTICLE_BENCHMARK_CONFIGS__);
+  if (scene and scene->init() and scene->initialize()) {
+    scene->autorelease();
+    return scene;
+  }
+  CC_SAFE_DELETE(scene);
+  return nullptr;
+}
+
+bool ParticleBenchmarkScene::initialize() {
+  const auto size = Globals::getVisibleSize();
+  for (auto i = 0; i < __PARTICLE_BENCHMARK_EMITTERS__; i++) {
+    // The galaxy emits its whole capacity over one lifetime and uses the built in texture, so nothing has to
+    // be loaded and the emitters stay full once warmed up.
+    const auto emitter = ParticleGalaxy::createWithTotalParticles(__PARTICLE_BENCHMARK_PARTICLES__);
+    if (emitter == nullptr) return false;
+
+    if (config_ == __PARTICLE_BENCHMARK_RADIUS__) {
+      emitter->setEmitterMode(ParticleSystem::Mode::RADIUS);
+      emitter->setStartRadius(0);
+      emitter->setStartRadiusVar(size.width / 8);
+      emitter->setEndRadius(size.width / 4);
+      emitter->setRotatePerSecond(90);
+      emitter->setRotatePerSecondVar(45);
+    }
+
+    // Spin the particles so the rotated quad path is measured too.
+    emitter->setStartSpin(0);
+    emitter->setEndSpin(360);
+    emitter->setPosition(Globals::getOrigin() + Vec2(size.width * (i % 2 + 0.5f) / 2,
+                                                     size.height * (i / 2 + 0.5f) / 2));
+    addChild(emitter);
+    emitters_.emplace_back(emitter);
+  }
+
+  scheduleUpdate();
+  return true;
+}
+
+void ParticleBenchmarkScene::onEnter() {
+  Scene::onEnter();
+  for (const auto& emitter : emitters_) emitter->unscheduleUpdate();
+}
+
+void ParticleBenchmarkScene::update(const float delta) {
+  Scene::update(delta);
+
+  const auto start = chrono::steady_clock::now();
+  for (const auto& emitter : emitters_) emitter->update(delta);
+  if (++frames_ > __PARTICLE_BENCHMARK_WARMUP__) update_time_ += chrono::steady_clock::now() - start;
+
+  if (frames_ < __PARTICLE_BENCHMARK_WARMUP__ + __PARTICLE_BENCHMARK_FRAMES__) return;
+
+  auto particles = 0;
+  for (const auto& emitter : emitters_) particles += emitter->getParticleCount();
+
+  CCLOG("ParticleBenchmarkScene: %s mode, %d particles, %d wide kernels: %.3f ms, %.0f particles per ms",
+        config_ == __PARTICLE_BENCHMARK_RADIUS__ ? "Radius" : "Gravity", particles, CC_PARTICLE_SIMD_WIDTH,
+        chrono::duration<double, milli>(update_time_).count() / __PARTICLE_BENCHMARK_FRAMES__,
+        particles * __PARTICLE_BENCHMARK_FRAMES__ / chrono::duration<double, milli>(update_time_).count());
+
+  // Move on to the next configuration.
+  unscheduleUpdate();
+  Director::getInstance()->replaceScene(create(config_ + 1));
+}
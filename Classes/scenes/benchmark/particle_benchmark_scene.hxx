@@ -0,0 +1,99 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __PARTICLE_BENCHMARK_SCENE_HXX__
+#define __PARTICLE_BENCHMARK_SCENE_HXX__
+
+/**
+ * Particle Benchmark Emitters
+ */
+#define __PARTICLE_BENCHMARK_EMITTERS__ 4
+#define __PARTICLE_BENCHMARK_PARTICLES__ 10000
+
+/**
+ * Particle Benchmark Timing. Emitters are left to fill up for __PARTICLE_BENCHMARK_WARMUP__ frames before
+ * __PARTICLE_BENCHMARK_FRAMES__ frames are measured.
+ */
+#define __PARTICLE_BENCHMARK_WARMUP__ 300
+#define __PARTICLE_BENCHMARK_FRAMES__ 300
+
+/**
+ * Particle Benchmark Configurations. Each emitter mode is measured in turn.
+ */
+#define __PARTICLE_BENCHMARK_GRAVITY__ 0
+#define __PARTICLE_BENCHMARK_RADIUS__ 1
+#define __PARTICLE_BENCHMARK_CONFIGS__ 2
+
+/**
+ * Includes
+ */
+#include <chrono>
+#include "globals.hxx"
+
+/**
+ * Measures how long updating emitters of __PARTICLE_BENCHMARK_PARTICLES__ particles takes, which covers the
+ * integration, the color, size and rotation deltas, dead particle compaction and quad generation. Gravity and
+ * radius mode are measured in turn, and the average is logged along with the width of the particle kernels.
+ * Building the engine with CC_PARTICLE_SCALAR defined measures the scalar kernels to compare against. It
+ * doesn't need any assets, so it can be run in place of the game by defining __APP_DELEGATE_BENCHMARK__.
+ */
+class ParticleBenchmarkScene : public Scene {
+  /**
+   * Constructor.
+   *
+   * @param config ~ __PARTICLE_BENCHMARK_GRAVITY__ or __PARTICLE_BENCHMARK_RADIUS__.
+   */
+  explicit ParticleBenchmarkScene(int config);
+
+  /**
+   * Destructor.
+   */
+  virtual ~ParticleBenchmarkScene();
+
+ public:
+  /**
+   * Creates the scene for a configuration.
+   *
+   * @param config ~ __PARTICLE_BENCHMARK_GRAVITY__ or __PARTICLE_BENCHMARK_RADIUS__.
+   *
+   * @returns ~ Autoreleased scene, or nullptr if it failed to initialize.
+   */
+  static ParticleBenchmarkScene* create(int config = __PARTICLE_BENCHMARK_GRAVITY__);
+
+  /**
+   * Takes the emitters off the scheduler so only ParticleBenchmarkScene::update steps them.
+   *
+   * @link Node::onEnter
+   */
+  void onEnter() override;
+
+  /**
+   * Steps every emitter by hand so only the emitters are timed, and moves on to the next configuration once
+   * enough frames have been measured.
+   *
+   * @param delta ~ 1 / framerate.
+   */
+  void update(float delta) override;
+
+ protected:
+  /**
+   * Adds the emitters for the configuration.
+   */
+  bool initialize();
+
+  // __PARTICLE_BENCHMARK_GRAVITY__ or __PARTICLE_BENCHMARK_RADIUS__.
+  const int config_;
+
+  // Every emitter in the scene.
+  vector<ParticleSystemQuad*> emitters_;
+
+  // Frames stepped so far, including the warmup.
+  int frames_;
+
+  // Time spent updating the emitters.
+  chrono::steady_clock::duration update_time_;
+
+ private:
+  __DISALLOW_COPY_AND_ASSIGN__(ParticleBenchmarkScene)
+};
+
+#endif  // __PARTICLE_BENCHMARK_SCENE_HXX__
@@ -0,0 +1,122 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "physics_benchmark_scene.hxx"
+
+PhysicsBenchmarkScene::PhysicsBenchmarkScene(const int config)
+    : config_(config), frames_(0), contacts_(0), step_time_(chrono::steady_clock::duration::zero()) {}
+
+PhysicsBenchmarkScene::~PhysicsBenchmarkScene() = default;
+
+PhysicsBenchmarkScene* PhysicsBenchmarkScene::create(const int config) {
+  auto scene = new (nothrow) PhysicsBenchmarkScene(config % __PHYSICS_BENCHMARK_CONFIGS__);
+  if (scene and scene->initWithPhysics() and scene->initialize()) {
+    scene->autorelease();
+    return scene;
+  }
+  CC_SAFE_DELETE(scene);
+  return nullptr;
+}
+
+bool PhysicsBenchmarkScene::initialize() {
+  // The settings BaseGameScene can use, minus whatever the configuration turns off.
+  const auto physics_world = getPhysicsWorld();
+  physics_world->setGravity(Vec2::ZERO);
+  physics_world->setAutoStep(false);
+  physics_world->setContactOnly((config_ & __PHYSICS_BENCHMARK_CONTACT_ONLY__) not_eq 0);
+  physics_world->setSyncOnlyMovedBodies((config_ & __PHYSICS_BENCHMARK_SLEEPING__) not_eq 0);
+  if (config_ & __PHYSICS_BENCHMARK_SLEEPING__)
+    physics_world->setSleepTimeThreshold(__PHYSICS_SLEEP_THRESHOLD__);
+  if (config_ & __PHYSICS_BENCHMARK_SPATIAL_HASH__)
+    physics_world->useSpatialHash(__PHYSICS_BENCHMARK_TILE_SIZE__,
+                                  min(__PHYSICS_BENCHMARK_MAZE_SIZE__ * __PHYSICS_BENCHMARK_MAZE_SIZE__,
+                                      __PHYSICS_SPATIAL_HASH_CELLS__));
+
+  initializeWalls();
+  initializeActors();
+
+  // Count contacts so a configuration that drops them would stand out.
+  auto contact_listener = EventListenerPhysicsContact::create();
+  contact_listener->onContactBegin = [this](PhysicsContact&) -> bool {
+    contacts_++;
+    return true;
+  };
+  getEventDispatcher()->addEventListenerWithSceneGraphPriority(contact_listener, this);
+
+  scheduleUpdate();
+  return true;
+}
+
+void PhysicsBenchmarkScene::initializeWalls() {
+  const auto tile = Size(__PHYSICS_BENCHMARK_TILE_SIZE__, __PHYSICS_BENCHMARK_TILE_SIZE__);
+  for (auto x = 0; x < __PHYSICS_BENCHMARK_MAZE_SIZE__; x++) {
+    for (auto y = 0; y < __PHYSICS_BENCHMARK_MAZE_SIZE__; y++) {
+      // Walls run along every 4th row and column, with a door where they cross the middle of a room.
+      const auto wall = (x % 4 == 0 and y % 4 not_eq 2) or (y % 4 == 0 and x % 4 not_eq 2);
+      if (not wall) continue;
+
+      auto physics = PhysicsBody::createBox(tile);
+      physics->setDynamic(false);
+      physics->setContactTestBitmask(2);
+
+      const auto node = Node::create();
+      node->setPosition((x + 0.5f) * tile.width, (y + 0.5f) * tile.height);
+      node->setPhysicsBody(physics);
+      addChild(node);
+    }
+  }
+}
+
+void PhysicsBenchmarkScene::initializeActors() {
+  const auto tile = __PHYSICS_BENCHMARK_TILE_SIZE__;
+  auto actors = 0;
+  for (auto i = 0; actors < __PHYSICS_BENCHMARK_ACTORS__; i++) {
+    // Every other tile inside the rooms gets an actor.
+    const auto cell = i * 2;
+    const auto x = cell % __PHYSICS_BENCHMARK_MAZE_SIZE__;
+    const auto y = cell / __PHYSICS_BENCHMARK_MAZE_SIZE__ % __PHYSICS_BENCHMARK_MAZE_SIZE__;
+    if (x % 4 == 0 or y % 4 == 0) continue;
+
+    // Set up the actor the same way llurkers are.
+    auto physics = PhysicsBody::createCircle(tile / 3, PhysicsMaterial(1, 1, 1));
+    physics->setCollisionBitmask(2);
+    physics->setContactTestBitmask(2);
+    physics->setGroup(-1);
+
+    const auto actor = Sprite::create();
+    actor->setTextureRect(Rect(0, 0, tile / 2, tile / 2));
+    actor->setPosition((x + 0.5f) * tile, (y + 0.5f) * tile);
+    actor->setPhysicsBody(physics);
+    addChild(actor);
+
+    // Step one tile towards the middle of the room and back, waiting a different amount of time in between
+    // so most actors are standing still at any moment.
+    const auto step = Vec2(x % 4 == 3 ? -tile : tile, 0);
+    const auto wait = 0.5f + (actors % 7) * 0.25f;
+    const auto walk = Sequence::create(MoveBy::create(0.25f, step), DelayTime::create(wait),
+                                       MoveBy::create(0.25f, -step), DelayTime::create(wait), nullptr);
+    actor->runAction(RepeatForever::create(walk));
+    actors++;
+  }
+}
+
+void PhysicsBenchmarkScene::update(const float delta) {
+  Scene::update(delta);
+
+  const auto start = chrono::steady_clock::now();
+  getPhysicsWorld()->step(delta);
+  step_time_ += chrono::steady_clock::now() - start;
+
+  if (++frames_ < __PHYSICS_BENCHMARK_FRAMES__) return;
+
+  CCLOG("PhysicsBenchmarkScene: %d bodies, hash %s, sleeping %s, contact only %s: %.3f ms, %d contacts",
+        int(getPhysicsWorld()->getAllBodies().size()),
+        config_ & __PHYSICS_BENCHMARK_SPATIAL_HASH__ ? "on" : "off",
+        config_ & __PHYSICS_BENCHMARK_SLEEPING__ ? "on" : "off",
+        config_ & __PHYSICS_BENCHMARK_CONTACT_ONLY__ ? "on" : "off",
+        chrono::duration<double, milli>(step_time_).count() / frames_, contacts_);
+
+  // Move on to the next configuration.
+  unscheduleUpdate();
+  Director::getInstance()->replaceScene(create(config_ + 1));
+}
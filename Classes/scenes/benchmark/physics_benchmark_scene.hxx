@@ -0,0 +1,102 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __PHYSICS_BENCHMARK_SCENE_HXX__
+#define __PHYSICS_BENCHMARK_SCENE_HXX__
+
+/**
+ * Physics Benchmark Maze. Rooms of 3 x 3 tiles, walled in with a door in the middle of every wall.
+ */
+#define __PHYSICS_BENCHMARK_MAZE_SIZE__ 32
+#define __PHYSICS_BENCHMARK_TILE_SIZE__ 24.0f
+#define __PHYSICS_BENCHMARK_ACTORS__ 300
+
+/**
+ * Physics Benchmark Timing. Number of steps each configuration is measured for.
+ */
+#define __PHYSICS_BENCHMARK_FRAMES__ 300
+
+/**
+ * Physics Benchmark Configurations. Each configuration is a combination of these flags.
+ */
+#define __PHYSICS_BENCHMARK_SPATIAL_HASH__ 1
+#define __PHYSICS_BENCHMARK_SLEEPING__ 2
+#define __PHYSICS_BENCHMARK_CONTACT_ONLY__ 4
+#define __PHYSICS_BENCHMARK_CONFIGS__ 8
+
+/**
+ * Includes
+ */
+#include <chrono>
+#include "globals.hxx"
+
+/**
+ * Measures how long stepping the physics world takes with hundreds of walls and actors in a maze. Actors move
+ * from tile to tile with actions and wait in between, like the actors of a game scene. Every combination of
+ * the spatial hash, sleeping (with only moved bodies synced) and contact only mode is measured in turn, each
+ * in a fresh scene since the broadphase can't be switched back, and the average is logged before moving on.
+ * It doesn't need any assets, so it can be run in place of the game by defining __APP_DELEGATE_BENCHMARK__.
+ */
+class PhysicsBenchmarkScene : public Scene {
+  /**
+   * Constructor.
+   *
+   * @param config ~ Combination of the __PHYSICS_BENCHMARK_*__ flags to measure.
+   */
+  explicit PhysicsBenchmarkScene(int config);
+
+  /**
+   * Destructor.
+   */
+  virtual ~PhysicsBenchmarkScene();
+
+ public:
+  /**
+   * Creates the scene for a configuration.
+   *
+   * @param config ~ Combination of the __PHYSICS_BENCHMARK_*__ flags to measure.
+   *
+   * @returns ~ Autoreleased scene, or nullptr if it failed to initialize.
+   */
+  static PhysicsBenchmarkScene* create(int config = 0);
+
+  /**
+   * Steps the physics world by hand so only the step is timed, and moves on to the next configuration once
+   * enough steps have been measured.
+   *
+   * @param delta ~ 1 / framerate.
+   */
+  void update(float delta) override;
+
+ protected:
+  /**
+   * Sets up the physics world for the configuration and builds the maze.
+   */
+  bool initialize();
+
+  /**
+   * Adds a static body for every wall tile of the maze.
+   */
+  void initializeWalls();
+
+  /**
+   * Adds the actors to the rooms of the maze.
+   */
+  void initializeActors();
+
+  // Combination of the __PHYSICS_BENCHMARK_*__ flags being measured.
+  const int config_;
+
+  // Steps measured so far.
+  int frames_;
+
+  // Contacts that began while measuring.
+  int contacts_;
+
+  // Time spent stepping the physics world.
+  chrono::steady_clock::duration step_time_;
+
+ private:
+  __DISALLOW_COPY_AND_ASSIGN__(PhysicsBenchmarkScene)
+};
+
+#endif  // __PHYSICS_BENCHMARK_SCENE_HXX__
@@ -0,0 +1,92 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "render_benchmark_scene.hxx"
+
+RenderBenchmarkScene::RenderBenchmarkScene()
+    : pages_(nullptr),
+      mode_(0),
+      frames_(0),
+      visit_time_(chrono::steady_clock::duration::zero()),
+      render_time_(chrono::steady_clock::duration::zero()) {}
+
+RenderBenchmarkScene::~RenderBenchmarkScene() = default;
+
+bool RenderBenchmarkScene::init() {
+  if (not Scene::init()) return false;
+
+  pages_ = Layout::create();
+  pages_->setPosition(Globals::getOrigin());
+  addChild(pages_);
+
+  // Pages are Layouts laid out in a 4 column grid, like the panels of a PageView, so they are visited the way
+  // the pages of the game are.
+  const auto size = Globals::getVisibleSize();
+  const auto page_size = Size(size.width / 4, size.height / ((__RENDER_BENCHMARK_PAGES__ + 3) / 4));
+  for (auto i = 0; i < __RENDER_BENCHMARK_PAGES__; i++) {
+    const auto page = Layout::create();
+    page->setContentSize(page_size);
+    page->setPosition(Vec2(page_size.width * (i % 4), page_size.height * (i / 4)));
+    pages_->addChild(page);
+
+    // Sprites without a texture use the built in white texture, so nothing has to be loaded.
+    for (auto j = 0; j < __RENDER_BENCHMARK_SPRITES__; j++) {
+      const auto sprite = Sprite::create();
+      sprite->setTextureRect(Rect(0, 0, 6, 6));
+      sprite->setColor(Color3B(uint8_t(j * 5), uint8_t(i * 16), uint8_t(255 - j)));
+      sprite->setPosition(page_size.width * (j % 16 + 0.5f) / 16, page_size.height * (j / 16 + 0.5f) / 16);
+      page->addChild(sprite);
+      sprites_.emplace_back(sprite);
+    }
+
+    // Particles draw from the index buffer QuadCommand shares between threads.
+    const auto particles = ParticleGalaxy::createWithTotalParticles(__RENDER_BENCHMARK_PARTICLES__);
+    particles->setPosition(page_size.width / 2, page_size.height / 2);
+    page->addChild(particles);
+  }
+
+  scheduleUpdate();
+  return true;
+}
+
+void RenderBenchmarkScene::visit(Renderer* renderer, const Mat4& parent_transform,
+                                 const uint32_t parent_flags) {
+  const auto start = chrono::steady_clock::now();
+  Scene::visit(renderer, parent_transform, parent_flags);
+  visit_time_ += chrono::steady_clock::now() - start;
+}
+
+void RenderBenchmarkScene::render(Renderer* renderer, const Mat4* eye_transforms, const Mat4* eye_projections,
+                                  const unsigned int multi_view_count) {
+  const auto start = chrono::steady_clock::now();
+  Scene::render(renderer, eye_transforms, eye_projections, multi_view_count);
+  render_time_ += chrono::steady_clock::now() - start;
+}
+
+void RenderBenchmarkScene::onExit() {
+  Director::getInstance()->getRenderer()->setBatchedTransform(true);
+  Scene::onExit();
+}
+
+void RenderBenchmarkScene::update(const float delta) {
+  Scene::update(delta);
+  for (const auto& sprite : sprites_) sprite->setRotation(sprite->getRotation() + 90 * delta);
+
+  if (++frames_ < __RENDER_BENCHMARK_FRAMES__) return;
+
+  CCLOG("RenderBenchmarkScene: %s visit, %s transform of %d sprites: visit %.3f ms, render %.3f ms, "
+        "%.0f sprites per ms",
+        mode_ & __RENDER_BENCHMARK_CONCURRENT__ ? "Concurrent" : "Serial",
+        mode_ & __RENDER_BENCHMARK_PER_VERTEX__ ? "per vertex" : "batched", int(sprites_.size()),
+        chrono::duration<double, milli>(visit_time_).count() / frames_,
+        chrono::duration<double, milli>(render_time_).count() / frames_,
+        sprites_.size() * frames_ / chrono::duration<double, milli>(render_time_).count());
+
+  // Switch modes and start measuring again.
+  mode_ = (mode_ + 1) % __RENDER_BENCHMARK_MODES__;
+  pages_->setConcurrentVisitEnabled(mode_ & __RENDER_BENCHMARK_CONCURRENT__);
+  Director::getInstance()->getRenderer()->setBatchedTransform(not(mode_ & __RENDER_BENCHMARK_PER_VERTEX__));
+  frames_ = 0;
+  visit_time_ = chrono::steady_clock::duration::zero();
+  render_time_ = chrono::steady_clock::duration::zero();
+}
@@ -0,0 +1,114 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __RENDER_BENCHMARK_SCENE_HXX__
+#define __RENDER_BENCHMARK_SCENE_HXX__
+
+/**
+ * Render Benchmark Layout
+ */
+#define __RENDER_BENCHMARK_PAGES__ 16
+#define __RENDER_BENCHMARK_SPRITES__ 256
+#define __RENDER_BENCHMARK_PARTICLES__ 64
+
+/**
+ * Render Benchmark Timing. Number of frames each mode is measured for before switching.
+ */
+#define __RENDER_BENCHMARK_FRAMES__ 300
+
+/**
+ * Render Benchmark Modes. The first bit visits the pages concurrently, the second transforms vertices one at
+ * a time instead of through the batched SIMD kernels.
+ */
+#define __RENDER_BENCHMARK_MODES__ 4
+#define __RENDER_BENCHMARK_CONCURRENT__ 1
+#define __RENDER_BENCHMARK_PER_VERTEX__ 2
+
+/**
+ * Includes
+ */
+#include <chrono>
+#include "globals.hxx"
+#include "ui/CocosGUI.h"
+
+using namespace ui;
+
+/**
+ * Measures how long visiting and rendering the scene graph take with thousands of moving sprites, going
+ * through every mode every __RENDER_BENCHMARK_FRAMES__ frames: serial or concurrent visits, with the vertices
+ * of each command transformed in one SIMD batch or one at a time. The averages and the sprites rendered per
+ * millisecond are logged each time the mode switches. It doesn't need any assets, so it can be run in place
+ * of the game by defining __APP_DELEGATE_BENCHMARK__.
+ */
+class RenderBenchmarkScene : public Scene {
+ public:
+  /**
+   * Constructor.
+   */
+  explicit RenderBenchmarkScene();
+
+  /**
+   * Destructor.
+   */
+  virtual ~RenderBenchmarkScene();
+
+  /**
+   * @link Scene::init
+   */
+  bool init() override;
+
+  /**
+   * Times the visit of the scene graph, which is where the render commands are built.
+   *
+   * @link Node::visit
+   */
+  void visit(Renderer* renderer, const Mat4& parent_transform, uint32_t parent_flags) override;
+
+  /**
+   * Times the whole render, which is the visit plus filling and drawing the batched vertices.
+   *
+   * @link Scene::render
+   */
+  void render(Renderer* renderer, const Mat4* eye_transforms, const Mat4* eye_projections,
+              unsigned int multi_view_count) override;
+
+  /**
+   * Transforms vertices in batches again, so the game isn't left with the slower path.
+   *
+   * @link Node::onExit
+   */
+  void onExit() override;
+
+  /**
+   * Rotates every sprite so every transform is dirty, and switches the visit mode once enough frames have
+   * been measured.
+   *
+   * @param delta ~ 1 / framerate.
+   */
+  void update(float delta) override;
+
+  // Create function
+  CREATE_FUNC(RenderBenchmarkScene)
+
+ protected:
+  // Parent of every page, like the inner container of a PageView. Its children are what gets visited
+  // concurrently.
+  Layout* pages_;
+
+  // Every sprite in every page.
+  vector<Sprite*> sprites_;
+
+  // Mode currently measured, see __RENDER_BENCHMARK_MODES__.
+  int mode_;
+
+  // Frames measured in the current mode.
+  int frames_;
+
+  // Time spent visiting, and visiting and rendering, in the current mode.
+  chrono::steady_clock::duration visit_time_;
+  chrono::steady_clock::duration render_time_;
+
+ private:
+  __DISALLOW_COPY_AND_ASSIGN__(RenderBenchmarkScene)
+};
+
+#endif  // __RENDER_BENCHMARK_SCENE_HXX__
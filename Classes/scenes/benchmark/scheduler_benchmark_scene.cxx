@@ -0,0 +1,54 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "scheduler_benchmark_scene.hxx"
+
+SchedulerBenchmarkScene::SchedulerBenchmarkScene() : targets_(__SCHEDULER_BENCHMARK_TIMERS__), fired_(0) {}
+
+SchedulerBenchmarkScene::~SchedulerBenchmarkScene() = default;
+
+bool SchedulerBenchmarkScene::init() {
+  if (not Scene::init()) return false;
+  scheduleUpdate();
+  return true;
+}
+
+void SchedulerBenchmarkScene::update(const float delta) {
+  Scene::update(delta);
+  unscheduleUpdate();
+
+  const auto scheduler = new (nothrow) Scheduler();
+  if (scheduler == nullptr) return;
+
+  const auto callback = [this](float) { fired_++; };
+  auto schedule_time = chrono::steady_clock::duration::zero();
+  auto update_time = chrono::steady_clock::duration::zero();
+  auto unschedule_time = chrono::steady_clock::duration::zero();
+  for (auto round = 0; round < __SCHEDULER_BENCHMARK_ROUNDS__; round++) {
+    fired_ = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (auto i = 0; i < __SCHEDULER_BENCHMARK_TIMERS__; i++) {
+      const auto interval = i % __SCHEDULER_BENCHMARK_EVERY_FRAME__ == 0 ? 0 : 0.5f + (i % 7) * 0.25f;
+      scheduler->schedule(callback, &targets_[i], interval, false, __SCHEDULER_BENCHMARK_KEY__);
+    }
+    schedule_time += chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (auto frame = 0; frame < __SCHEDULER_BENCHMARK_FRAMES__; frame++) scheduler->update(1 / 60.0f);
+    update_time += chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (auto i = 0; i < __SCHEDULER_BENCHMARK_TIMERS__; i++)
+      scheduler->unschedule(__SCHEDULER_BENCHMARK_KEY__, &targets_[i]);
+    unschedule_time += chrono::steady_clock::now() - start;
+  }
+  scheduler->release();
+
+  CCLOG("SchedulerBenchmarkScene: %d timers: schedule %.3f ms, frame %.3f ms (%d fired), unschedule %.3f ms",
+        __SCHEDULER_BENCHMARK_TIMERS__,
+        chrono::duration<double, milli>(schedule_time).count() / __SCHEDULER_BENCHMARK_ROUNDS__,
+        chrono::duration<double, milli>(update_time).count() /
+            (__SCHEDULER_BENCHMARK_ROUNDS__ * __SCHEDULER_BENCHMARK_FRAMES__),
+        fired_, chrono::duration<double, milli>(unschedule_time).count() / __SCHEDULER_BENCHMARK_ROUNDS__);
+}
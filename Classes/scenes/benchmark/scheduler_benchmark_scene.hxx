@@ -0,0 +1,71 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __SCHEDULER_BENCHMARK_SCENE_HXX__
+#define __SCHEDULER_BENCHMARK_SCENE_HXX__
+
+/**
+ * Scheduler Benchmark Timers. Every __SCHEDULER_BENCHMARK_EVERY_FRAME__th timer fires every frame, the rest
+ * wait between half a second and 2 seconds, like the timeouts and delays of a scene.
+ */
+#define __SCHEDULER_BENCHMARK_TIMERS__ 10000
+#define __SCHEDULER_BENCHMARK_EVERY_FRAME__ 10
+#define __SCHEDULER_BENCHMARK_KEY__ "benchmark"
+
+/**
+ * Scheduler Benchmark Timing. Each round schedules every timer, steps the scheduler for
+ * __SCHEDULER_BENCHMARK_FRAMES__ frames and unschedules every timer again.
+ */
+#define __SCHEDULER_BENCHMARK_ROUNDS__ 10
+#define __SCHEDULER_BENCHMARK_FRAMES__ 600
+
+/**
+ * Includes
+ */
+#include <chrono>
+#include "globals.hxx"
+
+/**
+ * Measures what __SCHEDULER_BENCHMARK_TIMERS__ timers cost a Scheduler of their own, so nothing else the
+ * Director schedules is timed. Scheduling every timer, a frame of the scheduler and unscheduling every timer
+ * are timed separately and averaged over every round, and logged once on the first frame. It doesn't need any
+ * assets, so it can be run in place of the game by defining __APP_DELEGATE_BENCHMARK__.
+ */
+class SchedulerBenchmarkScene : public Scene {
+ public:
+  /**
+   * Constructor.
+   */
+  explicit SchedulerBenchmarkScene();
+
+  /**
+   * Destructor.
+   */
+  virtual ~SchedulerBenchmarkScene();
+
+  /**
+   * @link Scene::init
+   */
+  bool init() override;
+
+  /**
+   * Runs the benchmark on the first frame, once the scene is on screen.
+   *
+   * @param delta ~ 1 / framerate.
+   */
+  void update(float delta) override;
+
+  // Create function
+  CREATE_FUNC(SchedulerBenchmarkScene)
+
+ protected:
+  // One target per timer, like nodes that each schedule a timer of their own.
+  vector<char> targets_;
+
+  // Times a timer fired in the last round.
+  int fired_;
+
+ private:
+  __DISALLOW_COPY_AND_ASSIGN__(SchedulerBenchmarkScene)
+};
+
+#endif  // __SCHEDULER_BENCHMARK_SCENE_HXX__
@@ -6,10 +6,60 @@
 #include "entities/llumas/base_lluma.hxx"
 #include "entities/llurkers/base_llurker.hxx"
 
-BaseGameScene::BaseGameScene(const ValueMap& params, BackgroundLayer* bg) : BaseScene(params, bg) {}
+BaseGameScene::BaseGameScene(const ValueMap& params, BackgroundLayer* bg)
+    : BaseScene(params, bg), random_(seed(*params_)) {}
 
 BaseGameScene::~BaseGameScene() = default;
 
+uint32_t BaseGameScene::seed(ValueMap& params) {
+  const auto itr = params.find(__SEED__);
+  if (itr not_eq params.end()) return uint32_t(itr->second.asInt());
+
+  // Params only hold signed ints, so the seed is stored with the same bits as a signed int.
+  const auto seed = RandomObject::generateSeed();
+  params.emplace(__SEED__, int(seed));
+  return seed;
+}
+
+void BaseGameScene::onExit() {
+  // Leaving the game for any reason means there is nothing left to resume.
+  SnapshotUtils::clear();
+  BaseScene::onExit();
+
+  // Maps and entities load textures outside of the scene group, which nothing else would ever evict.
+  AssetEngine::getInstance()->sweep();
+}
+
+void BaseGameScene::saveSnapshot() const {
+  if (player_ == nullptr or params_ == nullptr or script_ == nullptr) return;
+
+  GameSnapshot snapshot;
+  snapshot.scene = getSceneType();
+  snapshot.mode = params_->at(__MODE__).asInt();
+  snapshot.map = map_->getName();
+  snapshot.chunked = chunk_map_ not_eq nullptr;
+  snapshot.params = *params_;
+  snapshot.random = random_.getState();
+
+  // Triggered events are erased from the script, so whatever is left is the position in the script.
+  if (script_->find(__EVENTS__) not_eq script_->end())
+    for (const auto& event : script_->at(__EVENTS__).asValueMap()) snapshot.events.emplace_back(event.first);
+
+  snapshot.player = player_->getSnapshot();
+  for (const auto& llurker : llurkers_) snapshot.llurkers.emplace_back(llurker->getSnapshot());
+  SnapshotUtils::save(snapshot);
+}
+
+void BaseGameScene::resume(const GameSnapshot& snapshot) {
+  // The scene is usually still loading its texture, in which case the snapshot is restored once it is done.
+  if (player_ == nullptr) {
+    snapshot_ = make_unique<GameSnapshot>(snapshot);
+    return;
+  }
+
+  if (not restore(snapshot)) __CCLOGWITHFUNCTION("Snapshot is for another map: %s", snapshot.map.c_str());
+}
+
 void BaseGameScene::beforeInitialized() {
   
 }
@@ -21,9 +71,21 @@ bool BaseGameScene::onInitialized() {
            "BaseGameScene: TiledMap must be initialize before BaseGameScene::onInitialized() is called...");
 
   // Setup Physics on the scene.
-  getPhysicsWorld()->setGravity(Vec2::ZERO);
+  const auto physics_world = getPhysicsWorld();
+  physics_world->setGravity(Vec2::ZERO);
+
+  // Actors are about a tile in size, so the broadphase hashes tile sized cells, and actors that are standing
+  // still are left asleep instead of being synced every frame. Chunked maps can be huge, but only hold a few
+  // hundred actors, so the hash doesn't grow past that.
+  const auto map_size = map_->getMapSize();
+  physics_world->setContactOnly(isContactOnly());
+  physics_world->useSpatialHash(map_->getTileSize().width,
+                                min(int(map_size.width * map_size.height), __PHYSICS_SPATIAL_HASH_CELLS__));
+  physics_world->setSyncOnlyMovedBodies(true);
+  physics_world->setSleepTimeThreshold(__PHYSICS_SLEEP_THRESHOLD__);
+
 #ifdef COCOS2D_DEBUG
-  getPhysicsWorld()->setDebugDrawMask(0xffff);
+  physics_world->setDebugDrawMask(0xffff);
 #endif
 
   // Initialize loading layer.
@@ -53,21 +115,39 @@ bool BaseGameScene::onInitialized() {
   follow_action->setTag(__FOLLOW_TAG__);
   main_layer_->runAction(follow_action);
 
+  // Put the game back where it was if it is being resumed.
+  if (snapshot_ not_eq nullptr) {
+    if (not restore(*snapshot_))
+      __CCLOGWITHFUNCTION("Snapshot is for another map: %s", snapshot_->map.c_str());
+    snapshot_.reset();
+  }
+
   // Base initialization successful.
   return true;
 }
 
 void BaseGameScene::update(const float delta) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "BaseGameScene::update");
+
   // Continue to update the BaseScene.
   BaseScene::update(delta);
 
   if (player_ == nullptr) return;
   player_->updateEntity();
+
+  // Stream in chunks around the player and evict the ones left behind.
+  if (chunk_map_ not_eq nullptr) chunk_map_->focus(player_->getCurrentPoint());
+
   for_each(llurkers_.begin(), llurkers_.end(), [](BaseLlurker* llurker) { llurker->updateEntity(); });
 }
 
 void BaseGameScene::initializeMap(const string& path, const string& name) {
+  // Maps too large to load at once are split into chunks by xTmx/chunk_tmx.py and streamed instead.
+  if (ArchiveUtils::contains(path + name + "/" + __TMX_CHUNK_MANIFEST__))
+    return initializeChunkedMap(path, name);
+
   // Initialize the tile map and all of the things with it.
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "BaseGameScene::initializeMap");
   const auto tmx = string(path + name + ".tmx");
   map_ = TMXTiledMap::createWithXML(ArchiveUtils::loadString(tmx), string());
 
@@ -82,6 +162,65 @@ void BaseGameScene::initializeMap(const string& path, const string& name) {
   main_layer_->addChild(map_, 0);
 }
 
+void BaseGameScene::initializeChunkedMap(const string& path, const string& name) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "BaseGameScene::initializeChunkedMap");
+
+  // Initialize the chunked map from its manifest. No chunks are resident yet.
+  const auto directory = string(path + name + "/");
+  chunk_map_ = TmxChunkMap::create(directory);
+  CCASSERT(chunk_map_ not_eq nullptr, string("BaseGameScene: Invalid chunked map " + directory).c_str());
+  map_ = chunk_map_;
+
+  // Set up TileMap setting
+  map_->setName(directory);
+  map_->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+  map_->setPosition(Globals::getScreenPosition());
+  map_->setCascadeOpacityEnabled(true);
+
+  // Invoke the TmxEngine to create an empty TmxObject for the map, then block on the chunks around the spawn
+  // so the player and llurkers have tiles to be placed on.
+  TmxEngine::getInstance()->cache(chunk_map_, Modes(params_->at(__MODE__).asInt()));
+  chunk_map_->focus(chunk_map_->getSpawnPoint(), false);
+  main_layer_->addChild(map_, 0);
+}
+
+bool BaseGameScene::isContactOnly() const { return false; }
+
+bool BaseGameScene::restore(const GameSnapshot& snapshot) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "BaseGameScene::restore");
+  const auto chunked = chunk_map_ not_eq nullptr;
+  if (snapshot.map not_eq map_->getName() or snapshot.chunked not_eq chunked) return false;
+
+  // Chunks around the player have to be resident before anything is placed on them.
+  if (chunk_map_ not_eq nullptr) chunk_map_->focus(snapshot.player.point, false);
+
+  // Drop the events that had already been triggered.
+  if (script_->find(__EVENTS__) not_eq script_->end()) {
+    auto& events = script_->at(__EVENTS__).asValueMap();
+    for (auto itr = events.begin(); itr not_eq events.end();) {
+      if (find(snapshot.events.begin(), snapshot.events.end(), itr->first) == snapshot.events.end())
+        itr = events.erase(itr);
+      else
+        ++itr;
+    }
+  }
+
+  player_->restoreSnapshot(snapshot.player);
+
+  // Llurkers are recreated in the order they were saved so they stack the same way.
+  auto z_order = 10;
+  for (const auto& saved : snapshot.llurkers) {
+    const auto llurker = BaseLlurker::createLlurker(this, Llurkers(saved.type), saved.tmx_layer);
+    if (llurker == nullptr) continue;
+    llurker->restoreSnapshot(saved);
+    llurkers_.emplace_back(llurker);
+    main_layer_->addChild(llurker, z_order++);
+  }
+
+  random_.setState(snapshot.random);
+  return true;
+}
+
 void BaseGameScene::initializeCollisionDetection() {
   auto contact_listener = EventListenerPhysicsContact::create();
   contact_listener->onContactBegin = [=](PhysicsContact& contact) -> bool {
@@ -7,7 +7,10 @@
  * Includes
  */
 #include "gestures/swipe/swipe_gesture.hxx"
+#include "objects/random/random_object.hxx"
+#include "objects/tmx/tmx_chunk_map.hxx"
 #include "scenes/base_scene.hxx"
+#include "utils/snapshot/snapshot_utils.hxx"
 
 /**
  * Tags
@@ -35,6 +38,21 @@ class BaseGameScene : public BaseScene {
   friend BaseLluma;
   friend BaseLlurker;
 
+ public:
+  /**
+   * Captures the state of the game and writes it with SnapshotUtils::save() so the player can be put
+   * straight back into the game if the OS kills the app. Does nothing until the player has been placed.
+   */
+  void saveSnapshot() const;
+
+  /**
+   * Puts the game back in the state of a snapshot. If the scene is still loading, the snapshot is kept and
+   * restored at the end of BaseGameScene::onInitialized().
+   *
+   * @param snapshot ~ Snapshot loaded with SnapshotUtils::load().
+   */
+  void resume(const GameSnapshot& snapshot);
+
  protected:
   /**
    * Constructor.
@@ -48,6 +66,11 @@ class BaseGameScene : public BaseScene {
    * Destructor.
    */
   virtual ~BaseGameScene();
+
+  /**
+   * @see BaseScene::onExit()
+   */
+  void onExit() override;
   
   /**
    * @see BaseScene::beforeInitialize()
@@ -112,13 +135,49 @@ class BaseGameScene : public BaseScene {
   virtual void finish(Scenes scene, CallFunc* function) = 0;
 
   /**
-   * Initializes a TMXTiledMap.
+   * Gets the value used by SceneUtils to recreate this scene.
+   *
+   * @note ~ Required by all children since it is a pure virtual function
+   */
+  virtual Scenes getSceneType() const = 0;
+
+  /**
+   * Whether the physics world only reports contacts and leaves collisions unsolved. Scenes that move every
+   * body with actions and only need to know who touched who can opt in by overriding this.
+   *
+   * @returns ~ false unless overridden.
+   */
+  virtual bool isContactOnly() const;
+
+  /**
+   * Puts the map, script and entities back in the state captured by BaseGameScene::saveSnapshot(). Called
+   * by BaseGameScene::resume() once the scene is initialized.
+   *
+   * @param snapshot ~ Snapshot loaded from SnapshotUtils.
+   *
+   * @returns ~ false if the snapshot doesn't belong to the map of this scene and was ignored.
+   */
+  virtual bool restore(const GameSnapshot& snapshot);
+
+  /**
+   * Initializes a TMXTiledMap. If the archive holds a chunked map directory by this name instead, the map is
+   * streamed with BaseGameScene::initializeChunkedMap().
    *
    * @param path ~ The paths to the tmx file in the archive.
    * @param name ~ The name of the tmx file.
    */
   virtual void initializeMap(const string& path, const string& name);
 
+  /**
+   * Initializes a chunked TMXTiledMap. Only the chunks around the player are resident; they are streamed in
+   * on a worker thread and evicted as the player moves. The chunks around the spawn point are loaded before
+   * this returns.
+   *
+   * @param path ~ The paths to the chunked map directory in the archive.
+   * @param name ~ The name of the chunked map directory.
+   */
+  virtual void initializeChunkedMap(const string& path, const string& name);
+
   /**
    * Initialize the collisition detector for physics object on the game scene (llumas)
    */
@@ -143,6 +202,9 @@ class BaseGameScene : public BaseScene {
   // The TMX Tiled Map that for the game.
   TMXTiledMap* map_{};
 
+  // The same map as `map_` when the scene uses a chunked map, otherwise nullptr.
+  TmxChunkMap* chunk_map_{};
+
   // Displays the info and objective of the current level. This is only in the beginning of the level.
   LayerColor* loading_layer_{};
 
@@ -159,7 +221,21 @@ class BaseGameScene : public BaseScene {
   // A Swipe Listener that is responsible for detected all swipes on the screen
   SwipeGesture* swipe_gesture_{};
 
+  // Snapshot to restore once the scene is initialized. Only set when resuming.
+  unique_ptr<GameSnapshot> snapshot_;
+
+  // Generator for everything random in the game. Seeded from the `__SEED__` param, which is generated when
+  // the scene is first created and kept in the params so a resumed or replayed run draws the same values.
+  RandomObject random_;
+
  private:
+  /**
+   * Gets the seed of the run from `params`, generating one and adding it to `params` if there isn't one.
+   *
+   * @param params ~ Params of the scene.
+   */
+  static uint32_t seed(ValueMap& params);
+
   /**
    * __DISALLOW_COPY_AND_ASSIGN__
    */
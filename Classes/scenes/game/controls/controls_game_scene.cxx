@@ -15,7 +15,8 @@ ControlsGameScene::ControlsGameScene(const ValueMap& params, BackgroundLayer* bg
 ControlsGameScene::~ControlsGameScene() = default;
 
 void ControlsGameScene::beforeInitialized() {
-  
+  // The exit appears mid-tutorial, so create it while the scene is still loading.
+  ParticleUtils::prewarm(__PARTICLE_EXIT__);
 }
 
 bool ControlsGameScene::onInitialized() {
@@ -131,6 +132,37 @@ void ControlsGameScene::finish(const Scenes scene, CallFunc* function) {
        CallFunc::create([=]() -> void { SceneUtils::replaceScene(scene, background_layer_); })}));
 }
 
+Scenes ControlsGameScene::getSceneType() const { return CONTROLS; }
+
+bool ControlsGameScene::restore(const GameSnapshot& snapshot) {
+  // Look up the exit event before the base restore erases it since its particle has to be put back.
+  auto exit = Vec2(-1, -1);
+  if (script_->find(__EVENTS__) not_eq script_->end()) {
+    const auto& events = script_->at(__EVENTS__).asValueMap();
+    const auto itr = events.find(__CONTROLS_EVENT_EXIT__);
+    if (itr not_eq events.end() and
+        find(snapshot.events.begin(), snapshot.events.end(), itr->first) == snapshot.events.end()) {
+      const auto& event_params = itr->second.asValueMap();
+      Globals::assertValueMap(event_params, {__POSX__, __POSY__});
+      const auto point = Point(event_params.at(__POSX__).asInt(), event_params.at(__POSY__).asInt());
+      exit = tmx_object_ui_->getPosition(point, __CONTROLS_LAYER_TWO__);
+    }
+  }
+
+  if (not BaseGameScene::restore(snapshot)) return false;
+
+  if (exit not_eq Vec2(-1, -1))
+    main_layer_->addChild(ParticleUtils::load(__PARTICLE_EXIT__, exit.x, exit.y, true), 10, __EXIT__);
+
+  // The player only ever reaches the second layer after the layers have been swapped.
+  if (player_->getCurrentTmxLayer() == __CONTROLS_LAYER_TWO__) {
+    map_->getLayer(__CONTROLS_LAYER_ONE__)->setOpacity(0);
+    map_->getLayer(__CONTROLS_LAYER_TWO__)->setOpacity(255);
+  }
+
+  return true;
+}
+
 bool ControlsGameScene::onTutorialEvent(const string& event) {
   if (script_->find(__EVENTS__) == script_->end()) return true;
 
@@ -138,6 +138,16 @@ class ControlsGameScene : public BaseGameScene {
    */
   void finish(Scenes scene, CallFunc* function) override;
 
+  /**
+   * @see BaseGameScene::getSceneType()
+   */
+  Scenes getSceneType() const override;
+
+  /**
+   * @see BaseGameScene::restore()
+   */
+  bool restore(const GameSnapshot& snapshot) override;
+
   /**
    * Triggers a tutorial event the reads from the script to display instructions for the player.
    *
@@ -2,9 +2,16 @@
 
 // Includes
 #include "levels_scene.hxx"
+#include "engines/language/language_engine.hxx"
 
 LevelsScene::LevelsScene(const ValueMap& params, BackgroundLayer* bg)
-    : BaseScene(params, bg), mode_(Modes(params.at(__MODE__).asInt())) {}
+    : BaseScene(params, bg),
+      mode_(Modes(params.at(__MODE__).asInt())),
+      mode_icon_(nullptr),
+      trial_(params.find(__TRIAL__) not_eq params.end() ? params.at(__TRIAL__).asInt() : 0) {
+  // Initialize levels data
+  levels_config_ = ArchiveUtils::loadValueMap(__LEVELS_CONFIG__);
+}
 
 LevelsScene::~LevelsScene() = default;
 
@@ -31,6 +38,7 @@ bool LevelsScene::onInitialized() {
 
   // Initialize
   initSprites();
+  initProgress();
 
   // Schedule our load function which will orchestrate this intro sequence
   schedule(schedule_selector(LevelsScene::monitor), 0.5f);
@@ -48,6 +56,23 @@ void LevelsScene::initSprites() {
   main_layer_->addChild(mode_icon_, 10);
 }
 
+void LevelsScene::initProgress() {
+  // The totals are kept up to date by the database, so the cost of this doesn't grow with the number of
+  // levels.
+  totals_ = DataUtils::getTrialTotals(trial_);
+
+  // Display the stars earned out of the stars available on the completed levels.
+  const auto font = LanguageEngine::getInstance()->getFontPath() + TextManager::getFont(LIGHT);
+  const auto text = StringUtils::format("%d / %d", totals_.at(__STARS__).asInt(),
+                                        totals_.at(__COMPLETED__).asInt() * getCurrentModeMaxStars());
+  const auto label = Label::createWithTTF(text, font, __LEVELS_PROGRESS_SIZE__ * 4);
+  label->setName(__LEVELS_PROGRESS_TAG__);
+  label->setPosition(Globals::getScreenPosition(2, 4));
+  label->setScale(0.25f);
+  label->setCascadeOpacityEnabled(true);
+  main_layer_->addChild(label, 10);
+}
+
 Sprite* LevelsScene::getCurrentModeIcon() {
   // From params, we should load the correct icon for mode from the __MODE__ param
   switch (mode_) {
@@ -64,8 +89,46 @@ Sprite* LevelsScene::getCurrentModeIcon() {
     case TILES:
       return sprite_manager_->findSprite(__LEVELS_TILES_ICON__);
     default:
-      throw runtime_error("LevelsScene: Could not find tis mode...");
+      throw runtime_error("LevelsScene: Could not find this mode...");
+  }
+}
+
+int LevelsScene::getCurrentModeMaxStars() const {
+  // From params, we should load the config for the mode from the __MODE__ param
+  string key;
+  switch (mode_) {
+    case ESACPE:
+      key = __LEVELS_ESCAPE_CONFIG__;
+      break;
+    case ENERGY:
+      key = __LEVELS_ENERGY_CONFIG__;
+      break;
+    case SEARCH:
+      key = __LEVELS_SEARCH_CONFIG__;
+      break;
+    case SURVIVE:
+      key = __LEVELS_SURVIVE_CONFIG__;
+      break;
+    case PORTALS:
+      key = __LEVELS_PORTALS_CONFIG__;
+      break;
+    case TILES:
+      key = __LEVELS_TILES_CONFIG__;
+      break;
+    default:
+      throw runtime_error("LevelsScene: Could not find this mode...");
+  }
+
+  const auto itr = levels_config_.find(key);
+  if (itr == levels_config_.end()) {
+    __CCLOGWITHFUNCTION("No levels config for mode: %s", key.c_str());
+    return 0;
   }
+
+  // A threshold of 0 is where a level starts and doesn't award a star.
+  const auto& thresholds = itr->second.asValueMap().at(__STARS__).asValueVector();
+  return int(
+      count_if(thresholds.begin(), thresholds.end(), [](const Value& score) { return score.asInt() > 0; }));
 }
 
 void LevelsScene::monitor(float dt) {}
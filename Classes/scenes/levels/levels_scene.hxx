@@ -8,6 +8,17 @@
  */
 #define __LEVELS_SCENE__ "scenes/levels.plist"
 
+/**
+ * Levels Config
+ */
+#define __LEVELS_CONFIG__ "configs/levels.plist"
+#define __LEVELS_ESCAPE_CONFIG__ "escape"
+#define __LEVELS_ENERGY_CONFIG__ "energy"
+#define __LEVELS_SEARCH_CONFIG__ "search"
+#define __LEVELS_SURVIVE_CONFIG__ "survive"
+#define __LEVELS_PORTALS_CONFIG__ "portals"
+#define __LEVELS_TILES_CONFIG__ "tiles"
+
 /**
  * Levels Icons
  */
@@ -23,6 +34,12 @@
  */
 #define __LEVELS_MODE_ICON_ACTION__ "actions/levels_mode_intro.plist"
 
+/**
+ * Levels Progress
+ */
+#define __LEVELS_PROGRESS_TAG__ "levels_progress"
+#define __LEVELS_PROGRESS_SIZE__ 24
+
 /**
  * Includes
  */
@@ -68,6 +85,11 @@ class LevelsScene : public BaseScene {
    */
   void initSprites();
 
+  /**
+   * Loads the aggregated totals of the trial and displays the star total.
+   */
+  void initProgress();
+
   /**
    * Loads the correct mode icon based on the current mode.
    *
@@ -75,6 +97,14 @@ class LevelsScene : public BaseScene {
    */
   Sprite* getCurrentModeIcon();
 
+  /**
+   * Finds the number of stars a single level can award in the current mode. A star is earned for every
+   * non-zero score threshold in the levels config that is reached.
+   *
+   * @return ~ Number of non-zero star thresholds for the mode, or 0 if the mode isn't in the config.
+   */
+  int getCurrentModeMaxStars() const;
+
   /**
    * Monitors the intro scene and wait for the animations to finish before deciding where to
    * go next.
@@ -89,6 +119,15 @@ class LevelsScene : public BaseScene {
   // Icon for te current mode
   Sprite* mode_icon_;
 
+  // The trial the levels belong to
+  const int trial_;
+
+  // Aggregated totals of the trial.
+  ValueMap totals_;
+
+  // Score thresholds and level counts of every mode.
+  ValueMap levels_config_;
+
  private:
   __DISALLOW_COPY_AND_ASSIGN__(LevelsScene)
 };
@@ -86,6 +86,9 @@ void ModesScene::initModesView() {
   for_each(modes_config_.begin(), modes_config_.end(),
            [&](const Value& data) { modes_view_->pushBackCustomItem(createModePanel(data.asValueMap())); });
 
+  // Pages don't depend on each other, so they are visited and turned into render commands concurrently.
+  modes_view_->getInnerContainer()->setConcurrentVisitEnabled(true);
+
   // Set the mode to the last mode the player ever clicked into.
   const auto index = DataUtils::getOtherData(__KEY_CURRENT_MODE__, 0);
   modes_view_->setCurrentPageIndex(index);
@@ -122,9 +125,11 @@ Layout* ModesScene::createModePanel(const ValueMap& data) const {
       // Save the currently selected page in the data base.
       DataUtils::saveOtherData(__KEY_CURRENT_MODE__, index);
 
-      // Transition to the next scene with params
+      // Transition to the next scene with params. Pages follow the order of the Modes enum and every mode
+      // holds a single trial, so the page index is both the mode and the trial.
       ValueMap params;
       params.emplace(__MODE__, index);
+      params.emplace(__TRIAL__, index);
       overlay_layer_->setLocalZOrder(998);
       overlay_layer_->runAction(
           ActionUtils::sequence({ActionUtils::fadeIn(0, 0.5f), CallFunc::create([=]() -> void {
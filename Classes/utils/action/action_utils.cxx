@@ -147,72 +147,64 @@ bool ActionUtils::isRunningAction(initializer_list<Node*> nodes) {
 }
 
 Action* ActionUtils::fadeInInternal(ValueMap props) {
-  return Sequence::createWithTwoActions(DelayTime::create(props.at(__DELAY__).asFloat()),
-                                        FadeIn::create(props.at(__DURATION__).asFloat()));
+  return TweenAction::create(TweenProperty::OPACITY, TweenCurve::LINEAR, props.at(__DELAY__).asFloat(),
+                             props.at(__DURATION__).asFloat(), Vec2(255, 0));
 }
 
 Action* ActionUtils::fadeOutInternal(ValueMap props) {
-  return Sequence::createWithTwoActions(DelayTime::create(props.at(__DELAY__).asFloat()),
-                                        FadeOut::create(props.at(__DURATION__).asFloat()));
+  return TweenAction::create(TweenProperty::OPACITY, TweenCurve::LINEAR, props.at(__DELAY__).asFloat(),
+                             props.at(__DURATION__).asFloat(), Vec2::ZERO);
 }
 
 Action* ActionUtils::fadeToInternal(ValueMap props) {
-  return Sequence::createWithTwoActions(
-      DelayTime::create(props.at(__DELAY__).asFloat()),
-      EaseInOut::create(
-          FadeTo::create(props.at(__DURATION__).asFloat(), GLubyte(props.at(__OPACITY__).asFloat())),
-          props.at(__RATE__).asFloat()));
+  const auto opacity = GLubyte(props.at(__OPACITY__).asFloat());
+  return TweenAction::create(TweenProperty::OPACITY, TweenCurve::EASE_IN_OUT, props.at(__DELAY__).asFloat(),
+                             props.at(__DURATION__).asFloat(), Vec2(opacity, 0),
+                             props.at(__RATE__).asFloat());
 }
 
 Action* ActionUtils::moveToInternal(ValueMap props) {
-  return MoveTo::create(
-      props.at(__DURATION__).asFloat(),
+  return TweenAction::create(
+      TweenProperty::POSITION, TweenCurve::LINEAR, 0, props.at(__DURATION__).asFloat(),
       Globals::getScreenPosition(props.at(__POSX__).asFloat(), props.at(__POSY__).asFloat()));
 }
 
 Action* ActionUtils::moveByInternal(ValueMap props) {
-  return MoveBy::create(props.at(__DURATION__).asFloat(),
-                        Vec2(props.at(__POSX__).asFloat(), props.at(__POSY__).asFloat()));
+  return TweenAction::create(TweenProperty::POSITION, TweenCurve::LINEAR, 0, props.at(__DURATION__).asFloat(),
+                             Vec2(props.at(__POSX__).asFloat(), props.at(__POSY__).asFloat()), 1, true);
 }
 
 Action* ActionUtils::rotateToInternal(ValueMap props) {
-  return Sequence::createWithTwoActions(
-      DelayTime::create(props.at(__DELAY__).asFloat()),
-      EaseInOut::create(RotateTo::create(props.at(__DURATION__).asFloat(), props.at(__DEGREE__).asFloat()),
-                        props.at(__RATE__).asFloat()));
+  return TweenAction::create(TweenProperty::ROTATION, TweenCurve::EASE_IN_OUT, props.at(__DELAY__).asFloat(),
+                             props.at(__DURATION__).asFloat(), Vec2(props.at(__DEGREE__).asFloat(), 0),
+                             props.at(__RATE__).asFloat());
 }
 
 Action* ActionUtils::rotateByInternal(ValueMap props) {
-  return Sequence::createWithTwoActions(
-      DelayTime::create(props.at(__DELAY__).asFloat()),
-      EaseInOut::create(RotateBy::create(props.at(__DURATION__).asFloat(), props.at(__DEGREE__).asFloat()),
-                        props.at(__RATE__).asFloat()));
+  return TweenAction::create(TweenProperty::ROTATION, TweenCurve::EASE_IN_OUT, props.at(__DELAY__).asFloat(),
+                             props.at(__DURATION__).asFloat(), Vec2(props.at(__DEGREE__).asFloat(), 0),
+                             props.at(__RATE__).asFloat(), true);
 }
 
-Action* ActionUtils::easeInInternal(ValueMap props) {
-  return Sequence::create(
-      DelayTime::create(props.at(__DELAY__).asFloat()),
-      EaseIn::create(dynamic_cast<MoveTo*>(moveToInternal(props)), props.at(__RATE__).asFloat()), nullptr);
-}
+Action* ActionUtils::easeInInternal(ValueMap props) { return easeMoveInternal(props, TweenCurve::EASE_IN); }
 
-Action* ActionUtils::easeOutInternal(ValueMap props) {
-  return Sequence::create(
-      DelayTime::create(props.at(__DELAY__).asFloat()),
-      EaseOut::create(dynamic_cast<MoveTo*>(moveToInternal(props)), props.at(__RATE__).asFloat()), nullptr);
-}
+Action* ActionUtils::easeOutInternal(ValueMap props) { return easeMoveInternal(props, TweenCurve::EASE_OUT); }
 
 Action* ActionUtils::easeInOutInternal(ValueMap props) {
-  return Sequence::create(
-      DelayTime::create(props.at(__DELAY__).asFloat()),
-      EaseInOut::create(dynamic_cast<MoveTo*>(moveToInternal(props)), props.at(__RATE__).asFloat()), nullptr);
+  return easeMoveInternal(props, TweenCurve::EASE_IN_OUT);
+}
+
+Action* ActionUtils::easeMoveInternal(ValueMap& props, const TweenCurve curve) {
+  return TweenAction::create(
+      TweenProperty::POSITION, curve, props.at(__DELAY__).asFloat(), props.at(__DURATION__).asFloat(),
+      Globals::getScreenPosition(props.at(__POSX__).asFloat(), props.at(__POSY__).asFloat()),
+      props.at(__RATE__).asFloat());
 }
 
 Action* ActionUtils::zoomInternal(ValueMap props) {
-  return Sequence::create(
-      DelayTime::create(props.at(__DELAY__).asFloat()),
-      EaseInOut::create(ScaleTo::create(props.at(__DURATION__).asFloat(), props.at(__SCALE__).asFloat()),
-                        props.at(__RATE__).asFloat()),
-      nullptr);
+  return TweenAction::create(TweenProperty::SCALE, TweenCurve::EASE_IN_OUT, props.at(__DELAY__).asFloat(),
+                             props.at(__DURATION__).asFloat(), Vec2(props.at(__SCALE__).asFloat(), 0),
+                             props.at(__RATE__).asFloat());
 }
 
 Action* ActionUtils::blinkInternal(ValueMap props) {
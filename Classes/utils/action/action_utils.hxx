@@ -7,6 +7,7 @@
  * Includes
  */
 #include "globals.hxx"
+#include "utils/action/tween_action.hxx"
 
 class ActionUtils {
  public:
@@ -103,6 +104,16 @@ class ActionUtils {
 
   static Action* zoomInternal(ValueMap props);
 
+  /**
+   * Shared implementation of the eased moves.
+   *
+   * @param props ~ properties needed to create action.
+   * @param curve ~ Ease curve of the move.
+   *
+   * @returns ~ New TweenAction.
+   */
+  static Action* easeMoveInternal(ValueMap& props, TweenCurve curve);
+
   static Action* blinkInternal(ValueMap props);
 
   static Action* sequenceInternal(ValueMap props);
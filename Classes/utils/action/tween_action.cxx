@@ -0,0 +1,247 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "tween_action.hxx"
+
+/**
+ * Same shortest turn RotateTo takes.
+ */
+static float shortestTurn(float from, const float to) {
+  from = fmodf(from, from > 0 ? 360.0f : -360.0f);
+  auto turn = to - from;
+  if (turn > 180) turn -= 360;
+  if (turn < -180) turn += 360;
+  return turn;
+}
+
+/**
+ * Eases the linear progress of a tween with the same functions the cocos2d-x ease actions use.
+ */
+static float ease(const TweenCurve curve, const float time, const float rate) {
+  switch (curve) {
+    case TweenCurve::EASE_IN:
+      return tweenfunc::easeIn(time, rate);
+    case TweenCurve::EASE_OUT:
+      return tweenfunc::easeOut(time, rate);
+    case TweenCurve::EASE_IN_OUT:
+      return tweenfunc::easeInOut(time, rate);
+    default:
+      return time;
+  }
+}
+
+TweenAction::TweenAction(const TweenProperty property, const TweenCurve curve, const float delay,
+                         const float duration, const Vec2& value, const float rate, const bool relative)
+    : property_(property),
+      curve_(curve),
+      delay_(delay),
+      tween_duration_(duration),
+      value_(value),
+      rate_(rate),
+      relative_(relative),
+      started_(false),
+      slot_(-1) {}
+
+TweenAction::~TweenAction() {
+  // Actions removed from the ActionManager are released without being stopped.
+  if (slot_ >= 0) TweenBatch::getInstance()->remove(slot_);
+}
+
+TweenAction* TweenAction::create(const TweenProperty property, const TweenCurve curve, const float delay,
+                                 const float duration, const Vec2& value, const float rate,
+                                 const bool relative) {
+  const auto action = new (nothrow) TweenAction(property, curve, delay, duration, value, rate, relative);
+  if (action and action->initWithDuration(delay + duration)) {
+    action->autorelease();
+    return action;
+  }
+
+  delete action;
+  return nullptr;
+}
+
+TweenAction* TweenAction::clone() const {
+  return create(property_, curve_, delay_, tween_duration_, value_, rate_, relative_);
+}
+
+TweenAction* TweenAction::reverse() const {
+  CCASSERT(relative_, "TweenAction: only relative tweens can be reversed...");
+
+  // Same as reversing EaseIn / EaseOut, which keep the curve and invert the rate.
+  const auto rate = curve_ == TweenCurve::EASE_IN or curve_ == TweenCurve::EASE_OUT ? 1 / rate_ : rate_;
+  return create(property_, curve_, delay_, tween_duration_, -value_, rate, relative_);
+}
+
+void TweenAction::startWithTarget(Node* target) {
+  ActionInterval::startWithTarget(target);
+
+  // RepeatForever restarts the same action without stopping it, so the slot may still be there with a value
+  // that hasn't been written back yet.
+  const auto batch = TweenBatch::getInstance();
+  if (slot_ < 0) {
+    slot_ = batch->add(this);
+  } else if (batch->dirty_[slot_]) {
+    batch->apply(size_t(slot_), ease(curve_, batch->progress_[slot_], rate_));
+    batch->targets_[slot_] = target;
+  }
+
+  started_ = false;
+}
+
+void TweenAction::update(const float time) {
+  const auto elapsed = time * _duration - delay_;
+  if (elapsed < 0 and time < 1) return;
+
+  const auto batch = TweenBatch::getInstance();
+  if (not started_) {
+    batch->begin(slot_);
+    started_ = true;
+  }
+
+  batch->progress_[slot_] = tween_duration_ > 0 ? clampf(elapsed / tween_duration_, 0, 1) : 1;
+  batch->dirty_[slot_] = 1;
+}
+
+void TweenAction::stop() {
+  if (slot_ >= 0) {
+    // The next action of a Sequence starts right away and reads the target, so it must have the last value.
+    const auto batch = TweenBatch::getInstance();
+    if (batch->dirty_[slot_]) batch->apply(size_t(slot_), ease(curve_, batch->progress_[slot_], rate_));
+    batch->remove(slot_);
+    slot_ = -1;
+  }
+
+  ActionInterval::stop();
+}
+
+TweenBatch::TweenBatch() {
+  // Same priority as the ActionManager, but scheduled after it, so tweens are written back in the same frame.
+  Director::getInstance()->getScheduler()->scheduleUpdate(this, Scheduler::PRIORITY_SYSTEM, false);
+}
+
+TweenBatch* TweenBatch::getInstance() {
+  // Actions only run on the main thread, so this doesn't need the guards of the engines.
+  static auto instance = new (nothrow) TweenBatch();
+  return instance;
+}
+
+void TweenBatch::update(float) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "TweenBatch::update");
+
+  const auto count = owners_.size();
+  for (auto i = 0u; i < count; i++) eased_[i] = ease(curves_[i], progress_[i], rates_[i]);
+
+  for (auto i = 0u; i < count; i++) {
+    if (dirty_[i]) apply(i, eased_[i]);
+  }
+}
+
+int TweenBatch::add(TweenAction* action) {
+  owners_.push_back(action);
+  targets_.push_back(action->getTarget());
+  properties_.push_back(action->property_);
+  curves_.push_back(action->curve_);
+  rates_.push_back(action->rate_);
+  progress_.push_back(0);
+  eased_.push_back(0);
+  dirty_.push_back(0);
+  from_.emplace_back();
+  delta_.emplace_back();
+  previous_.emplace_back();
+  return int(owners_.size() - 1);
+}
+
+void TweenBatch::remove(const int slot) {
+  const auto last = owners_.size() - 1;
+  if (size_t(slot) not_eq last) {
+    owners_[slot] = owners_[last];
+    targets_[slot] = targets_[last];
+    properties_[slot] = properties_[last];
+    curves_[slot] = curves_[last];
+    rates_[slot] = rates_[last];
+    progress_[slot] = progress_[last];
+    eased_[slot] = eased_[last];
+    dirty_[slot] = dirty_[last];
+    from_[slot] = from_[last];
+    delta_[slot] = delta_[last];
+    previous_[slot] = previous_[last];
+    owners_[slot]->slot_ = slot;
+  }
+
+  owners_.pop_back();
+  targets_.pop_back();
+  properties_.pop_back();
+  curves_.pop_back();
+  rates_.pop_back();
+  progress_.pop_back();
+  eased_.pop_back();
+  dirty_.pop_back();
+  from_.pop_back();
+  delta_.pop_back();
+  previous_.pop_back();
+}
+
+void TweenBatch::begin(const int slot) {
+  const auto action = owners_[slot];
+  const auto target = targets_[slot];
+
+  Vec2 from;
+  switch (properties_[slot]) {
+    case TweenProperty::OPACITY:
+      from.x = target->getOpacity();
+      break;
+    case TweenProperty::POSITION:
+      from = target->getPosition();
+      break;
+    case TweenProperty::SCALE:
+      from.set(target->getScaleX(), target->getScaleY());
+      break;
+    case TweenProperty::ROTATION:
+      from.x = target->getRotation();
+      break;
+  }
+
+  if (action->relative_ and properties_[slot] == TweenProperty::SCALE) {
+    // Like ScaleBy, relative scales multiply.
+    delta_[slot] = from * (action->value_.x - 1);
+  } else if (action->relative_) {
+    delta_[slot] = action->value_;
+  } else if (properties_[slot] == TweenProperty::SCALE) {
+    delta_[slot] = Vec2(action->value_.x, action->value_.x) - from;
+  } else if (properties_[slot] == TweenProperty::ROTATION) {
+    // RotateTo normalizes the start angle along with the turn.
+    delta_[slot].x = shortestTurn(from.x, action->value_.x);
+    from.x = fmodf(from.x, from.x > 0 ? 360.0f : -360.0f);
+  } else {
+    delta_[slot] = action->value_ - from;
+  }
+
+  from_[slot] = from;
+  previous_[slot] = from;
+}
+
+void TweenBatch::apply(const size_t slot, const float time) {
+  const auto target = targets_[slot];
+  dirty_[slot] = 0;
+
+  switch (properties_[slot]) {
+    case TweenProperty::OPACITY:
+      target->setOpacity(GLubyte(from_[slot].x + delta_[slot].x * time));
+      break;
+    case TweenProperty::POSITION: {
+#if CC_ENABLE_STACKABLE_ACTIONS
+      // Like MoveBy, movement made by other actions since the last write is added to the tween.
+      from_[slot] += target->getPosition() - previous_[slot];
+#endif
+      previous_[slot] = from_[slot] + delta_[slot] * time;
+      target->setPosition(previous_[slot]);
+      break;
+    }
+    case TweenProperty::SCALE:
+      target->setScale(from_[slot].x + delta_[slot].x * time, from_[slot].y + delta_[slot].y * time);
+      break;
+    case TweenProperty::ROTATION:
+      target->setRotation(from_[slot].x + delta_[slot].x * time);
+      break;
+  }
+}
@@ -0,0 +1,191 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __TWEEN_ACTION_HXX__
+#define __TWEEN_ACTION_HXX__
+
+/**
+ * Includes
+ */
+#include "globals.hxx"
+
+/**
+ * Node property driven by a TweenAction.
+ */
+enum class TweenProperty : uint8_t { OPACITY, POSITION, SCALE, ROTATION };
+
+/**
+ * Ease curve of a TweenAction. Matches the cocos2d-x EaseIn, EaseOut and EaseInOut actions.
+ */
+enum class TweenCurve : uint8_t { LINEAR, EASE_IN, EASE_OUT, EASE_IN_OUT };
+
+/**
+ * Flat replacement for Sequence(DelayTime, Ease(FadeTo / MoveTo / MoveBy / ScaleTo / RotateTo / RotateBy)).
+ * It is a regular action, so it can be run, stopped, sequenced and spawned like any other, but it doesn't
+ * touch its target: stepping it only records its progress in the TweenBatch, which eases and writes back
+ * every running tween in one pass after the ActionManager is done.
+ */
+class TweenAction : public ActionInterval {
+ public:
+  /**
+   * Creates a new tween.
+   *
+   * @param property ~ Property of the target to tween.
+   * @param curve    ~ Ease curve of the tween.
+   * @param delay    ~ Time to wait before the tween starts. The start value is read from the target then.
+   * @param duration ~ Duration of the tween, not counting `delay`.
+   * @param value    ~ Value to tween to, or by if `relative`. Opacity, scale and rotation only use x.
+   * @param rate     ~ Rate of the ease curve.
+   * @param relative ~ Whether `value` is added to the start value instead of replacing it.
+   *
+   * @returns ~ New autoreleased TweenAction.
+   */
+  static TweenAction* create(TweenProperty property, TweenCurve curve, float delay, float duration,
+                             const Vec2& value, float rate = 1.0f, bool relative = false);
+
+  /**
+   * Overrides of cocos2d::ActionInterval.
+   */
+  TweenAction* clone() const override;
+
+  TweenAction* reverse() const override;
+
+  void startWithTarget(Node* target) override;
+
+  void update(float time) override;
+
+  void stop() override;
+
+ protected:
+  /**
+   * Constructor.
+   */
+  TweenAction(TweenProperty property, TweenCurve curve, float delay, float duration, const Vec2& value,
+              float rate, bool relative);
+
+  /**
+   * Destructor.
+   */
+  virtual ~TweenAction();
+
+ private:
+  /**
+   * Friend Class
+   */
+  friend class TweenBatch;
+
+  // Tween parameters, see TweenAction#create.
+  TweenProperty property_;
+  TweenCurve curve_;
+  float delay_;
+  float tween_duration_;
+  Vec2 value_;
+  float rate_;
+  bool relative_;
+
+  // Whether the delay is over and the start value has been read.
+  bool started_;
+
+  // Slot in the TweenBatch while running, or -1.
+  int slot_;
+
+  /**
+   * __DISALLOW_COPY_AND_ASSIGN__
+   */
+  __DISALLOW_COPY_AND_ASSIGN__(TweenAction)
+};
+
+/**
+ * Running TweenActions, laid out as parallel arrays. Eases are computed for every tween in one loop, then
+ * values are written back to the nodes in a second one. Runs once per frame on the main thread, right after
+ * the ActionManager.
+ */
+class TweenBatch {
+  /**
+   * Constructor.
+   */
+  explicit TweenBatch();
+
+  /**
+   * Friend Class
+   */
+  friend class TweenAction;
+
+ public:
+  /**
+   * Gets singleton instance of this class. If the instance is null, it will initialize it and schedule it
+   * with the Director's scheduler.
+   *
+   * @returns ~ The singleton instance of the TweenBatch.
+   */
+  static TweenBatch* getInstance();
+
+  /**
+   * Eases and writes back every tween that has progressed since the last update.
+   *
+   * @param dt ~ Unused, tweens are timed by their actions.
+   */
+  void update(float dt);
+
+  /**
+   * Gets the number of running tweens.
+   */
+  size_t getCount() const { return owners_.size(); }
+
+ private:
+  /**
+   * Adds a tween to the batch.
+   *
+   * @param action ~ Tween to add. Its target must be set.
+   *
+   * @returns ~ Slot of the tween.
+   */
+  int add(TweenAction* action);
+
+  /**
+   * Removes a tween from the batch. The last tween is moved into its slot.
+   *
+   * @param slot ~ Slot of the tween.
+   */
+  void remove(int slot);
+
+  /**
+   * Reads the start value of a tween from its target once its delay is over.
+   *
+   * @param slot ~ Slot of the tween.
+   */
+  void begin(int slot);
+
+  /**
+   * Writes the current value of a tween to its target.
+   *
+   * @param slot ~ Slot of the tween.
+   * @param time ~ Eased progress of the tween.
+   */
+  void apply(size_t slot, float time);
+
+  // Tweens, indexed by slot.
+  vector<TweenAction*> owners_;
+  vector<Node*> targets_;
+  vector<TweenProperty> properties_;
+  vector<TweenCurve> curves_;
+  vector<float> rates_;
+
+  // Linear progress of each tween in [0, 1], and the eased progress computed from it.
+  vector<float> progress_;
+  vector<float> eased_;
+
+  // Whether each tween has progressed since it was last written back.
+  vector<uint8_t> dirty_;
+
+  // Start value, change over the tween, and last written position for stacking position tweens.
+  vector<Vec2> from_;
+  vector<Vec2> delta_;
+  vector<Vec2> previous_;
+
+  /**
+   * __DISALLOW_COPY_AND_ASSIGN__
+   */
+  __DISALLOW_COPY_AND_ASSIGN__(TweenBatch)
+};
+
+#endif  // __TWEEN_ACTION_HXX__
@@ -5,8 +5,13 @@
 #include "unzip/unzip.h"
 #include "xxhash/xxhash.h"
 
+// Static Declaration
+mutex ArchiveUtils::archive_mutex_;
+
 Data ArchiveUtils::loadData(const string& file, const string& archive) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "ArchiveUtils::loadData");
   ssize_t t;
+  lock_guard<mutex> lock(archive_mutex_);
 
 // Getting the data from the zip file varies based on platform.
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID or CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
@@ -26,6 +31,7 @@ Data ArchiveUtils::loadData(const string& file, const string& archive) {
 }
 
 ValueMap ArchiveUtils::loadValueMap(const string& file, const string& archive) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "ArchiveUtils::loadValueMap");
   auto data = loadData(file, archive);
 
   // Return data from file
@@ -34,6 +40,7 @@ ValueMap ArchiveUtils::loadValueMap(const string& file, const string& archive) {
 }
 
 ValueVector ArchiveUtils::loadValueVector(const string& file, const string& archive) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "ArchiveUtils::loadValueVector");
   auto data = loadData(file, archive);
 
   // Return data from file
@@ -51,6 +58,51 @@ string ArchiveUtils::loadString(const string& file, const string& archive) {
   return s;
 }
 
+bool ArchiveUtils::contains(const string& file, const string& archive) {
+  lock_guard<mutex> lock(archive_mutex_);
+  const auto zip = unzOpen(getArchivePath(archive).c_str());
+  if (zip == nullptr) return false;
+
+  // Only the central directory is read, nothing is decrypted.
+  const auto found = unzLocateFile(zip, (__ARCHIVE_ROOT__ + file).c_str(), 1) == UNZ_OK;
+  unzClose(zip);
+  return found;
+}
+
+vector<string> ArchiveUtils::list(const string& extension, const string& archive) {
+  lock_guard<mutex> lock(archive_mutex_);
+  vector<string> files;
+  const auto zip = unzOpen(getArchivePath(archive).c_str());
+  if (zip == nullptr) return files;
+
+  // Only the central directory is read, nothing is decrypted.
+  const string root = __ARCHIVE_ROOT__;
+  char name[260];
+  unz_file_info info{};
+  for (auto r = unzGoToFirstFile(zip); r == UNZ_OK; r = unzGoToNextFile(zip)) {
+    if (unzGetCurrentFileInfo(zip, &info, name, sizeof name, nullptr, 0, nullptr, 0) not_eq UNZ_OK) continue;
+
+    const string file = name;
+    if (file.compare(0, root.size(), root) not_eq 0 or file.size() < root.size() + extension.size() or
+        file.compare(file.size() - extension.size(), extension.size(), extension) not_eq 0)
+      continue;
+    files.emplace_back(file.substr(root.size()));
+  }
+
+  unzClose(zip);
+  return files;
+}
+
+string ArchiveUtils::getArchivePath(const string& archive) {
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS or CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+  return FileUtils::getInstance()->fullPathForFilename(archive);
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID or CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+  return FileUtils::getInstance()->getSuitableFOpen(FileUtils::getInstance()->getWritablePath() + archive);
+#else
+  return FileUtils::getInstance()->getSuitableFOpen(archive);
+#endif
+}
+
 string ArchiveUtils::genZipPassword(const string& salt) {
   // Creating temp locals
   const auto a = string(to_string(__ARCHIVE_PART1__));
@@ -64,7 +64,36 @@ class ArchiveUtils {
    */
   static string loadString(const string& file, const string& archive = __ARCHIVE_NAME__);
 
+  /**
+   * Checks if a file is in the password protected archive without asserting when it is missing.
+   *
+   * @param file    ~ Name of the file in the password protected archive.
+   * @param archive ~ The Name of the password protected archive.
+   *
+   * @returns True if the archive holds the file.
+   */
+  static bool contains(const string& file, const string& archive = __ARCHIVE_NAME__);
+
+  /**
+   * Lists the files in the password protected archive with an extension.
+   *
+   * @param extension ~ Extension the files end with, including the dot.
+   * @param archive   ~ The Name of the password protected archive.
+   *
+   * @returns Names of the files, in the form the load functions take them.
+   */
+  static vector<string> list(const string& extension, const string& archive = __ARCHIVE_NAME__);
+
  private:
+  /**
+   * Finds the archive the same way ArchiveUtils::loadData finds it.
+   *
+   * @param archive ~ The Name of the password protected archive.
+   *
+   * @returns Path that can be passed to unzOpen.
+   */
+  static string getArchivePath(const string& archive);
+
   /**
    * @brief Generates the hash password for the zip on the fly.
    *
@@ -91,6 +120,10 @@ class ArchiveUtils {
   static unsigned char* getFileDataFromZip(const string& archive, const string& name, ssize_t* size,
                                            const string& password = "");
 
+  // Mutex serializing reads from the archive, so files can be loaded from worker threads (chunk streaming,
+  // TmxEngine::warm()) while the main thread is loading its own.
+  static mutex archive_mutex_;
+
   /**
    * __DISALLOW_IMPLICIT_CONSTRUCTORS__
    */
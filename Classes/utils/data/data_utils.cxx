@@ -5,25 +5,39 @@
 #include "xxhash/xxhash.h"
 
 void DataUtils::initDatabase() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::initDatabase");
+
   // Get database instance.
   const auto db = getDatabase();
 
-  // Creating the main sqlite statement to create the tables if they haven't been created yet
+  // Creating the main sqlite statement to create the tables if they haven't been created yet. The totals are
+  // backfilled before their triggers exist so no score is counted twice.
   sqlite3_stmt* stmt = nullptr;
-  vector<const char*> statements = {__DI_SQLC_OTHER_DATA__, __DI_SQLC_SCORE_DATA__, __DI_SQLC_STORE_DATA__,
-                                    __DI_SQLC_TRIAL_DATA__};
-
-  // Run each create statement..
-  for (const auto& statement : statements)
-    if (sqlite3_prepare_v2(db, statement, -1, &stmt, nullptr) == SQLITE_OK)
-      if (sqlite3_step(stmt) != SQLITE_DONE) __CCLOGWITHFUNCTION("Error trying to create table...");
+  vector<const char*> statements = {__DI_SQLC_OTHER_DATA__,   __DI_SQLC_SCORE_DATA__,
+                                    __DI_SQLC_STORE_DATA__,   __DI_SQLC_TRIAL_DATA__,
+                                    __DI_SQLC_TRIAL_TOTALS__, __DI_SQLI_SCORE_TRIAL__,
+                                    __DI_SQLB_TRIAL_TOTALS__, __DI_SQLG_SCORE_INSERT__,
+                                    __DI_SQLG_SCORE_UPDATE__, __DI_SQLG_SCORE_DELETE__};
+
+  // Run each create statement in one transaction.
+  sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+  for (const auto& statement : statements) {
+    if (sqlite3_prepare_v2(db, statement, -1, &stmt, nullptr) == SQLITE_OK) {
+      if (sqlite3_step(stmt) != SQLITE_DONE)
+        __CCLOGWITHFUNCTION("Error trying to create table... STATEMENT: %s", sqlite3_errmsg(db));
+    } else
+      __CCLOGWITHFUNCTION("Error... STATEMENT: %s", sqlite3_errmsg(db));
+    sqlite3_finalize(stmt);
+  }
+  sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
 
-  // Finalize the transactions, Close the database
-  sqlite3_finalize(stmt);
+  // Close the database
   sqlite3_close(db);
 }
 
 void DataUtils::saveOtherData(const string& key, const int value) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::saveOtherData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -50,6 +64,8 @@ void DataUtils::saveOtherData(const string& key, const int value) {
 }
 
 void DataUtils::saveOtherData(const string& key, const string value) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::saveOtherData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -75,6 +91,8 @@ void DataUtils::saveOtherData(const string& key, const string value) {
 }
 
 int DataUtils::getOtherData(const string& key, const int default_value) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::getOtherData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -115,6 +133,8 @@ int DataUtils::getOtherData(const string& key, const int default_value) {
 }
 
 string DataUtils::getOtherData(const string& key, const string& default_value) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::getOtherData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -155,6 +175,8 @@ string DataUtils::getOtherData(const string& key, const string& default_value) {
 }
 
 void DataUtils::saveScoreData(ValueMap values) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::saveScoreData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -188,6 +210,8 @@ void DataUtils::saveScoreData(ValueMap values) {
 }
 
 void DataUtils::saveTrialData(ValueMap values) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::saveTrialData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -217,6 +241,8 @@ void DataUtils::saveTrialData(ValueMap values) {
 }
 
 void DataUtils::saveStoreData(const string& item) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::saveStoreData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -241,6 +267,8 @@ void DataUtils::saveStoreData(const string& item) {
 }
 
 string DataUtils::getStoreData(const string& item, const string& default_value) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::getStoreData");
+
   // Get database instance.
   const auto db = getDatabase();
 
@@ -282,6 +310,8 @@ string DataUtils::getStoreData(const string& item, const string& default_value)
 }
 
 vector<string> DataUtils::getAllStoreData() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::getAllStoreData");
+
   // Get database instance.
   const auto db = getDatabase();
   vector<string> data;
@@ -308,6 +338,55 @@ vector<string> DataUtils::getAllStoreData() {
   return data;
 }
 
+ValueMap DataUtils::getTrialTotals(const int trial) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "DataUtils::getTrialTotals");
+
+  // Create the local statement that will be used to select data. Doing it this way to make it more readable
+  stringstream fmt;
+  fmt << "SELECT stars AS " << __STARS__ << ", score AS " << __SCORE__ << ", levels AS " << __COMPLETED__
+      << " FROM " << __DI_SQLT_TRIAL_TOTALS__ << " WHERE trial=?";
+  auto rows = getRows(fmt.str(), {trial});
+
+  // A trial without any scores doesn't have a row yet.
+  if (rows.empty())
+    return ValueMap{{__STARS__, Value(0)}, {__SCORE__, Value(0)}, {__COMPLETED__, Value(0)}};
+  return rows.front().asValueMap();
+}
+
+ValueVector DataUtils::getRows(const string& statement, const vector<int>& binds) {
+  // Get database instance.
+  const auto db = getDatabase();
+  ValueVector rows;
+
+  // select data
+  sqlite3_stmt* stmt;
+  if (sqlite3_prepare_v2(db, statement.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    // Bind all of the necessary variables
+    for (auto i = 0; i < int(binds.size()); i++) sqlite3_bind_int(stmt, i + 1, binds[i]);
+
+    const auto columns = sqlite3_column_count(stmt);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      ValueMap row;
+      for (auto i = 0; i < columns; i++) {
+        const auto name = sqlite3_column_name(stmt, i);
+        if (sqlite3_column_type(stmt, i) == SQLITE_TEXT)
+          row.emplace(name, reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)));
+        else
+          row.emplace(name, sqlite3_column_int(stmt, i));
+      }
+      rows.emplace_back(move(row));
+    }
+  } else
+    __CCLOGWITHFUNCTION("Error... : %s", sqlite3_errmsg(db));
+
+  // Reset, finalize and close db
+  sqlite3_reset(stmt);
+  sqlite3_finalize(stmt);
+  sqlite3_close(db);
+
+  return rows;
+}
+
 sqlite3* DataUtils::getDatabase() {
   // Use FileUtils to get the path of the database
   const auto& path = FileUtils::getInstance()->getWritablePath() + __DI_DB_NAME__;
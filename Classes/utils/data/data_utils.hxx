@@ -27,6 +27,11 @@
 #define __DI_SQLT_STORE_DATA__ "store_data"
 #define __DI_SQLT_TRIAL_DATA__ "trial_data"
 
+/**
+ * SQLite Aggregate Tables. These are only ever written by the triggers below.
+ */
+#define __DI_SQLT_TRIAL_TOTALS__ "trial_totals"
+
 /**
  * SQLite Create Statements
  */
@@ -39,6 +44,42 @@
 #define __DI_SQLC_TRIAL_DATA__                                                                           \
   "CREATE TABLE IF NOT EXISTS trial_data(trial BIGINT PRIMARY KEY, stars BIGINT, unlocked BIGINT, last " \
   "BIGINT);"
+#define __DI_SQLC_TRIAL_TOTALS__                                                                   \
+  "CREATE TABLE IF NOT EXISTS trial_totals(trial BIGINT PRIMARY KEY, stars BIGINT, score BIGINT, " \
+  "levels BIGINT);"
+
+/**
+ * SQLite Covering Index. The per-trial totals are recomputed from the index alone.
+ */
+#define __DI_SQLI_SCORE_TRIAL__ \
+  "CREATE INDEX IF NOT EXISTS score_data_trial ON score_data(trial, level, score, stars);"
+
+/**
+ * SQLite Aggregate Triggers. A write only recomputes the trial it touches, using the index above.
+ * INSERT OR REPLACE doesn't fire delete triggers for the row it replaces, which is fine since the replaced
+ * row always has the same trial as the new one.
+ */
+#define __DI_SQL_SCORE_AGGREGATE__(__ROW__)                                                               \
+  "DELETE FROM trial_totals WHERE trial = " __ROW__ ".trial; "                                            \
+  "INSERT INTO trial_totals(trial, stars, score, levels) SELECT trial, SUM(stars), SUM(score), COUNT(*) " \
+  "FROM score_data WHERE trial = " __ROW__ ".trial GROUP BY trial; "
+#define __DI_SQLG_SCORE_INSERT__                                                     \
+  "CREATE TRIGGER IF NOT EXISTS score_data_insert AFTER INSERT ON score_data BEGIN " \
+  __DI_SQL_SCORE_AGGREGATE__("NEW") "END;"
+#define __DI_SQLG_SCORE_UPDATE__                                                     \
+  "CREATE TRIGGER IF NOT EXISTS score_data_update AFTER UPDATE ON score_data BEGIN " \
+  __DI_SQL_SCORE_AGGREGATE__("OLD") __DI_SQL_SCORE_AGGREGATE__("NEW") "END;"
+#define __DI_SQLG_SCORE_DELETE__                                                     \
+  "CREATE TRIGGER IF NOT EXISTS score_data_delete AFTER DELETE ON score_data BEGIN " \
+  __DI_SQL_SCORE_AGGREGATE__("OLD") "END;"
+
+/**
+ * SQLite Aggregate Backfill. Databases created before the aggregate table existed already hold scores, so
+ * the totals are seeded from them. The statement is a no-op once the totals exist.
+ */
+#define __DI_SQLB_TRIAL_TOTALS__                                                                           \
+  "INSERT OR IGNORE INTO trial_totals(trial, stars, score, levels) SELECT trial, SUM(stars), SUM(score), " \
+  "COUNT(*) FROM score_data GROUP BY trial;"
 
 /**
  * Database Keys
@@ -127,7 +168,28 @@ class DataUtils {
 
   static vector<string> getAllStoreData();
 
+  /**
+   * Retrieves the aggregated totals of a trial. These are maintained by triggers as scores are saved, so this
+   * never scans the score table.
+   *
+   * @param trial ~ The trial to retrieve totals for.
+   *
+   * @returns ~ ValueMap with `stars`, `score` and `completed` (number of levels with a score).
+   */
+  static ValueMap getTrialTotals(int trial);
+
  private:
+  /**
+   * Runs a select statement and collects every row.
+   *
+   * @param statement ~ Select statement to run.
+   * @param binds     ~ Integers bound to the parameters of the statement, in order.
+   *
+   * @returns ~ A ValueMap per row, keyed by column name. Integer columns are returned as ints and text
+   * columns as strings.
+   */
+  static ValueVector getRows(const string& statement, const vector<int>& binds = {});
+
   /**
    * Gets and instance of the database. This will allow the database connections be thread safe since each
    * thread will have it's own instance of the database.
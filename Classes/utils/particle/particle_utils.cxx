@@ -4,14 +4,144 @@
 #include "particle_utils.hxx"
 #include "utils/archive/archive_utils.hxx"
 
+unordered_map<string, ValueMap> ParticleUtils::dictionaries_;
+
+unordered_map<string, vector<ParticleSystemQuad*>> ParticleUtils::pool_;
+
+vector<PooledParticle*> ParticleUtils::active_;
+
+/**
+ * A particle system that ParticleUtils::reclaim puts back in the pool when its scene exits instead of letting
+ * it be destroyed, keeping its particle data and buffers for the next ParticleUtils::load.
+ */
+class PooledParticle : public ParticleSystemQuad {
+ public:
+  static PooledParticle* create(const string& filename) {
+    auto ret = new (nothrow) PooledParticle(filename);
+    if (ret and ret->initWithDictionary(ParticleUtils::loadDictionary(filename))) {
+      ret->autorelease();
+      return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+  }
+
+  ~PooledParticle() override {
+    auto& active = ParticleUtils::active_;
+    active.erase(remove(active.begin(), active.end(), this), active.end());
+  }
+
+  /**
+   * @returns ~ File the system was loaded from.
+   */
+  const string& getFilename() const { return filename_; }
+
+ private:
+  explicit PooledParticle(string filename) : filename_(move(filename)) {}
+
+  // File the system was loaded from.
+  const string filename_;
+};
+
+void ParticleUtils::recycle(const string& filename, ParticleSystemQuad* particle) {
+  auto& idle = pool_[filename];
+  if (idle.size() >= __PARTICLE_POOL_SIZE__) return;
+
+  // Actions left on systems removed without cleanup would otherwise resume on the next load.
+  particle->stopAllActions();
+  particle->retain();
+  idle.emplace_back(particle);
+}
+
+void ParticleUtils::reclaim(Scene* scene) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "ParticleUtils::reclaim");
+  auto itr = active_.begin();
+  while (itr not_eq active_.end()) {
+    // Systems in other scenes are left alone, since the next scene is already running during a transition.
+    const auto particle = *itr;
+    if (particle->getScene() not_eq scene) {
+      ++itr;
+      continue;
+    }
+
+    // The pool takes its reference before the parent lets go.
+    itr = active_.erase(itr);
+    recycle(particle->getFilename(), particle);
+    particle->removeFromParent();
+  }
+}
+
+void ParticleUtils::loadAtlas() {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "ParticleUtils::loadAtlas");
+  // The atlas is generated by xTexturePacker/extract_particles.py and is missing from older archives.
+  if (not ArchiveUtils::contains(__PARTICLE_ATLAS_PACK__)) {
+    __CCLOGWITHFUNCTION("No particle atlas found, using embedded particle textures...");
+    return;
+  }
+
+  auto plist = ArchiveUtils::loadValueMap(__PARTICLE_ATLAS_PACK__);
+  if (plist.find(__FRAMES__) == plist.end()) return;
+
+  const auto texture = Director::getInstance()->getTextureCache()->addImage(__PARTICLE_ATLAS_TEXTURE__);
+  if (texture == nullptr) return;
+  texture->setAntiAliasTexParameters();
+  SpriteFrameCache::getInstance()->addSpriteFramesWithDictionary(plist, texture);
+
+  // Hold a reference to every frame so Director::purgeCachedData never considers them unused.
+  for (const auto& frame : plist.at(__FRAMES__).asValueMap())
+    CC_SAFE_RETAIN(SpriteFrameCache::getInstance()->getSpriteFrameByName(frame.first));
+}
+
+ValueMap& ParticleUtils::loadDictionary(const string& filename) {
+  auto itr = dictionaries_.find(filename);
+  if (itr == dictionaries_.end()) {
+    // Load the data from the encrypted archive
+    itr = dictionaries_.emplace(filename, ArchiveUtils::loadValueMap(filename)).first;
+  }
+  return itr->second;
+}
+
+void ParticleUtils::prewarm(const string& filename, const int count) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "ParticleUtils::prewarm");
+  auto& idle = pool_[filename];
+  while (int(idle.size()) < min(count, __PARTICLE_POOL_SIZE__)) {
+    const auto particle = PooledParticle::create(filename);
+    if (particle == nullptr) return;
+    particle->retain();
+    idle.emplace_back(particle);
+  }
+}
+
+void ParticleUtils::prewarm(initializer_list<string> list, const int count) {
+  for_each(list.begin(), list.end(), [count](const string& file) { prewarm(file, count); });
+}
+
 ParticleSystemQuad* ParticleUtils::load(const string& filename, const float x, const float y,
                                         const bool absolute) {
-  // Load the data from the encrypted archive
-  auto dict = ArchiveUtils::loadValueMap(filename);
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "ParticleUtils::load");
+
+  // Take an idle system from the pool, handing the pool's reference over to the autorelease pool.
+  PooledParticle* particle;
+  auto& idle = pool_[filename];
+  if (not idle.empty()) {
+    particle = static_cast<PooledParticle*>(idle.back());
+    idle.pop_back();
+    particle->autorelease();
 
-  // Initialize new particle emitter
-  auto particle = ParticleSystemQuad::create();
-  particle->initWithDictionary(dict);
+    // Undo anything the previous owner may have changed on the node.
+    particle->setName("");
+    particle->setTag(Node::INVALID_TAG);
+    particle->setVisible(true);
+    particle->setOpacity(255);
+    particle->setScale(1);
+    particle->setRotation(0);
+    particle->setAnchorPoint(Vec2::ZERO);
+    particle->resetSystem();
+  } else {
+    // Initialize new particle emitter
+    particle = PooledParticle::create(filename);
+  }
+  active_.emplace_back(particle);
 
   // Set position to either absolute or screen
   if (absolute)
@@ -3,6 +3,17 @@
 #ifndef __PARTICLE_UTILS_HXX__
 #define __PARTICLE_UTILS_HXX__
 
+/**
+ * Particle Atlas. Packed from the textures embedded in particle plists by extract_particles.py.
+ */
+#define __PARTICLE_ATLAS_PACK__ "packs/particles.plist"
+#define __PARTICLE_ATLAS_TEXTURE__ "Tz3qW8nLbYc0RfKd"
+
+/**
+ * Particle Pool. Maximum number of idle systems kept for each particle file.
+ */
+#define __PARTICLE_POOL_SIZE__ 8
+
 /**
  * Includes
  */
@@ -14,17 +25,62 @@
  */
 using namespace ui;
 
+/**
+ * Forward Declarations
+ */
+class PooledParticle;
+
 class ParticleUtils {
  public:
   /**
-   * Loads a particle system and auto sets it position.
+   * Caches the sprite frames of the particle atlas. Particle plists that reference a `spriteFrameName` take
+   * their texture from these frames, so this must be called before any of them are loaded.
+   *
+   * @note ~ The frames are kept for the lifetime of the app so purging cached data between scenes can't drop
+   * them. If the atlas hasn't been packed, particles fall back to the textures embedded in their plists.
+   */
+  static void loadAtlas();
+
+  /**
+   * Loads the dictionary of a particle file. Dictionaries are cached, so each file is only read from the
+   * archive and parsed once.
+   *
+   * @param filename ~ Name of the file in the archive.
+   *
+   * @returns ~ Dictionary to pass to ParticleSystem::initWithDictionary.
+   */
+  static ValueMap& loadDictionary(const string& filename);
+
+  /**
+   * Creates particle systems ahead of time and pools them, so ParticleUtils::load doesn't need to allocate
+   * particles or set up buffers when it is called mid-game.
+   *
+   * @param filename ~ Name of the file in the archive.
+   * @param count    ~ Number of idle systems the pool should hold for this file.
+   */
+  static void prewarm(const string& filename, int count = 1);
+
+  /**
+   * Prewarms every particle in the list, for "compound" particles loaded with ParticleUtils::load.
+   *
+   * @param list  ~ List on names of particle files
+   * @param count ~ Number of idle systems the pool should hold for each file.
+   */
+  static void prewarm(initializer_list<string> list, int count = 1);
+
+  /**
+   * Loads a particle system and auto sets it position. Systems are taken from the pool when possible, and go
+   * back to the pool when ParticleUtils::reclaim is called for their scene.
    *
    * @param filename ~ Name of the file in the archive.
    * @param x        ~ X coordinate.
    * @param y        ~ Y coordinate.
    * @param absolute ~ if we should place it in absolute positioning of div positioning.
    *
-   * @returns ~ New paritcle system.
+   * @returns ~ Paritcle system restarted from the beginning.
+   *
+   * @note ~ Pooled systems are only reset to the values set here, so don't change the emitter properties of a
+   * system returned by this function.
    */
   static ParticleSystemQuad* load(const string& filename, float x = 2, float y = 2, bool absolute = false);
 
@@ -47,7 +103,35 @@ class ParticleUtils {
    */
   static void stop(Node* container);
 
+  /**
+   * Puts every system loaded with ParticleUtils::load that is still in the scene back in the pool, removing
+   * it from its parent. This must run before the scene tears down its children, since nodes destroyed along
+   * with their parent are never told they were removed.
+   *
+   * @param scene ~ The scene that is exiting.
+   */
+  static void reclaim(Scene* scene);
+
  private:
+  friend class PooledParticle;
+
+  /**
+   * Takes back a pooled system that is about to be removed from its parent.
+   *
+   * @param filename ~ Name of the file the system was loaded from.
+   * @param particle ~ The removed system.
+   */
+  static void recycle(const string& filename, ParticleSystemQuad* particle);
+
+  // Parsed particle files, keyed by file name.
+  static unordered_map<string, ValueMap> dictionaries_;
+
+  // Idle systems, keyed by file name. Each holds a reference to its systems.
+  static unordered_map<string, vector<ParticleSystemQuad*>> pool_;
+
+  // Systems handed out by ParticleUtils::load that haven't been reclaimed or destroyed yet.
+  static vector<PooledParticle*> active_;
+
   /**
    * __DISALLOW_IMPLICIT_CONSTRUCTORS__
    */
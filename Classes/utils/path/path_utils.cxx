@@ -11,7 +11,7 @@ PathNode::PathNode(Vec2 coordinates_, PathNode* parent_) {
 
 uint PathNode::getScore() { return G + H; }
 
-Generator::Generator() {
+Generator::Generator() : tmxObject(nullptr) {
   setDiagonalMovement(false);
   setHeuristic(&Heuristic::manhattan);
   direction = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}, {-1, -1}, {1, 1}, {-1, 1}, {1, -1}};
@@ -28,6 +28,14 @@ void Generator::addCollision(Vec2 coordinates_) { walls.push_back(coordinates_);
 void Generator::addCollisionList(std::vector<Point> coordinates_) { walls.swap(coordinates_); }
 
 void Generator::addCollisionList(TmxObject& tmx_object, const string& layer) {
+  if (tmx_object.isChunked()) {
+    tmxObject = &tmx_object;
+    tmxLayer = layer;
+    walls.clear();
+    return;
+  }
+
+  tmxObject = nullptr;
   addCollisionList(tmx_object.collistions_map_.at(layer));
 }
 
@@ -109,8 +117,16 @@ void Generator::releaseNodes(NodeSet& nodes_) {
 }
 
 bool Generator::detectCollision(Vec2 coordinates_) {
-  return coordinates_.x < 0 || coordinates_.x >= worldSize.x || coordinates_.y < 0 ||
-         coordinates_.y >= worldSize.y || std::find(walls.begin(), walls.end(), coordinates_) != walls.end();
+  if (coordinates_.x < 0 || coordinates_.x >= worldSize.x || coordinates_.y < 0 ||
+      coordinates_.y >= worldSize.y) {
+    return true;
+  }
+
+  if (tmxObject != nullptr) {
+    return tmxObject->containsCollision(coordinates_, tmxLayer);
+  }
+
+  return std::find(walls.begin(), walls.end(), coordinates_) != walls.end();
 }
 
 Vec2 Heuristic::getDelta(Vec2 source_, Vec2 target_) {
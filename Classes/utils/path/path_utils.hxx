@@ -60,6 +60,10 @@ class Generator {
   std::vector<Point> direction, walls;
   Point worldSize;
   uint directions;
+
+  // Chunked TmxObject to look walls up in as chunks stream in and out, instead of the `walls` snapshot.
+  TmxObject* tmxObject;
+  string tmxLayer;
 };
 
 class Heuristic {
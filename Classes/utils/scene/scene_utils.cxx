@@ -2,6 +2,7 @@
 
 // Includes
 #include "scene_utils.hxx"
+#include "engines/tmx/tmx_engine.hxx"
 #include "scenes/game/controls/controls_game_scene.hxx"
 #include "scenes/intro/intro_scene.hxx"
 #include "scenes/levels/levels_scene.hxx"
@@ -28,6 +29,17 @@ void SceneUtils::replaceScene(const Scenes& scene, BackgroundLayer* bg, const Va
   Director::getInstance()->replaceScene(TransitionFade::create(speed, createScene(scene, bg, params)));
 }
 
+Scene* SceneUtils::resumeScene(const GameSnapshot& snapshot) {
+  if (snapshot.scene not_eq CONTROLS) return nullptr;
+
+  const auto scene = createScene(Scenes(snapshot.scene), BackgroundLayer::create(), snapshot.params);
+  if (scene not_eq nullptr) static_cast<BaseGameScene*>(scene)->resume(snapshot);
+
+  // Game scenes may reset the TmxEngine when they are constructed, so warm it only once the scene exists.
+  TmxEngine::getInstance()->warm(Modes(snapshot.mode));
+  return scene;
+}
+
 Scene* SceneUtils::createScene(const Scenes& scene, BackgroundLayer* bg, ValueMap params) {
   if (scene == INTRO) {
     // Release Background since IntroLayer will create it again...
@@ -13,6 +13,7 @@
  */
 #include "globals.hxx"
 #include "layers/background/background_layer.hxx"
+#include "utils/snapshot/snapshot_utils.hxx"
 
 /**
  * @note This class work as a broker to allow the BaseScene to create the scenes once the transition is
@@ -63,6 +64,16 @@ class SceneUtils {
    */
   static void replaceScene(const Scenes& scene, BackgroundLayer* bg, const ValueMap& params, float speed);
 
+  /**
+   * Recreates the game scene captured in a snapshot, and starts warming the TmxEngine for it while the scene
+   * loads. The scene restores the rest of the snapshot once it is initialized.
+   *
+   * @param snapshot ~ Snapshot loaded with SnapshotUtils::load().
+   *
+   * @returns ~ New scene pointer, or nullptr if the snapshot isn't for a game scene.
+   */
+  static Scene* resumeScene(const GameSnapshot& snapshot);
+
  private:
   /**
    * Create a scene base on the scene parameter and passes the params and background layer.
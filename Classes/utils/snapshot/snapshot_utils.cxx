@@ -0,0 +1,225 @@
+// Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+
+// Includes
+#include "snapshot_utils.hxx"
+#include "utils/thread/thread_utils.hxx"
+
+void SnapshotUtils::save(const GameSnapshot& snapshot) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "SnapshotUtils::save");
+
+  // Header
+  string buffer;
+  write(buffer, int64_t(__SNAPSHOT_MAGIC__));
+  write(buffer, int64_t(__SNAPSHOT_VERSION__));
+
+  // Scene and map
+  write(buffer, int64_t(snapshot.scene));
+  write(buffer, int64_t(snapshot.mode));
+  write(buffer, snapshot.map);
+  write(buffer, int64_t(snapshot.chunked));
+
+  // Params. Anything that isn't a primitive can't be meaningfully restored, so it is dropped.
+  ValueMap params;
+  for (const auto& param : snapshot.params) {
+    const auto type = param.second.getType();
+    if (type not_eq Value::Type::VECTOR and type not_eq Value::Type::MAP and
+        type not_eq Value::Type::INT_KEY_MAP and type not_eq Value::Type::NONE)
+      params.emplace(param);
+  }
+
+  write(buffer, int64_t(params.size()));
+  for (const auto& param : params) {
+    write(buffer, param.first);
+    write(buffer, int64_t(param.second.getType()));
+    switch (param.second.getType()) {
+      case Value::Type::STRING:
+        write(buffer, param.second.asString());
+        break;
+      case Value::Type::FLOAT:
+      case Value::Type::DOUBLE:
+        write(buffer, param.second.asDouble());
+        break;
+      case Value::Type::BOOLEAN:
+        write(buffer, int64_t(param.second.asBool()));
+        break;
+      default:
+        write(buffer, int64_t(param.second.asInt()));
+        break;
+    }
+  }
+
+  // Random
+  for (const auto state : snapshot.random) write(buffer, int64_t(state));
+
+  // Script
+  write(buffer, int64_t(snapshot.events.size()));
+  for (const auto& event : snapshot.events) write(buffer, event);
+
+  // Entities
+  write(buffer, snapshot.player);
+  write(buffer, int64_t(snapshot.llurkers.size()));
+  for (const auto& llurker : snapshot.llurkers) write(buffer, llurker);
+
+  // The OS may kill the process at any point once the app is in the background, so write to a temporary file
+  // and swap it in only once it is complete.
+  ThreadUtils::runOnAsyncThread([buffer]() {
+    const auto path = getPath();
+    const auto temp = string(path + ".tmp");
+    if (not FileUtils::getInstance()->writeStringToFile(buffer, temp)) {
+      __CCLOGWITHFUNCTION("Failed to write snapshot: %s", temp.c_str());
+      return;
+    }
+
+    const auto directory = FileUtils::getInstance()->getWritablePath();
+    FileUtils::getInstance()->renameFile(directory, string(__SNAPSHOT_FILE__) + ".tmp", __SNAPSHOT_FILE__);
+  });
+}
+
+bool SnapshotUtils::load(GameSnapshot& snapshot) {
+  CC_PROFILER_TRACE_CATEGORY(__TRACE_CATEGORY__, "SnapshotUtils::load");
+  const auto path = getPath();
+  if (not FileUtils::getInstance()->isFileExist(path)) return false;
+
+  const auto data = FileUtils::getInstance()->getDataFromFile(path);
+  size_t offset = 0;
+
+  // Snapshots from another version of the game are discarded rather than migrated.
+  int64_t magic, version;
+  if (not read(data, offset, magic) or not read(data, offset, version) or magic not_eq __SNAPSHOT_MAGIC__ or
+      version not_eq __SNAPSHOT_VERSION__) {
+    __CCLOGWITHFUNCTION("Discarding incompatible snapshot: %s", path.c_str());
+    return false;
+  }
+
+  // Scene and map
+  int64_t scene, mode, chunked;
+  if (not read(data, offset, scene) or not read(data, offset, mode) or not read(data, offset, snapshot.map) or
+      not read(data, offset, chunked))
+    return false;
+  snapshot.scene = int(scene);
+  snapshot.mode = int(mode);
+  snapshot.chunked = chunked not_eq 0;
+
+  // Params
+  int64_t count;
+  if (not read(data, offset, count)) return false;
+  snapshot.params.clear();
+  for (auto i = 0; i < count; i++) {
+    string key;
+    int64_t type;
+    if (not read(data, offset, key) or not read(data, offset, type)) return false;
+
+    if (Value::Type(type) == Value::Type::STRING) {
+      string value;
+      if (not read(data, offset, value)) return false;
+      snapshot.params.emplace(key, value);
+    } else if (Value::Type(type) == Value::Type::FLOAT or Value::Type(type) == Value::Type::DOUBLE) {
+      double value;
+      if (not read(data, offset, value)) return false;
+      snapshot.params.emplace(key, value);
+    } else {
+      int64_t value;
+      if (not read(data, offset, value)) return false;
+      if (Value::Type(type) == Value::Type::BOOLEAN)
+        snapshot.params.emplace(key, value not_eq 0);
+      else
+        snapshot.params.emplace(key, int(value));
+    }
+  }
+
+  // Random
+  for (auto& state : snapshot.random) {
+    int64_t value;
+    if (not read(data, offset, value)) return false;
+    state = uint64_t(value);
+  }
+
+  // Script
+  if (not read(data, offset, count) or count < 0 or size_t(count) > size_t(data.getSize()) - offset)
+    return false;
+  snapshot.events.resize(size_t(count));
+  for (auto& event : snapshot.events)
+    if (not read(data, offset, event)) return false;
+
+  // Entities
+  if (not read(data, offset, snapshot.player) or not read(data, offset, count) or count < 0 or
+      size_t(count) > size_t(data.getSize()) - offset)
+    return false;
+  snapshot.llurkers.resize(size_t(count));
+  for (auto& llurker : snapshot.llurkers)
+    if (not read(data, offset, llurker)) return false;
+
+  return offset == size_t(data.getSize());
+}
+
+void SnapshotUtils::clear() {
+  ThreadUtils::runOnAsyncThread([]() {
+    const auto path = getPath();
+    if (FileUtils::getInstance()->isFileExist(path)) FileUtils::getInstance()->removeFile(path);
+  });
+}
+
+string SnapshotUtils::getPath() { return FileUtils::getInstance()->getWritablePath() + __SNAPSHOT_FILE__; }
+
+void SnapshotUtils::write(string& buffer, const int64_t value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void SnapshotUtils::write(string& buffer, const double value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void SnapshotUtils::write(string& buffer, const string& value) {
+  write(buffer, int64_t(value.size()));
+  buffer.append(value);
+}
+
+void SnapshotUtils::write(string& buffer, const EntitySnapshot& value) {
+  write(buffer, int64_t(value.type));
+  write(buffer, double(value.point.x));
+  write(buffer, double(value.point.y));
+  write(buffer, double(value.position.x));
+  write(buffer, double(value.position.y));
+  write(buffer, int64_t(value.direction));
+  write(buffer, value.movement);
+  write(buffer, value.tmx_layer);
+}
+
+bool SnapshotUtils::read(const Data& data, size_t& offset, int64_t& value) {
+  if (offset + sizeof(value) > size_t(data.getSize())) return false;
+  memcpy(&value, data.getBytes() + offset, sizeof(value));
+  offset += sizeof(value);
+  return true;
+}
+
+bool SnapshotUtils::read(const Data& data, size_t& offset, double& value) {
+  if (offset + sizeof(value) > size_t(data.getSize())) return false;
+  memcpy(&value, data.getBytes() + offset, sizeof(value));
+  offset += sizeof(value);
+  return true;
+}
+
+bool SnapshotUtils::read(const Data& data, size_t& offset, string& value) {
+  int64_t length;
+  if (not read(data, offset, length) or length < 0 or offset + size_t(length) > size_t(data.getSize()))
+    return false;
+  value.assign(reinterpret_cast<const char*>(data.getBytes() + offset), size_t(length));
+  offset += size_t(length);
+  return true;
+}
+
+bool SnapshotUtils::read(const Data& data, size_t& offset, EntitySnapshot& value) {
+  int64_t type, direction;
+  double x, y, position_x, position_y;
+  if (not read(data, offset, type) or not read(data, offset, x) or not read(data, offset, y) or
+      not read(data, offset, position_x) or not read(data, offset, position_y) or
+      not read(data, offset, direction) or not read(data, offset, value.movement) or
+      not read(data, offset, value.tmx_layer))
+    return false;
+
+  value.type = int(type);
+  value.point = Point(float(x), float(y));
+  value.position = Vec2(float(position_x), float(position_y));
+  value.direction = int(direction);
+  return true;
+}
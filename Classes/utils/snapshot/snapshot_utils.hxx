@@ -0,0 +1,141 @@
+/** Copyright (c) 2018 Mozart Alexander Louis. All rights reserved. */
+
+#ifndef __SNAPSHOT_UTILS_HXX__
+#define __SNAPSHOT_UTILS_HXX__
+
+/**
+ * Snapshot File
+ */
+#define __SNAPSHOT_FILE__ "evz.snapshot"
+#define __SNAPSHOT_MAGIC__ 0x5a4e5645
+#define __SNAPSHOT_VERSION__ 2
+
+/**
+ * Includes
+ */
+#include <array>
+#include "globals.hxx"
+
+/**
+ * State of a single entity at the moment the snapshot was taken.
+ */
+struct EntitySnapshot {
+  // Llurkers value of the entity. Unused for the player.
+  int type{0};
+
+  // Tile the entity was on.
+  Point point;
+
+  // Exact position of the entity, which may be between tiles.
+  Vec2 position;
+
+  // Directions value the entity was moving in.
+  int direction{NONE};
+
+  // Unbiased decimal<3> movement left until the next tile.
+  int64_t movement{0};
+
+  // Layer the entity was traversing.
+  string tmx_layer;
+};
+
+/**
+ * Gameplay state needed to put the player straight back into a BaseGameScene.
+ */
+struct GameSnapshot {
+  // Scenes value of the game scene.
+  int scene{CONTROLS};
+
+  // Modes value the map was cached with.
+  int mode{CONTROLSM};
+
+  // Name of the map node, which is also the key of its TmxObject in the TmxEngine.
+  string map;
+
+  // Whether `map` is a chunked map directory.
+  bool chunked{false};
+
+  // Scene params. Only strings, numbers and booleans are kept.
+  ValueMap params;
+
+  // State of the RandomObject of the scene, so a resumed run draws the values the original would have.
+  array<uint64_t, 4> random{};
+
+  // Events in the scene script that haven't been triggered yet.
+  vector<string> events;
+
+  // The player.
+  EntitySnapshot player;
+
+  // Every llurker on the map.
+  vector<EntitySnapshot> llurkers;
+};
+
+class SnapshotUtils {
+ public:
+  /**
+   * Writes a snapshot to the writable path on a worker thread. The file is written next to the previous one
+   * and renamed over it, so a process killed mid-write leaves the previous snapshot intact.
+   *
+   * @param snapshot ~ Snapshot to write. Copied before leaving the calling thread.
+   */
+  static void save(const GameSnapshot& snapshot);
+
+  /**
+   * Reads the snapshot from the writable path.
+   *
+   * @param snapshot ~ Snapshot to read into.
+   *
+   * @returns ~ true if a valid snapshot for this version of the game was found, otherwise false.
+   */
+  static bool load(GameSnapshot& snapshot);
+
+  /**
+   * Deletes the snapshot, if any. Queued behind any pending save so an older save can't bring it back.
+   */
+  static void clear();
+
+ private:
+  /**
+   * Gets the full path of the snapshot file.
+   */
+  static string getPath();
+
+  /**
+   * Appends a value to `buffer` in the snapshot format.
+   *
+   * @param buffer ~ Buffer to append to.
+   * @param value  ~ Value to append.
+   */
+  static void write(string& buffer, int64_t value);
+
+  static void write(string& buffer, double value);
+
+  static void write(string& buffer, const string& value);
+
+  static void write(string& buffer, const EntitySnapshot& value);
+
+  /**
+   * Reads a value from `data` at `offset` and advances `offset` past it.
+   *
+   * @param data   ~ Snapshot file.
+   * @param offset ~ Current read offset.
+   * @param value  ~ Value to read into.
+   *
+   * @returns ~ false if `data` ended before the value did.
+   */
+  static bool read(const Data& data, size_t& offset, int64_t& value);
+
+  static bool read(const Data& data, size_t& offset, double& value);
+
+  static bool read(const Data& data, size_t& offset, string& value);
+
+  static bool read(const Data& data, size_t& offset, EntitySnapshot& value);
+
+  /**
+   * __DISALLOW_IMPLICIT_CONSTRUCTORS__
+   */
+  __DISALLOW_IMPLICIT_CONSTRUCTORS__(SnapshotUtils)
+};
+
+#endif  // __SNAPSHOT_UTILS_HXX__
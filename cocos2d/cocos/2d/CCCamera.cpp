@@ -526,6 +526,10 @@ int Camera::getRenderOrder() const
 
 void Camera::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t parentFlags)
 {
+    // other nodes read the view projection while visiting, see Renderer::visitConcurrently()
+    if (renderer->deferVisit(this, parentTransform, parentFlags))
+        return;
+
     _viewProjectionUpdated = _transformUpdated;
     return Node::visit(renderer, parentTransform, parentFlags);
 }
@@ -194,6 +194,10 @@ void ClippingNode::visit(Renderer *renderer, const Mat4 &parentTransform, uint32
 {
     if (!_visible || !hasContent())
         return;
+
+    // sets up stencil state while visiting, see Renderer::visitConcurrently()
+    if (renderer->deferVisit(this, parentTransform, parentFlags))
+        return;
     
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
@@ -46,10 +46,10 @@ TMXTiledMap * TMXTiledMap::create(const std::string& tmxFile)
     return nullptr;
 }
 
-TMXTiledMap* TMXTiledMap::createWithXML(const std::string& tmxString, const std::string& resourcePath)
+TMXTiledMap* TMXTiledMap::createWithXML(std::string tmxString, const std::string& resourcePath)
 {
     TMXTiledMap *ret = new (std::nothrow) TMXTiledMap();
-    if (ret->initWithXML(tmxString, resourcePath))
+    if (ret->initWithXML(std::move(tmxString), resourcePath))
     {
         ret->autorelease();
         return ret;
@@ -76,11 +76,11 @@ bool TMXTiledMap::initWithTMXFile(const std::string& tmxFile)
     return true;
 }
 
-bool TMXTiledMap::initWithXML(const std::string& tmxString, const std::string& resourcePath)
+bool TMXTiledMap::initWithXML(std::string tmxString, const std::string& resourcePath)
 {
     setContentSize(Size::ZERO);
 
-    TMXMapInfo *mapInfo = TMXMapInfo::createWithXML(tmxString, resourcePath);
+    TMXMapInfo *mapInfo = TMXMapInfo::createWithXML(std::move(tmxString), resourcePath);
 
     CCASSERT( !mapInfo->getTilesets().empty(), "FastTMXTiledMap: Map not found. Please check the filename.");
     buildWithMapInfo(mapInfo);
@@ -108,11 +108,11 @@ public:
 
     /** Initializes a TMX Tiled Map with a TMX formatted XML string and a path to TMX resources. 
      *
-     * @param tmxString A TMX formatted XML string.
+     * @param tmxString A TMX formatted XML string. It is parsed in place, pass an rvalue to avoid copying it.
      * @param resourcePath A path to TMX resources.
      * @return An autorelease object.
      */
-    static TMXTiledMap* createWithXML(const std::string& tmxString, const std::string& resourcePath);
+    static TMXTiledMap* createWithXML(std::string tmxString, const std::string& resourcePath);
 
     /** Return the FastTMXLayer for the specific layer. 
      * 
@@ -220,7 +220,7 @@ protected:
     bool initWithTMXFile(const std::string& tmxFile);
 
     /** initializes a TMX Tiled Map with a TMX formatted XML string and a path to TMX resources */
-    bool initWithXML(const std::string& tmxString, const std::string& resourcePath);
+    bool initWithXML(std::string tmxString, const std::string& resourcePath);
     
     TMXLayer * parseLayer(TMXLayerInfo *layerInfo, TMXMapInfo *mapInfo);
     TMXTilesetInfo * tilesetForLayer(TMXLayerInfo *layerInfo, TMXMapInfo *mapInfo);
@@ -1633,6 +1633,10 @@ void Label::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t pare
     
     if (_systemFontDirty || _contentDirty)
     {
+        // creates letters and textures, see Renderer::visitConcurrently()
+        if (renderer->deferVisit(this, parentTransform, parentFlags))
+            return;
+
         updateContent();
     }
     
@@ -42,6 +42,7 @@ THE SOFTWARE.
 #include "2d/CCScene.h"
 #include "2d/CCComponent.h"
 #include "renderer/CCGLProgram.h"
+#include "renderer/CCRenderer.h"
 #include "renderer/CCGLProgramState.h"
 #include "renderer/CCMaterial.h"
 #include "math/TransformUtils.h"
@@ -111,6 +112,7 @@ Node::Node()
 , _cascadeColorEnabled(false)
 , _cascadeOpacityEnabled(true)
 , _cameraMask(1)
+, _concurrentVisitEnabled(false)
 #if CC_USE_PHYSICS
 , _physicsBody(nullptr)
 #endif
@@ -1267,22 +1269,32 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
     if(!_children.empty())
     {
         sortAllChildren();
+        const bool concurrent = _concurrentVisitEnabled && !renderer->isRecording();
         // draw children zOrder < 0
         for(auto size = _children.size(); i < size; ++i)
         {
             auto node = _children.at(i);
 
             if (node && node->_localZOrder < 0)
-                node->visit(renderer, _modelViewTransform, flags);
+            {
+                if (!concurrent)
+                    node->visit(renderer, _modelViewTransform, flags);
+            }
             else
                 break;
         }
+        if (concurrent)
+            renderer->visitConcurrently(_children, 0, i, _modelViewTransform, flags);
+
         // self draw
         if (visibleByCamera)
             this->draw(renderer, _modelViewTransform, flags);
 
-        for(auto it=_children.cbegin()+i, itCend = _children.cend(); it != itCend; ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
+        if (concurrent)
+            renderer->visitConcurrently(_children, i, _children.size(), _modelViewTransform, flags);
+        else
+            for(auto it=_children.cbegin()+i, itCend = _children.cend(); it != itCend; ++it)
+                (*it)->visit(renderer, _modelViewTransform, flags);
     }
     else if (visibleByCamera)
     {
@@ -1180,6 +1180,23 @@ public:
     virtual void visit(Renderer *renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit() final;
 
+    /**
+     * Sets whether the children of this node are visited concurrently, see Renderer::visitConcurrently().
+     * Worth enabling on nodes with many children whose subtrees are expensive to visit, like pages full of
+     * sprites, labels and particles. Children may not modify the scene graph or shared state while visiting.
+     * Engine nodes that can't be visited on a worker thread are visited on the calling thread instead.
+     *
+     * @param enabled Whether children are visited concurrently.
+     */
+    void setConcurrentVisitEnabled(bool enabled) { _concurrentVisitEnabled = enabled; }
+
+    /**
+     * Returns whether the children of this node are visited concurrently.
+     *
+     * @return Whether children are visited concurrently.
+     */
+    bool isConcurrentVisitEnabled() const { return _concurrentVisitEnabled; }
+
 
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
@@ -2010,6 +2027,9 @@ protected:
 
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
+
+    // whether children are visited with Renderer::visitConcurrently()
+    bool _concurrentVisitEnabled;
     
     std::function<void()> _onEnterCallback;
     std::function<void()> _onExitCallback;
@@ -2038,6 +2058,9 @@ public:
     
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(Node);
+
+    // Compares siblings with the same key sortNodes does when ordering listeners.
+    friend class EventDispatcher;
 };
 
 /**
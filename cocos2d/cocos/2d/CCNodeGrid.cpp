@@ -107,6 +107,10 @@ void NodeGrid::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t p
         return;
     }
 
+    // may create its grid while visiting, see Renderer::visitConcurrently()
+    if (renderer->deferVisit(this, parentTransform, parentFlags))
+        return;
+
     bool dirty = (parentFlags & FLAGS_TRANSFORM_DIRTY) || _transformUpdated;
     if(dirty)
         _modelViewTransform = this->transform(parentTransform);
@@ -48,6 +48,7 @@ THE SOFTWARE.
 #include <string>
 
 #include "2d/CCParticleBatchNode.h"
+#include "2d/CCParticleSystemKernels.h"
 #include "renderer/CCTextureAtlas.h"
 #include "base/base64.h"
 #include "base/ZipUtils.h"
@@ -55,6 +56,7 @@ THE SOFTWARE.
 #include "base/CCProfiling.h"
 #include "base/ccUTF8.h"
 #include "renderer/CCTextureCache.h"
+#include "2d/CCSpriteFrameCache.h"
 #include "platform/CCFileUtils.h"
 
 using namespace std;
@@ -79,23 +81,6 @@ NS_CC_BEGIN
 //
 
 
-inline void normalize_point(float x, float y, particle_point* out)
-{
-    float n = x * x + y * y;
-    // Already normalized.
-    if (n == 1.0f)
-        return;
-    
-    n = sqrt(n);
-    // Too close to zero.
-    if (n < MATH_TOLERANCE)
-        return;
-    
-    n = 1.0f / n;
-    out->x = x * n;
-    out->y = y * n;
-}
-
 /**
  A more effect random number getter function, get from ejoy2d.
  */
@@ -472,9 +457,18 @@ bool ParticleSystem::initWithDictionary(ValueMap& dictionary, const std::string&
                 // Set a compatible default for the alpha transfer
                 _opacityModifyRGB = false;
 
-                // texture        
+                // texture
+                // Particles packed into a shared atlas reference a sprite frame instead of a texture of their own.
+                // Using it skips decoding an image, and lets every emitter drawing from the atlas be batched.
+                std::string frameName = dictionary["spriteFrameName"].asString();
+                SpriteFrame *frame = nullptr;
+                if (!frameName.empty())
+                {
+                    frame = SpriteFrameCache::getInstance()->getSpriteFrameByName(frameName);
+                }
+
                 // Try to get the texture from the cache
-                std::string textureName = dictionary["textureFileName"].asString();
+                std::string textureName = frame ? "" : dictionary["textureFileName"].asString();
                 
                 size_t rPos = textureName.rfind('/');
                
@@ -505,7 +499,11 @@ bool ParticleSystem::initWithDictionary(ValueMap& dictionary, const std::string&
                     FileUtils::getInstance()->setPopupNotify(notify);
                 }
                 
-                if (tex)
+                if (frame)
+                {
+                    setDisplayFrame(frame);
+                }
+                else if (tex)
                 {
                     setTexture(tex);
                 }
@@ -892,78 +890,42 @@ void ParticleSystem::update(float dt)
     }
     
     {
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.timeToLive[i] -= dt;
-        }
+        ParticleKernels::add(_particleData.timeToLive, -dt, _particleCount);
         
-        for (int i = 0; i < _particleCount; ++i)
+        // Most frames nothing dies, so skip straight to the next dead particle.
+        for (int i = ParticleKernels::findNonPositive(_particleData.timeToLive, 0, _particleCount); i < _particleCount;
+             i = ParticleKernels::findNonPositive(_particleData.timeToLive, i + 1, _particleCount))
         {
-            if (_particleData.timeToLive[i] <= 0.0f)
+            int j = _particleCount - 1;
+            while (j > 0 && _particleData.timeToLive[j] <= 0)
             {
-                int j = _particleCount - 1;
-                while (j > 0 && _particleData.timeToLive[j] <= 0)
-                {
-                    _particleCount--;
-                    j--;
-                }
-                _particleData.copyParticle(i, _particleCount - 1);
-                if (_batchNode)
-                {
-                    //disable the switched particle
-                    int currentIndex = _particleData.atlasIndex[i];
-                    _batchNode->disableParticle(_atlasIndex + currentIndex);
-                    //switch indexes
-                    _particleData.atlasIndex[_particleCount - 1] = currentIndex;
-                }
-                --_particleCount;
-                if( _particleCount == 0 && _isAutoRemoveOnFinish )
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
+                _particleCount--;
+                j--;
+            }
+            _particleData.copyParticle(i, _particleCount - 1);
+            if (_batchNode)
+            {
+                //disable the switched particle
+                int currentIndex = _particleData.atlasIndex[i];
+                _batchNode->disableParticle(_atlasIndex + currentIndex);
+                //switch indexes
+                _particleData.atlasIndex[_particleCount - 1] = currentIndex;
+            }
+            --_particleCount;
+            if( _particleCount == 0 && _isAutoRemoveOnFinish )
+            {
+                this->unscheduleUpdate();
+                _parent->removeChild(this, true);
+                return;
             }
         }
         
         if (_emitterMode == Mode::GRAVITY)
         {
-            for (int i = 0 ; i < _particleCount; ++i)
-            {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
-                
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
-                {
-                    normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
-                }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
-                
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= - _particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-                
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-                
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-                
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-                
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
-            }
+            ParticleKernels::integrateGravity(_particleData.posx, _particleData.posy,
+                                              _particleData.modeA.dirX, _particleData.modeA.dirY,
+                                              _particleData.modeA.radialAccel, _particleData.modeA.tangentialAccel,
+                                              modeA.gravity, dt, _yCoordFlipped, _particleCount);
         }
         else
         {
@@ -973,15 +935,8 @@ void ParticleSystem::update(float dt)
             //And every property's memory of the particle system is continuous,
             //for the purpose of improving cache hit rate, we should process only one property in one for-loop AFAP.
             //It was proved to be effective especially for low-end machine. 
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
-            }
-            
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
-            }
+            ParticleKernels::integrate(_particleData.modeB.angle, _particleData.modeB.degreesPerSecond, dt, _particleCount);
+            ParticleKernels::integrate(_particleData.modeB.radius, _particleData.modeB.deltaRadius, dt, _particleCount);
             
             for (int i = 0; i < _particleCount; ++i)
             {
@@ -994,36 +949,14 @@ void ParticleSystem::update(float dt)
         }
         
         //color r,g,b,a
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
-        }
-        
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
-        }
-        
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
-        }
-        
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
-        }
+        ParticleKernels::integrate(_particleData.colorR, _particleData.deltaColorR, dt, _particleCount);
+        ParticleKernels::integrate(_particleData.colorG, _particleData.deltaColorG, dt, _particleCount);
+        ParticleKernels::integrate(_particleData.colorB, _particleData.deltaColorB, dt, _particleCount);
+        ParticleKernels::integrate(_particleData.colorA, _particleData.deltaColorA, dt, _particleCount);
         //size
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
-        }
+        ParticleKernels::integratePositive(_particleData.size, _particleData.deltaSize, dt, _particleCount);
         //angle
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
-        }
+        ParticleKernels::integrate(_particleData.rotation, _particleData.deltaRotation, dt, _particleCount);
         
         updateParticleQuads();
         _transformSystemDirty = false;
@@ -1094,6 +1027,11 @@ Texture2D * ParticleSystem::getTexture() const
     return _texture;
 }
 
+void ParticleSystem::setDisplayFrame(SpriteFrame *spriteFrame)
+{
+    setTexture(spriteFrame->getTexture());
+}
+
 // ParticleSystem - Additive Blending
 void ParticleSystem::setBlendAdditive(bool additive)
 {
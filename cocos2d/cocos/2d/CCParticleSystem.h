@@ -143,6 +143,7 @@ public:
 //typedef void (*CC_UPDATE_PARTICLE_IMP)(id, SEL, tParticle*, Vec2);
 
 class Texture2D;
+class SpriteFrame;
 
 /** @class ParticleSystem
  * @brief Particle System base class.
@@ -745,6 +746,15 @@ public:
      * @param type The particles movement type.
      */
     void setPositionType(PositionType type) { _positionType = type; }
+
+    /** Sets a SpriteFrame as the particle texture.
+     * Used by initWithDictionary() when the dictionary has a "spriteFrameName" key, so several systems can share
+     * one texture atlas. The base class only uses the texture of the frame. ParticleSystemQuad also uses its rect.
+     * @since v3.17
+     *
+     * @param spriteFrame A sprite frame with no offset and no rotation.
+     */
+    virtual void setDisplayFrame(SpriteFrame *spriteFrame);
     
     // Overrides
     virtual void onEnter() override;
@@ -0,0 +1,430 @@
+/****************************************************************************
+Copyright (c) 2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CCPARTICLE_SYSTEM_KERNELS_H__
+#define __CCPARTICLE_SYSTEM_KERNELS_H__
+
+#include <cmath>
+#include <cstdint>
+#include "base/ccTypes.h"
+#include "base/ccMacros.h"
+#include "math/CCMathBase.h"
+
+//#define CC_PARTICLE_AVX   : 8 wide AVX kernels
+//#define CC_PARTICLE_SSE   : 4 wide SSE2 kernels
+//#define CC_PARTICLE_NEON  : 4 wide NEON kernels
+// Nothing defined        : scalar kernels only
+//
+// Define CC_PARTICLE_SCALAR to force the scalar kernels, e.g. to measure the speedup of the others.
+
+#if defined (CC_PARTICLE_SCALAR)
+    #define CC_PARTICLE_SIMD_WIDTH 1
+#elif defined (__AVX__)
+    #include <immintrin.h>
+    #define CC_PARTICLE_AVX
+    #define CC_PARTICLE_SIMD_WIDTH 8
+#elif defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CC_PARTICLE_SSE
+    #define CC_PARTICLE_SIMD_WIDTH 4
+#elif defined (__ARM_NEON__) || defined (__ARM_NEON)
+    #include <arm_neon.h>
+    #define CC_PARTICLE_NEON
+    #define CC_PARTICLE_SIMD_WIDTH 4
+#else
+    #define CC_PARTICLE_SIMD_WIDTH 1
+#endif
+
+NS_CC_BEGIN
+
+/// @cond DO_NOT_SHOW
+
+/**
+ * Kernels that update the SoA arrays of ParticleData for a whole system at once.
+ *
+ * Each kernel processes CC_PARTICLE_SIMD_WIDTH particles per iteration and finishes the remainder with the
+ * scalar code it replaced, so every build gets the same results up to floating point rounding. The width is
+ * picked at compile time, the same way MathUtil picks its SSE and NEON paths.
+ */
+namespace ParticleKernels
+{
+
+#if CC_PARTICLE_SIMD_WIDTH > 1
+
+#if defined (CC_PARTICLE_AVX)
+
+typedef __m256 vfloat;
+
+inline vfloat vload(const float* p) { return _mm256_loadu_ps(p); }
+inline void vstore(float* p, vfloat v) { _mm256_storeu_ps(p, v); }
+inline void vstoreint(int32_t* p, vfloat v) { _mm256_storeu_si256((__m256i*)p, _mm256_cvttps_epi32(v)); }
+inline vfloat vset(float f) { return _mm256_set1_ps(f); }
+inline vfloat vadd(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+inline vfloat vsub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+inline vfloat vmul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+inline vfloat vdiv(vfloat a, vfloat b) { return _mm256_div_ps(a, b); }
+inline vfloat vsqrt(vfloat a) { return _mm256_sqrt_ps(a); }
+inline vfloat vmax(vfloat a, vfloat b) { return _mm256_max_ps(a, b); }
+inline vfloat vand(vfloat a, vfloat b) { return _mm256_and_ps(a, b); }
+inline vfloat vle(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+inline vfloat vge(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+inline vfloat vneq(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+inline bool vany(vfloat mask) { return _mm256_movemask_ps(mask) != 0; }
+
+#elif defined (CC_PARTICLE_SSE)
+
+typedef __m128 vfloat;
+
+inline vfloat vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, vfloat v) { _mm_storeu_ps(p, v); }
+inline void vstoreint(int32_t* p, vfloat v) { _mm_storeu_si128((__m128i*)p, _mm_cvttps_epi32(v)); }
+inline vfloat vset(float f) { return _mm_set1_ps(f); }
+inline vfloat vadd(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+inline vfloat vsub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+inline vfloat vmul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+inline vfloat vdiv(vfloat a, vfloat b) { return _mm_div_ps(a, b); }
+inline vfloat vsqrt(vfloat a) { return _mm_sqrt_ps(a); }
+inline vfloat vmax(vfloat a, vfloat b) { return _mm_max_ps(a, b); }
+inline vfloat vand(vfloat a, vfloat b) { return _mm_and_ps(a, b); }
+inline vfloat vle(vfloat a, vfloat b) { return _mm_cmple_ps(a, b); }
+inline vfloat vge(vfloat a, vfloat b) { return _mm_cmpge_ps(a, b); }
+inline vfloat vneq(vfloat a, vfloat b) { return _mm_cmpneq_ps(a, b); }
+inline bool vany(vfloat mask) { return _mm_movemask_ps(mask) != 0; }
+
+#elif defined (CC_PARTICLE_NEON)
+
+typedef float32x4_t vfloat;
+
+inline vfloat vload(const float* p) { return vld1q_f32(p); }
+inline void vstore(float* p, vfloat v) { vst1q_f32(p, v); }
+inline void vstoreint(int32_t* p, vfloat v) { vst1q_s32(p, vcvtq_s32_f32(v)); }
+inline vfloat vset(float f) { return vdupq_n_f32(f); }
+inline vfloat vadd(vfloat a, vfloat b) { return vaddq_f32(a, b); }
+inline vfloat vsub(vfloat a, vfloat b) { return vsubq_f32(a, b); }
+inline vfloat vmul(vfloat a, vfloat b) { return vmulq_f32(a, b); }
+inline vfloat vmax(vfloat a, vfloat b) { return vmaxq_f32(a, b); }
+inline vfloat vand(vfloat a, vfloat b)
+{
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+inline vfloat vle(vfloat a, vfloat b) { return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+inline vfloat vge(vfloat a, vfloat b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+inline vfloat vneq(vfloat a, vfloat b) { return vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(a, b))); }
+
+#if defined (__aarch64__)
+inline vfloat vdiv(vfloat a, vfloat b) { return vdivq_f32(a, b); }
+inline vfloat vsqrt(vfloat a) { return vsqrtq_f32(a); }
+inline bool vany(vfloat mask) { return vmaxvq_u32(vreinterpretq_u32_f32(mask)) != 0; }
+#else
+// ARMv7 NEON has no divide or square root, so refine the estimates with two Newton-Raphson steps.
+inline vfloat vdiv(vfloat a, vfloat b)
+{
+    float32x4_t r = vrecpeq_f32(b);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+}
+inline vfloat vsqrt(vfloat a)
+{
+    float32x4_t r = vrsqrteq_f32(a);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    // 0 * inf is NaN, callers mask out lengths that are too close to zero.
+    return vmulq_f32(a, r);
+}
+inline bool vany(vfloat mask)
+{
+    uint32x4_t m = vreinterpretq_u32_f32(mask);
+    uint32x2_t t = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+    return vget_lane_u32(vpmax_u32(t, t), 0) != 0;
+}
+#endif
+
+#endif
+
+#endif // CC_PARTICLE_SIMD_WIDTH > 1
+
+/** x[i] += a */
+inline void add(float* x, float a, int count)
+{
+    int i = 0;
+#if CC_PARTICLE_SIMD_WIDTH > 1
+    const vfloat va = vset(a);
+    for (; i + CC_PARTICLE_SIMD_WIDTH <= count; i += CC_PARTICLE_SIMD_WIDTH)
+    {
+        vstore(x + i, vadd(vload(x + i), va));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        x[i] += a;
+    }
+}
+
+/** x[i] += delta[i] * dt */
+inline void integrate(float* x, const float* delta, float dt, int count)
+{
+    int i = 0;
+#if CC_PARTICLE_SIMD_WIDTH > 1
+    const vfloat vdt = vset(dt);
+    for (; i + CC_PARTICLE_SIMD_WIDTH <= count; i += CC_PARTICLE_SIMD_WIDTH)
+    {
+        vstore(x + i, vadd(vload(x + i), vmul(vload(delta + i), vdt)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        x[i] += delta[i] * dt;
+    }
+}
+
+/** x[i] = MAX(0, x[i] + delta[i] * dt) */
+inline void integratePositive(float* x, const float* delta, float dt, int count)
+{
+    int i = 0;
+#if CC_PARTICLE_SIMD_WIDTH > 1
+    const vfloat vdt = vset(dt);
+    const vfloat zero = vset(0);
+    for (; i + CC_PARTICLE_SIMD_WIDTH <= count; i += CC_PARTICLE_SIMD_WIDTH)
+    {
+        vstore(x + i, vmax(vadd(vload(x + i), vmul(vload(delta + i), vdt)), zero));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        x[i] += delta[i] * dt;
+        x[i] = MAX(0, x[i]);
+    }
+}
+
+/** Returns the first index in [begin, end) where x[i] <= 0, or end if there is none. */
+inline int findNonPositive(const float* x, int begin, int end)
+{
+    int i = begin;
+#if CC_PARTICLE_SIMD_WIDTH > 1
+    const vfloat zero = vset(0);
+    for (; i + CC_PARTICLE_SIMD_WIDTH <= end; i += CC_PARTICLE_SIMD_WIDTH)
+    {
+        if (vany(vle(vload(x + i), zero)))
+            break;
+    }
+#endif
+    for (; i < end; ++i)
+    {
+        if (x[i] <= 0.0f)
+            return i;
+    }
+    return end;
+}
+
+/** Applies gravity, radial and tangential acceleration to the particles of a gravity mode system. */
+inline void integrateGravity(float* posx, float* posy, float* dirX, float* dirY, const float* radialAccel,
+                             const float* tangentialAccel, const Vec2& gravity, float dt, float yCoordFlipped,
+                             int count)
+{
+    int i = 0;
+#if CC_PARTICLE_SIMD_WIDTH > 1
+    const vfloat vdt = vset(dt);
+    const vfloat gx = vset(gravity.x);
+    const vfloat gy = vset(gravity.y);
+    const vfloat flip = vset(dt * yCoordFlipped);
+    const vfloat one = vset(1.0f);
+    const vfloat tolerance = vset(MATH_TOLERANCE);
+    for (; i + CC_PARTICLE_SIMD_WIDTH <= count; i += CC_PARTICLE_SIMD_WIDTH)
+    {
+        const vfloat x = vload(posx + i);
+        const vfloat y = vload(posy + i);
+
+        // radial direction. Points of length one or close to zero get no radial direction, as they always have.
+        const vfloat n = vadd(vmul(x, x), vmul(y, y));
+        const vfloat length = vsqrt(n);
+        const vfloat mask = vand(vneq(n, one), vge(length, tolerance));
+        const vfloat inverse = vdiv(one, length);
+        const vfloat rx = vand(mask, vmul(x, inverse));
+        const vfloat ry = vand(mask, vmul(y, inverse));
+
+        // (gravity + radial + tangential) * dt
+        const vfloat radial = vload(radialAccel + i);
+        const vfloat tangential = vload(tangentialAccel + i);
+        const vfloat ax = vadd(vsub(vmul(rx, radial), vmul(ry, tangential)), gx);
+        const vfloat ay = vadd(vadd(vmul(ry, radial), vmul(rx, tangential)), gy);
+
+        const vfloat dx = vadd(vload(dirX + i), vmul(ax, vdt));
+        const vfloat dy = vadd(vload(dirY + i), vmul(ay, vdt));
+        vstore(dirX + i, dx);
+        vstore(dirY + i, dy);
+        vstore(posx + i, vadd(x, vmul(dx, flip)));
+        vstore(posy + i, vadd(y, vmul(dy, flip)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float rx = 0.0f, ry = 0.0f;
+        float n = posx[i] * posx[i] + posy[i] * posy[i];
+        if (n != 1.0f)
+        {
+            n = std::sqrt(n);
+            if (n >= MATH_TOLERANCE)
+            {
+                n = 1.0f / n;
+                rx = posx[i] * n;
+                ry = posy[i] * n;
+            }
+        }
+
+        dirX[i] += (rx * radialAccel[i] - ry * tangentialAccel[i] + gravity.x) * dt;
+        dirY[i] += (ry * radialAccel[i] + rx * tangentialAccel[i] + gravity.y) * dt;
+        posx[i] += dirX[i] * dt * yCoordFlipped;
+        posy[i] += dirY[i] * dt * yCoordFlipped;
+    }
+}
+
+/** Writes the vertices of a quad centered on (x, y). */
+inline void writeQuadVertices(V3F_C4B_T2F_Quad* quad, float x, float y, float size, float cr, float sr)
+{
+    const float size_2 = size / 2;
+    const float x1 = -size_2;
+    const float y1 = -size_2;
+    const float x2 = size_2;
+    const float y2 = size_2;
+
+    quad->bl.vertices.x = x1 * cr - y1 * sr + x;
+    quad->bl.vertices.y = x1 * sr + y1 * cr + y;
+    quad->br.vertices.x = x2 * cr - y1 * sr + x;
+    quad->br.vertices.y = x2 * sr + y1 * cr + y;
+    quad->tl.vertices.x = x1 * cr - y2 * sr + x;
+    quad->tl.vertices.y = x1 * sr + y2 * cr + y;
+    quad->tr.vertices.x = x2 * cr - y2 * sr + x;
+    quad->tr.vertices.y = x2 * sr + y2 * cr + y;
+}
+
+/**
+ * Writes the vertices of every quad of a system that isn't in PositionType::FREE.
+ * With `relative`, particle i is drawn at (x[i] - (current.x - startX[i]) + offset.x, ...), otherwise at
+ * (x[i] + offset.x, ...).
+ */
+inline void updateQuadVertices(V3F_C4B_T2F_Quad* quads, const float* x, const float* y, const float* startX,
+                               const float* startY, const float* size, const float* rotation, bool relative,
+                               const Vec2& current, const Vec2& offset, int count)
+{
+    int i = 0;
+#if CC_PARTICLE_SIMD_WIDTH > 1
+    alignas(32) float px[CC_PARTICLE_SIMD_WIDTH], py[CC_PARTICLE_SIMD_WIDTH];
+    alignas(32) float cr[CC_PARTICLE_SIMD_WIDTH], sr[CC_PARTICLE_SIMD_WIDTH];
+    const vfloat zero = vset(0);
+    const vfloat cx = vset(current.x);
+    const vfloat cy = vset(current.y);
+    const vfloat ox = vset(offset.x);
+    const vfloat oy = vset(offset.y);
+    for (; i + CC_PARTICLE_SIMD_WIDTH <= count; i += CC_PARTICLE_SIMD_WIDTH)
+    {
+        vfloat nx = vload(x + i);
+        vfloat ny = vload(y + i);
+        if (relative)
+        {
+            nx = vsub(nx, vsub(cx, vload(startX + i)));
+            ny = vsub(ny, vsub(cy, vload(startY + i)));
+        }
+        vstore(px, vadd(nx, ox));
+        vstore(py, vadd(ny, oy));
+
+        // Most particles never rotate, so only pay for the trigonometry when some of them do.
+        const vfloat r = vload(rotation + i);
+        const bool rotated = vany(vneq(r, zero));
+        for (int j = 0; j < CC_PARTICLE_SIMD_WIDTH; ++j)
+        {
+            const float radians = rotated ? -CC_DEGREES_TO_RADIANS(rotation[i + j]) : 0.0f;
+            cr[j] = rotated ? cosf(radians) : 1.0f;
+            sr[j] = rotated ? sinf(radians) : 0.0f;
+        }
+
+        for (int j = 0; j < CC_PARTICLE_SIMD_WIDTH; ++j)
+        {
+            writeQuadVertices(quads + i + j, px[j], py[j], size[i + j], cr[j], sr[j]);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float nx = x[i];
+        float ny = y[i];
+        if (relative)
+        {
+            nx = x[i] - (current.x - startX[i]);
+            ny = y[i] - (current.y - startY[i]);
+        }
+
+        const float radians = -CC_DEGREES_TO_RADIANS(rotation[i]);
+        writeQuadVertices(quads + i, nx + offset.x, ny + offset.y, size[i], cosf(radians), sinf(radians));
+    }
+}
+
+/** Writes the vertex colors of every quad, premultiplying them by alpha with `opacityModifyRGB`. */
+inline void updateQuadColors(V3F_C4B_T2F_Quad* quads, const float* r, const float* g, const float* b,
+                             const float* a, bool opacityModifyRGB, int count)
+{
+    int i = 0;
+#if CC_PARTICLE_SIMD_WIDTH > 1
+    alignas(32) int32_t cr[CC_PARTICLE_SIMD_WIDTH], cg[CC_PARTICLE_SIMD_WIDTH];
+    alignas(32) int32_t cb[CC_PARTICLE_SIMD_WIDTH], ca[CC_PARTICLE_SIMD_WIDTH];
+    const vfloat scale = vset(255);
+    for (; i + CC_PARTICLE_SIMD_WIDTH <= count; i += CC_PARTICLE_SIMD_WIDTH)
+    {
+        const vfloat va = vload(a + i);
+        const vfloat vm = opacityModifyRGB ? vmul(va, scale) : scale;
+        vstoreint(cr, vmul(vload(r + i), vm));
+        vstoreint(cg, vmul(vload(g + i), vm));
+        vstoreint(cb, vmul(vload(b + i), vm));
+        vstoreint(ca, vmul(va, scale));
+
+        for (int j = 0; j < CC_PARTICLE_SIMD_WIDTH; ++j)
+        {
+            const Color4B color((GLubyte)cr[j], (GLubyte)cg[j], (GLubyte)cb[j], (GLubyte)ca[j]);
+            V3F_C4B_T2F_Quad* quad = quads + i + j;
+            quad->bl.colors = color;
+            quad->br.colors = color;
+            quad->tl.colors = color;
+            quad->tr.colors = color;
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const float m = opacityModifyRGB ? a[i] * 255 : 255;
+        const Color4B color((GLubyte)(int32_t)(r[i] * m), (GLubyte)(int32_t)(g[i] * m),
+                            (GLubyte)(int32_t)(b[i] * m), (GLubyte)(int32_t)(a[i] * 255));
+        V3F_C4B_T2F_Quad* quad = quads + i;
+        quad->bl.colors = color;
+        quad->br.colors = color;
+        quad->tl.colors = color;
+        quad->tr.colors = color;
+    }
+}
+
+} // namespace ParticleKernels
+
+/// @endcond
+
+NS_CC_END
+
+#endif //__CCPARTICLE_SYSTEM_KERNELS_H__
@@ -91,7 +91,7 @@ public:
      * @param spriteFrame A given sprite frame as particle texture.
     @since v0.99.4
     */
-    void setDisplayFrame(SpriteFrame *spriteFrame);
+    virtual void setDisplayFrame(SpriteFrame *spriteFrame) override;
 
     /** Sets a new texture with a rect. The rect is in Points.
      @since v0.99.4
@@ -30,6 +30,7 @@
 #include "2d/CCProtectedNode.h"
 
 #include "base/CCDirector.h"
+#include "renderer/CCRenderer.h"
 #include "2d/CCScene.h"
 
 NS_CC_BEGIN
@@ -290,7 +291,10 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
     
     sortAllChildren();
     sortAllProtectedChildren();
-    
+
+    // only _children are visited concurrently, protected children are usually just a few renderers
+    const bool concurrent = _concurrentVisitEnabled && !renderer->isRecording();
+
     //
     // draw children and protectedChildren zOrder < 0
     //
@@ -299,10 +303,15 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
         auto node = _children.at(i);
         
         if ( node && node->getLocalZOrder() < 0 )
-            node->visit(renderer, _modelViewTransform, flags);
+        {
+            if (!concurrent)
+                node->visit(renderer, _modelViewTransform, flags);
+        }
         else
             break;
     }
+    if (concurrent)
+        renderer->visitConcurrently(_children, 0, i, _modelViewTransform, flags);
 
     for(auto size = _protectedChildren.size(); j < size; ++j)
     {
@@ -326,8 +335,11 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
     for(auto it=_protectedChildren.cbegin()+j, itCend = _protectedChildren.cend(); it != itCend; ++it)
         (*it)->visit(renderer, _modelViewTransform, flags);
 
-    for(auto it=_children.cbegin()+i, itCend = _children.cend(); it != itCend; ++it)
-        (*it)->visit(renderer, _modelViewTransform, flags);
+    if (concurrent)
+        renderer->visitConcurrently(_children, i, _children.size(), _modelViewTransform, flags);
+    else
+        for(auto it=_children.cbegin()+i, itCend = _children.cend(); it != itCend; ++it)
+            (*it)->visit(renderer, _modelViewTransform, flags);
     
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -483,7 +483,11 @@ void RenderTexture::visit(Renderer *renderer, const Mat4 &parentTransform, uint3
     {
         return;
     }
-    
+
+    // touches GL and the matrix stack while visiting, see Renderer::visitConcurrently()
+    if (renderer->deferVisit(this, parentTransform, parentFlags))
+        return;
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
     Director* director = Director::getInstance();
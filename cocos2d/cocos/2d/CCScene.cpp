@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "base/ccUTF8.h"
 #include "renderer/CCRenderer.h"
 #include "renderer/CCFrameBuffer.h"
+#include "base/CCProfiling.h"
 
 #if CC_USE_PHYSICS
 #include "physics/CCPhysicsWorld.h"
@@ -227,7 +228,10 @@ void Scene::render(Renderer* renderer, const Mat4* eyeTransforms, const Mat4* ey
         //clear background with max depth
         camera->clearBackground();
         //visit the scene
-        visit(renderer, transform, 0);
+        {
+            CC_PROFILER_TRACE("Node::visit");
+            visit(renderer, transform, 0);
+        }
 #if CC_USE_NAVMESH
         if (_navMesh && _navMeshDebugCamera == camera)
         {
@@ -0,0 +1,278 @@
+/****************************************************************************
+Copyright (c) 2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "2d/CCTMXBakedLayer.h"
+
+#include <unordered_map>
+#include "2d/CCCamera.h"
+#include "2d/CCTMXTiledMap.h"
+#include "base/CCDirector.h"
+#include "base/CCEventDispatcher.h"
+#include "base/CCEventListenerCustom.h"
+#include "base/CCEventType.h"
+#include "base/CCProfiling.h"
+#include "base/ccUTF8.h"
+#include "renderer/CCGLProgramCache.h"
+#include "renderer/CCGLProgramState.h"
+#include "renderer/CCRenderer.h"
+#include "renderer/CCTextureAtlas.h"
+#include "renderer/ccGLStateCache.h"
+
+NS_CC_BEGIN
+
+TMXBakedLayer * TMXBakedLayer::create(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *layerInfo, TMXMapInfo *mapInfo)
+{
+    TMXBakedLayer *ret = new (std::nothrow) TMXBakedLayer();
+    if (ret && ret->initWithTilesetInfo(tilesetInfo, layerInfo, mapInfo))
+    {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+TMXBakedLayer::TMXBakedLayer()
+: _baked(false)
+, _bakedGLProgramState(nullptr)
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+, _rendererRecreatedListener(nullptr)
+#endif
+{
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // The buffers died with the old context. Forget them without deleting, they are re-baked on the next draw.
+    _rendererRecreatedListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        _chunks.clear();
+        _visibleChunks.clear();
+        _baked = false;
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_rendererRecreatedListener, -1);
+#endif
+}
+
+TMXBakedLayer::~TMXBakedLayer()
+{
+    releaseChunks();
+    CC_SAFE_RELEASE(_bakedGLProgramState);
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_rendererRecreatedListener);
+#endif
+}
+
+void TMXBakedLayer::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
+{
+    // Tile sprites write into the atlas every frame, so they need the batch rendering of TMXLayer.
+    if (!_children.empty() || _layerOrientation != TMXOrientationOrtho)
+    {
+        if (_baked)
+        {
+            // The atlas was never uploaded while baked, make sure the batch command does it.
+            releaseChunks();
+            _textureAtlas->setDirty(true);
+        }
+        SpriteBatchNode::draw(renderer, transform, flags);
+        return;
+    }
+
+    // setTileGID() and removeTileAt() edit the atlas, which marks it dirty.
+    if (!_baked || _textureAtlas->isDirty())
+    {
+        bake();
+    }
+
+    // Cull the chunks against the visible rect of the camera, in node space.
+    auto camera = Camera::getVisitingCamera();
+    const Size& size = Director::getInstance()->getVisibleSize();
+    Rect visibleRect(camera->getPositionX() - size.width * 0.5f,
+                     camera->getPositionY() - size.height * 0.5f,
+                     size.width,
+                     size.height);
+    visibleRect = RectApplyTransform(visibleRect, transform.getInversed());
+
+    _visibleChunks.clear();
+    for (const auto& chunk : _chunks)
+    {
+        if (chunk.bounds.intersectsRect(visibleRect))
+        {
+            _visibleChunks.push_back(&chunk);
+        }
+    }
+
+    if (_visibleChunks.empty() || _displayedOpacity == 0 || _opacity == 0)
+    {
+        return;
+    }
+
+    _customCommand.init(_globalZOrder, transform, flags);
+    _customCommand.func = CC_CALLBACK_0(TMXBakedLayer::onDraw, this, transform, flags);
+    renderer->addCommand(&_customCommand);
+}
+
+void TMXBakedLayer::onDraw(const Mat4 &transform, uint32_t /*flags*/)
+{
+    // The opacity from the TMX file and the displayed opacity of the node are both applied here.
+    float opacity = _displayedOpacity / 255.0f * _opacity / 255.0f;
+    Vec4 color(_displayedColor.r / 255.0f, _displayedColor.g / 255.0f, _displayedColor.b / 255.0f, opacity);
+    if (_textureAtlas->getTexture()->hasPremultipliedAlpha())
+    {
+        color.x *= opacity;
+        color.y *= opacity;
+        color.z *= opacity;
+    }
+
+    _bakedGLProgramState->setUniformVec4("u_color", color);
+    _bakedGLProgramState->apply(transform);
+
+    GL::bindTexture2D(_textureAtlas->getTexture());
+    GL::blendFunc(_blendFunc.src, _blendFunc.dst);
+    GL::bindVAO(0);
+    GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION | GL::VERTEX_ATTRIB_FLAG_TEX_COORD);
+
+    ssize_t vertices = 0;
+    for (const auto chunk : _visibleChunks)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, chunk->buffers[0]);
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_T2F),
+                              (GLvoid*)offsetof(V3F_T2F, vertices));
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_T2F),
+                              (GLvoid*)offsetof(V3F_T2F, texCoords));
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, chunk->buffers[1]);
+        glDrawElements(GL_TRIANGLES, chunk->indexCount, GL_UNSIGNED_SHORT, (GLvoid*)0);
+        vertices += chunk->indexCount / 6 * 4;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(_visibleChunks.size(), vertices);
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void TMXBakedLayer::bake()
+{
+    CC_PROFILER_TRACE("TMXBakedLayer::bake");
+
+    releaseChunks();
+
+    if (_bakedGLProgramState == nullptr)
+    {
+        auto glProgram = GLProgramCache::getInstance()->getGLProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_U_COLOR);
+        _bakedGLProgramState = GLProgramState::create(glProgram);
+        CC_SAFE_RETAIN(_bakedGLProgramState);
+    }
+
+    Size tileSize = CC_SIZE_PIXELS_TO_POINTS(_mapTileSize);
+    float chunkWidth = tileSize.width * CHUNK_TILES;
+    float chunkHeight = tileSize.height * CHUNK_TILES;
+    int chunksWide = std::max(1, (int)ceilf(_layerSize.width / CHUNK_TILES));
+    int chunksHigh = std::max(1, (int)ceilf(_layerSize.height / CHUNK_TILES));
+
+    // Bucket every quad by the chunk its bottom left corner falls in. Colors are dropped since they are
+    // applied through the uniform.
+    std::unordered_map<int, std::vector<V3F_T2F>> buckets;
+    auto quads = _textureAtlas->getQuads();
+    for (ssize_t i = 0, total = _textureAtlas->getTotalQuads(); i < total; ++i)
+    {
+        const auto& quad = quads[i];
+        int x = clampf(floorf(quad.bl.vertices.x / chunkWidth), 0, chunksWide - 1);
+        int y = clampf(floorf(quad.bl.vertices.y / chunkHeight), 0, chunksHigh - 1);
+
+        auto& bucket = buckets[y * chunksWide + x];
+        bucket.push_back({quad.bl.vertices, quad.bl.texCoords});
+        bucket.push_back({quad.br.vertices, quad.br.texCoords});
+        bucket.push_back({quad.tl.vertices, quad.tl.texCoords});
+        bucket.push_back({quad.tr.vertices, quad.tr.texCoords});
+    }
+
+    GL::bindVAO(0);
+    _chunks.reserve(buckets.size());
+    std::vector<GLushort> indices;
+    for (const auto& bucket : buckets)
+    {
+        const auto& vertices = bucket.second;
+        CCASSERT(vertices.size() <= 65536, "TMXBakedLayer: too many quads in a chunk for 16-bit indices");
+
+        // Same winding as TextureAtlas::setupIndices()
+        GLushort quadCount = static_cast<GLushort>(vertices.size() / 4);
+        indices.resize(quadCount * 6);
+        for (GLushort i = 0; i < quadCount; ++i)
+        {
+            indices[i * 6 + 0] = i * 4 + 0;
+            indices[i * 6 + 1] = i * 4 + 1;
+            indices[i * 6 + 2] = i * 4 + 2;
+            indices[i * 6 + 3] = i * 4 + 3;
+            indices[i * 6 + 4] = i * 4 + 2;
+            indices[i * 6 + 5] = i * 4 + 1;
+        }
+
+        // Tiles can be bigger than the map tiles, so the bounds come from the vertices themselves.
+        Vec2 min(vertices[0].vertices.x, vertices[0].vertices.y);
+        Vec2 max(min);
+        for (const auto& vertex : vertices)
+        {
+            min.x = std::min(min.x, vertex.vertices.x);
+            min.y = std::min(min.y, vertex.vertices.y);
+            max.x = std::max(max.x, vertex.vertices.x);
+            max.y = std::max(max.y, vertex.vertices.y);
+        }
+
+        Chunk chunk;
+        chunk.bounds = Rect(min.x, min.y, max.x - min.x, max.y - min.y);
+        chunk.indexCount = static_cast<GLsizei>(indices.size());
+
+        glGenBuffers(2, chunk.buffers);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.buffers[0]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(V3F_T2F) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, chunk.buffers[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), indices.data(), GL_STATIC_DRAW);
+        _chunks.push_back(chunk);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    CHECK_GL_ERROR_DEBUG();
+
+    // The quads now live in the chunks, the atlas doesn't need to be uploaded.
+    _textureAtlas->setDirty(false);
+    _baked = true;
+}
+
+void TMXBakedLayer::releaseChunks()
+{
+    for (auto& chunk : _chunks)
+    {
+        glDeleteBuffers(2, chunk.buffers);
+    }
+    _chunks.clear();
+    _visibleChunks.clear();
+    _baked = false;
+}
+
+std::string TMXBakedLayer::getDescription() const
+{
+    return StringUtils::format("<TMXBakedLayer | tag = %d, size = %d,%d, chunks = %d>",
+                               _tag, (int)_layerSize.width, (int)_layerSize.height, (int)_chunks.size());
+}
+
+NS_CC_END
@@ -0,0 +1,127 @@
+/****************************************************************************
+Copyright (c) 2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __CCTMX_BAKED_LAYER_H__
+#define __CCTMX_BAKED_LAYER_H__
+
+#include <vector>
+#include "2d/CCTMXLayer.h"
+#include "renderer/CCCustomCommand.h"
+
+NS_CC_BEGIN
+
+class EventListenerCustom;
+class GLProgramState;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/** @brief TMXBakedLayer is a TMXLayer that renders its tiles from static vertex buffers.
+ *
+ * The first time the layer is drawn, the quads of its TextureAtlas are baked into square chunks of
+ * CHUNK_TILES x CHUNK_TILES tiles, each with its own static vertex and index buffer. Every frame the chunks are
+ * culled against the visible rect of the camera, and the surviving ones are drawn with a single command.
+ * Nothing is uploaded per frame, so the cost of a layer doesn't grow with the size of the map.
+ *
+ * The color and opacity of the layer are passed as a uniform, so fading a layer doesn't touch the buffers.
+ * Unlike TMXLayer, fading works even when no tile sprites have been created.
+ *
+ * The layer is re-baked whenever the atlas changes (setTileGID(), removeTileAt()). While a tile sprite
+ * created with getTileAt() is alive, and for non-orthogonal maps, it falls back to regular TMXLayer rendering.
+ * @since v3.17
+ */
+class CC_DLL TMXBakedLayer : public TMXLayer
+{
+public:
+    /** Width and height, in tiles, of a baked chunk. */
+    static const int CHUNK_TILES = 16;
+
+    /** Creates a TMXBakedLayer with a tileset info, a layer info and a map info.
+     *
+     * @param tilesetInfo A tileset info.
+     * @param layerInfo A layer info.
+     * @param mapInfo A map info.
+     * @return An autorelease object.
+     */
+    static TMXBakedLayer * create(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *layerInfo, TMXMapInfo *mapInfo);
+
+    //
+    // Override
+    //
+    virtual void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags) override;
+    virtual std::string getDescription() const override;
+
+CC_CONSTRUCTOR_ACCESS:
+    /**
+     * @js ctor
+     */
+    TMXBakedLayer();
+    /**
+     * @js NA
+     * @lua NA
+     */
+    virtual ~TMXBakedLayer();
+
+protected:
+    struct Chunk
+    {
+        /** Bounds of the chunk in node space, used for culling. */
+        Rect bounds;
+        /** Vertex buffer and index buffer. */
+        GLuint buffers[2];
+        /** Number of indices in the index buffer. */
+        GLsizei indexCount;
+    };
+
+    /** Color and opacity are a uniform here, and touching the quads would only force a rebake. */
+    virtual void updateColor() override {}
+
+    /** Rebuilds the chunks from the quads in the texture atlas. */
+    void bake();
+    /** Deletes the buffers of every chunk. */
+    void releaseChunks();
+    void onDraw(const Mat4 &transform, uint32_t flags);
+
+    std::vector<Chunk> _chunks;
+    std::vector<const Chunk*> _visibleChunks;
+    bool _baked;
+
+    GLProgramState *_bakedGLProgramState;
+    CustomCommand _customCommand;
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    EventListenerCustom *_rendererRecreatedListener;
+#endif
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(TMXBakedLayer);
+};
+
+// end of tilemap_parallax_nodes group
+/// @}
+
+NS_CC_END
+
+#endif //__CCTMX_BAKED_LAYER_H__
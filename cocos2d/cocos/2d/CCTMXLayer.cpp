@@ -264,6 +264,32 @@ void TMXLayer::parseInternalProperties()
     }
 }
 
+void TMXLayer::updateColor()
+{
+    if (!_textureAtlas || !_textureAtlas->getTexture())
+        return;
+
+    // Same color Sprite::updateColor() gives a tile. Tiles that are sprites update their own quads afterwards.
+    GLubyte opacity = static_cast<GLubyte>(_opacity * _displayedOpacity / 255);
+    Color4B color(_displayedColor.r, _displayedColor.g, _displayedColor.b, opacity);
+    if (_textureAtlas->getTexture()->hasPremultipliedAlpha())
+    {
+        color.r = static_cast<GLubyte>(color.r * opacity / 255);
+        color.g = static_cast<GLubyte>(color.g * opacity / 255);
+        color.b = static_cast<GLubyte>(color.b * opacity / 255);
+    }
+
+    auto quads = _textureAtlas->getQuads();
+    for (ssize_t i = 0, total = _textureAtlas->getTotalQuads(); i < total; ++i)
+    {
+        quads[i].bl.colors = color;
+        quads[i].br.colors = color;
+        quads[i].tl.colors = color;
+        quads[i].tr.colors = color;
+    }
+    _textureAtlas->setDirty(true);
+}
+
 void TMXLayer::setupTileSprite(Sprite* sprite, const Vec2& pos, uint32_t gid)
 {
     sprite->setPosition(getPositionAt(pos));
@@ -295,6 +295,9 @@ public:
     virtual std::string getDescription() const override;
 
 protected:
+    /** Writes the displayed color and opacity to every quad, since tiles only have a Sprite once getTileAt() made one. */
+    virtual void updateColor() override;
+
     Vec2 getPositionForIsoAt(const Vec2& pos);
     Vec2 getPositionForOrthoAt(const Vec2& pos);
     Vec2 getPositionForHexAt(const Vec2& pos);
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "2d/CCTMXTiledMap.h"
 #include "2d/CCTMXXMLParser.h"
 #include "2d/CCTMXLayer.h"
+#include "2d/CCTMXBakedLayer.h"
 #include "2d/CCSprite.h"
 #include "base/ccUTF8.h"
 
@@ -47,10 +48,10 @@ TMXTiledMap * TMXTiledMap::create(const std::string& tmxFile)
     return nullptr;
 }
 
-TMXTiledMap* TMXTiledMap::createWithXML(const std::string& tmxString, const std::string& resourcePath)
+TMXTiledMap* TMXTiledMap::createWithXML(std::string tmxString, const std::string& resourcePath)
 {
     TMXTiledMap *ret = new (std::nothrow) TMXTiledMap();
-    if (ret->initWithXML(tmxString, resourcePath))
+    if (ret->initWithXML(std::move(tmxString), resourcePath))
     {
         ret->autorelease();
         return ret;
@@ -79,13 +80,13 @@ bool TMXTiledMap::initWithTMXFile(const std::string& tmxFile)
     return true;
 }
 
-bool TMXTiledMap::initWithXML(const std::string& tmxString, const std::string& resourcePath)
+bool TMXTiledMap::initWithXML(std::string tmxString, const std::string& resourcePath)
 {
     _tmxFile = tmxString;
 
     setContentSize(Size::ZERO);
 
-    TMXMapInfo *mapInfo = TMXMapInfo::createWithXML(tmxString, resourcePath);
+    TMXMapInfo *mapInfo = TMXMapInfo::createWithXML(std::move(tmxString), resourcePath);
 
     CCASSERT( !mapInfo->getTilesets().empty(), "TMXTiledMap: Map not found. Please check the filename.");
     buildWithMapInfo(mapInfo);
@@ -112,7 +113,13 @@ TMXLayer * TMXTiledMap::parseLayer(TMXLayerInfo *layerInfo, TMXMapInfo *mapInfo)
     if (tileset == nullptr)
         return nullptr;
     
+#if CC_TMX_BAKED_LAYERS
+    TMXLayer *layer = mapInfo->getOrientation() == TMXOrientationOrtho
+        ? TMXBakedLayer::create(tileset, layerInfo, mapInfo)
+        : TMXLayer::create(tileset, layerInfo, mapInfo);
+#else
     TMXLayer *layer = TMXLayer::create(tileset, layerInfo, mapInfo);
+#endif
 
     if (nullptr != layer)
     {
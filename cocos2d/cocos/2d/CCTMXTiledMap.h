@@ -143,12 +143,12 @@ public:
 
     /** Initializes a TMX Tiled Map with a TMX formatted XML string and a path to TMX resources. 
      *
-     * @param tmxString A TMX formatted XML string.
+     * @param tmxString A TMX formatted XML string. It is parsed in place, pass an rvalue to avoid copying it.
      * @param resourcePath The path to TMX resources.
      * @return An autorelease object.
      * @js NA
      */
-    static TMXTiledMap* createWithXML(const std::string& tmxString, const std::string& resourcePath);
+    static TMXTiledMap* createWithXML(std::string tmxString, const std::string& resourcePath);
 
     /** Return the TMXLayer for the specific layer. 
      *
@@ -291,7 +291,7 @@ CC_CONSTRUCTOR_ACCESS:
     bool initWithTMXFile(const std::string& tmxFile);
     
     /** initializes a TMX Tiled Map with a TMX formatted XML string and a path to TMX resources */
-    bool initWithXML(const std::string& tmxString, const std::string& resourcePath);
+    bool initWithXML(std::string tmxString, const std::string& resourcePath);
 
 protected:
     TMXLayer * parseLayer(TMXLayerInfo *layerInfo, TMXMapInfo *mapInfo);
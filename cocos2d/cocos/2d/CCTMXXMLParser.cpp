@@ -115,10 +115,10 @@ TMXMapInfo * TMXMapInfo::create(const std::string& tmxFile)
     return nullptr;
 }
 
-TMXMapInfo * TMXMapInfo::createWithXML(const std::string& tmxString, const std::string& resourcePath)
+TMXMapInfo * TMXMapInfo::createWithXML(std::string tmxString, const std::string& resourcePath)
 {
     TMXMapInfo *ret = new (std::nothrow) TMXMapInfo();
-    if (ret->initWithXML(tmxString, resourcePath))
+    if (ret->initWithXML(std::move(tmxString), resourcePath))
     {
         ret->autorelease();
         return ret;
@@ -149,10 +149,10 @@ void TMXMapInfo::internalInit(const std::string& tmxFileName, const std::string&
     _currentFirstGID = -1;
 }
 
-bool TMXMapInfo::initWithXML(const std::string& tmxString, const std::string& resourcePath)
+bool TMXMapInfo::initWithXML(std::string tmxString, const std::string& resourcePath)
 {
     internalInit("", resourcePath);
-    return parseXMLString(tmxString);
+    return parseXMLString(std::move(tmxString));
 }
 
 bool TMXMapInfo::initWithTMXFile(const std::string& tmxFile)
@@ -183,7 +183,7 @@ TMXMapInfo::~TMXMapInfo()
     CCLOGINFO("deallocing TMXMapInfo: %p", this);
 }
 
-bool TMXMapInfo::parseXMLString(const std::string& xmlString)
+bool TMXMapInfo::parseXMLString(std::string xmlString)
 {
     size_t len = xmlString.size();
     if (len <= 0)
@@ -198,7 +198,9 @@ bool TMXMapInfo::parseXMLString(const std::string& xmlString)
 
     parser.setDelegator(this);
 
-    return parser.parse(xmlString.c_str(), len);
+    // rapidxml terminates names and values inside the buffer, so the attributes and text handed to the
+    // delegate point straight into it instead of into a copy.
+    return parser.parseIntrusive(&xmlString.front(), len);
 }
 
 bool TMXMapInfo::parseXMLFile(const std::string& xmlFilename)
@@ -212,7 +214,13 @@ bool TMXMapInfo::parseXMLFile(const std::string& xmlFilename)
     
     parser.setDelegator(this);
 
-    return parser.parse(FileUtils::getInstance()->fullPathForFilename(xmlFilename));
+    Data data = FileUtils::getInstance()->getDataFromFile(FileUtils::getInstance()->fullPathForFilename(xmlFilename));
+    if (data.isNull())
+    {
+        return false;
+    }
+
+    return parser.parseIntrusive((char*)data.getBytes(), data.getSize());
 }
 
 // the XML parser calls here with all the elements
@@ -679,82 +687,96 @@ void TMXMapInfo::endElement(void* /*ctx*/, const char *name)
             tmxMapInfo->setStoringCharacters(false);
             
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
-            
-            std::string currentString = tmxMapInfo->getCurrentString();
-            unsigned char *buffer;
-            auto len = base64Decode((unsigned char*)currentString.c_str(), (unsigned int)currentString.length(), &buffer);
-            if (!buffer)
+            Size s = layer->_layerSize;
+            ssize_t tilesSize = s.width * s.height * sizeof(uint32_t);
+
+            uint32_t *tiles = (uint32_t*)malloc(tilesSize);
+            if (!tiles)
             {
-                CCLOG("cocos2d: TiledMap: decode data error");
+                CCLOG("cocos2d: TiledMap: tiles buffer not allocated.");
                 return;
             }
-            
+
+            unsigned char *encoded = (unsigned char*)&_currentString[0];
+            unsigned int encodedLen = (unsigned int)_currentString.length();
+
             if (tmxMapInfo->getLayerAttribs() & (TMXLayerAttribGzip | TMXLayerAttribZlib))
             {
-                unsigned char *deflated = nullptr;
-                Size s = layer->_layerSize;
-                // int sizeHint = s.width * s.height * sizeof(uint32_t);
-                ssize_t sizeHint = s.width * s.height * sizeof(unsigned int);
-                
-                ssize_t CC_UNUSED inflatedLen = ZipUtils::inflateMemoryWithHint(buffer, len, &deflated, sizeHint);
-                CCASSERT(inflatedLen == sizeHint, "inflatedLen should be equal to sizeHint!");
-                
-                free(buffer);
-                buffer = nullptr;
-                
-                if (!deflated)
+                // Decode in place, the decoded data is always shorter than the text it came from.
+                int len = base64DecodeTo(encoded, encodedLen, encoded, encodedLen);
+                ssize_t CC_UNUSED inflatedLen = len < 0 ? -1 : ZipUtils::inflateMemoryTo(encoded, len, (unsigned char*)tiles, tilesSize);
+                CCASSERT(inflatedLen == tilesSize, "inflatedLen should be equal to tilesSize!");
+
+                if (inflatedLen < 0)
                 {
                     CCLOG("cocos2d: TiledMap: inflate data error");
+                    free(tiles);
                     return;
                 }
-                
-                layer->_tiles = reinterpret_cast<uint32_t*>(deflated);
+
+                memset((unsigned char*)tiles + inflatedLen, 0, tilesSize - inflatedLen);
             }
             else
             {
-                layer->_tiles = reinterpret_cast<uint32_t*>(buffer);
+                // Uncompressed data decodes straight into the gids.
+                int len = base64DecodeTo(encoded, encodedLen, (unsigned char*)tiles, (unsigned int)tilesSize);
+                if (len < 0)
+                {
+                    CCLOG("cocos2d: TiledMap: decode data error");
+                    free(tiles);
+                    return;
+                }
+
+                memset((unsigned char*)tiles + len, 0, tilesSize - len);
             }
-            
-            tmxMapInfo->setCurrentString("");
+
+            layer->_tiles = tiles;
+
+            _currentString.clear();
         }
         else if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribCSV)
         {
-            unsigned char *buffer;
-
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
 
             tmxMapInfo->setStoringCharacters(false);
-            std::string currentString = tmxMapInfo->getCurrentString();
-
-            vector<string> gidTokens;
-            istringstream filestr(currentString);
-            string sRow;
-            while(getline(filestr, sRow, '\n')) {
-                string sGID;
-                istringstream rowstr(sRow);
-                while (getline(rowstr, sGID, ',')) {
-                    gidTokens.push_back(sGID);
+
+            // Count the gids first, so they can be parsed straight into a buffer of the right size.
+            const char *csv = _currentString.c_str();
+            size_t gidCount = 0;
+            for (const char *p = csv; *p; ++p)
+            {
+                if (*p >= '0' && *p <= '9' && (p == csv || p[-1] < '0' || p[-1] > '9'))
+                {
+                    ++gidCount;
                 }
             }
 
             // 32-bits per gid
-            buffer = (unsigned char*)malloc(gidTokens.size() * 4);
-            if (!buffer)
+            uint32_t *tiles = (uint32_t*)malloc(gidCount * sizeof(uint32_t));
+            if (!tiles)
             {
                 CCLOG("cocos2d: TiledMap: CSV buffer not allocated.");
                 return;
             }
 
-            uint32_t* bufferPtr = reinterpret_cast<uint32_t*>(buffer);
-            for(auto gidToken : gidTokens) {
-                auto tileGid = (uint32_t)strtoul(gidToken.c_str(), nullptr, 10);
-                *bufferPtr = tileGid;
-                bufferPtr++;
+            uint32_t *tile = tiles;
+            for (const char *p = csv; *p;)
+            {
+                if (*p >= '0' && *p <= '9')
+                {
+                    char *end = nullptr;
+                    *tile++ = (uint32_t)strtoul(p, &end, 10);
+                    p = end;
+                }
+                else
+                {
+                    ++p;
+                }
             }
 
-            layer->_tiles = reinterpret_cast<uint32_t*>(buffer);
+            layer->_tiles = tiles;
 
-            tmxMapInfo->setCurrentString("");
+            _currentString.clear();
         }
         else if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribNone)
         {
@@ -789,14 +811,10 @@ void TMXMapInfo::endElement(void* /*ctx*/, const char *name)
 
 void TMXMapInfo::textHandler(void* /*ctx*/, const char *ch, size_t len)
 {
-    TMXMapInfo *tmxMapInfo = this;
-    std::string text(ch, 0, len);
-
-    if (tmxMapInfo->isStoringCharacters())
+    // Layer data may arrive in several chunks, append them in place rather than copying the whole string each time.
+    if (isStoringCharacters())
     {
-        std::string currentString = tmxMapInfo->getCurrentString();
-        currentString += text;
-        tmxMapInfo->setCurrentString(currentString);
+        _currentString.append(ch, len);
     }
 }
 
@@ -175,8 +175,8 @@ class CC_DLL TMXMapInfo : public Ref, public SAXDelegator
 public:    
     /** creates a TMX Format with a tmx file */
     static TMXMapInfo * create(const std::string& tmxFile);
-    /** creates a TMX Format with an XML string and a TMX resource path */
-    static TMXMapInfo * createWithXML(const std::string& tmxString, const std::string& resourcePath);
+    /** creates a TMX Format with an XML string and a TMX resource path. The string is parsed in place, pass an rvalue to avoid copying it */
+    static TMXMapInfo * createWithXML(std::string tmxString, const std::string& resourcePath);
     
     /** creates a TMX Format with a tmx file */
     CC_DEPRECATED_ATTRIBUTE static TMXMapInfo * formatWithTMXFile(const char *tmxFile) { return TMXMapInfo::create(tmxFile); };
@@ -194,12 +194,12 @@ public:
     
     /** initializes a TMX format with a  tmx file */
     bool initWithTMXFile(const std::string& tmxFile);
-    /** initializes a TMX format with an XML string and a TMX resource path */
-    bool initWithXML(const std::string& tmxString, const std::string& resourcePath);
+    /** initializes a TMX format with an XML string and a TMX resource path. The string is parsed in place, pass an rvalue to avoid copying it */
+    bool initWithXML(std::string tmxString, const std::string& resourcePath);
     /** initializes parsing of an XML file, either a tmx (Map) file or tsx (Tileset) file */
     bool parseXMLFile(const std::string& xmlFilename);
-    /* initializes parsing of an XML string, either a tmx (Map) string or tsx (Tileset) string */
-    bool parseXMLString(const std::string& xmlString);
+    /* initializes parsing of an XML string, either a tmx (Map) string or tsx (Tileset) string. The string is parsed in place */
+    bool parseXMLString(std::string xmlString);
 
     ValueMapIntKey& getTileProperties() { return _tileProperties; };
     void setTileProperties(const ValueMapIntKey& tileProperties) {
@@ -77,6 +77,7 @@ cocos2d.cpp \
 2d/CCSpriteFrame.cpp \
 2d/CCSpriteFrameCache.cpp \
 2d/CCTMXLayer.cpp \
+2d/CCTMXBakedLayer.cpp \
 2d/CCTMXObjectGroup.cpp \
 2d/CCTMXTiledMap.cpp \
 2d/CCTMXXMLParser.cpp \
@@ -107,6 +108,7 @@ math/Vec4.cpp \
 base/CCNinePatchImageParser.cpp \
 base/CCStencilStateManager.cpp \
 base/CCAsyncTaskPool.cpp \
+base/CCJobSystem.cpp \
 base/CCAutoreleasePool.cpp \
 base/CCConfiguration.cpp \
 base/CCConsole.cpp \
@@ -137,6 +139,7 @@ base/CCNS.cpp \
 base/CCProfiling.cpp \
 base/CCProperties.cpp \
 base/CCRef.cpp \
+base/CCRefPool.cpp \
 base/CCScheduler.cpp \
 base/CCScriptSupport.cpp \
 base/CCTouch.cpp \
@@ -53,6 +53,7 @@ Configuration::Configuration()
 , _supportsOESDepth24(false)
 , _supportsOESPackedDepthStencil(false)
 , _supportsOESMapBuffer(false)
+, _supportsMapBufferRange(false)
 , _maxSamplesAllowed(0)
 , _maxTextureUnits(0)
 , _glExtensions(nullptr)
@@ -161,6 +162,13 @@ void Configuration::gatherGPUInfo()
     _supportsOESMapBuffer = checkForGLExtension("GL_OES_mapbuffer");
     _valueDict["gl.supports_OES_map_buffer"] = Value(_supportsOESMapBuffer);
 
+#ifdef CC_PLATFORM_PC
+    _supportsMapBufferRange = checkForGLExtension("GL_ARB_map_buffer_range");
+#else
+    _supportsMapBufferRange = checkForGLExtension("GL_EXT_map_buffer_range");
+#endif
+    _valueDict["gl.supports_map_buffer_range"] = Value(_supportsMapBufferRange);
+
     _supportsOESDepth24 = checkForGLExtension("GL_OES_depth24");
     _valueDict["gl.supports_OES_depth24"] = Value(_supportsOESDepth24);
 
@@ -295,6 +303,16 @@ bool Configuration::supportsMapBuffer() const
 #endif
 }
 
+bool Configuration::supportsMapBufferRange() const
+{
+#if CC_RENDERER_STREAM_BUFFER
+    // Mappings are released with glUnmapBuffer(), which GL ES only has with GL_OES_mapbuffer.
+    return _supportsMapBufferRange && supportsMapBuffer();
+#else
+    return false;
+#endif
+}
+
 bool Configuration::supportsOESDepth24() const
 {
     return _supportsOESDepth24;
@@ -171,6 +171,15 @@ public:
      */
     bool supportsMapBuffer() const;
 
+    /** Whether or not glMapBufferRange() is supported.
+     *
+     * On Desktop it checks for the extension `GL_ARB_map_buffer_range`.
+     * On Mobile it checks for the extension `GL_EXT_map_buffer_range`.
+     *
+     * @return Whether or not `glMapBufferRange()` is supported.
+     */
+    bool supportsMapBufferRange() const;
+
     
     /** Max support directional light in shader, for Sprite3D.
      *
@@ -259,6 +268,7 @@ protected:
     bool            _supportsDiscardFramebuffer;
     bool            _supportsShareableVAO;
     bool            _supportsOESMapBuffer;
+    bool            _supportsMapBufferRange;
     bool            _supportsOESDepth24;
     bool            _supportsOESPackedDepthStencil;
     
@@ -69,6 +69,7 @@
 #include "base/base64.h"
 #include "base/ccUtils.h"
 #include "base/allocator/CCAllocatorDiagnostics.h"
+#include "base/CCProfiling.h"
 NS_CC_BEGIN
 
 extern const char* cocos2dVersion(void);
@@ -506,6 +507,7 @@ Console::Console()
     createCommandSceneGraph();
     createCommandTexture();
     createCommandTouch();
+    createCommandTrace();
     createCommandUpload();
     createCommandVersion();
 }
@@ -1120,6 +1122,18 @@ void Console::createCommandTouch()
         CC_CALLBACK_2(Console::commandTouchSubCommandSwipe, this)});
 }
 
+void Console::createCommandTrace()
+{
+    addCommand({"trace", "Capture frame-phase trace markers. Args: [-h | help | start | stop | dump [filename] | ]",
+        CC_CALLBACK_2(Console::commandTrace, this)});
+    addSubCommand("trace", {"start", "Discard the previous capture and start recording trace markers.",
+        CC_CALLBACK_2(Console::commandTraceSubCommandStart, this)});
+    addSubCommand("trace", {"stop", "Stop recording trace markers.",
+        CC_CALLBACK_2(Console::commandTraceSubCommandStop, this)});
+    addSubCommand("trace", {"dump", "trace dump [filename]: stop and write the capture as Chrome trace JSON to the writable path.",
+        CC_CALLBACK_2(Console::commandTraceSubCommandDump, this)});
+}
+
 void Console::createCommandUpload()
 {
     addCommand({"upload", "upload file. Args: [filename base64_encoded_data]", CC_CALLBACK_1(Console::commandUpload, this)});
@@ -1343,6 +1357,37 @@ void Console::commandTexturesSubCommandFlush(int /*fd*/, const std::string& /*ar
     });
 }
 
+void Console::commandTrace(int fd, const std::string& /*args*/)
+{
+    Console::Utility::mydprintf(fd, "Trace is: %s\n", TraceProfiler::isTracing() ? "recording" : "stopped");
+}
+
+void Console::commandTraceSubCommandStart(int /*fd*/, const std::string& /*args*/)
+{
+    TraceProfiler::getInstance()->start();
+}
+
+void Console::commandTraceSubCommandStop(int /*fd*/, const std::string& /*args*/)
+{
+    TraceProfiler::getInstance()->stop();
+}
+
+void Console::commandTraceSubCommandDump(int fd, const std::string& args)
+{
+    auto argv = Console::Utility::split(args, ' ');
+    char defaultName[64];
+    snprintf(defaultName, sizeof(defaultName), "trace-%ld.json", (long)time(nullptr));
+    std::string filename = argv.size() > 1 ? argv[1] : defaultName;
+    auto fullPath = FileUtils::getInstance()->getWritablePath() + filename;
+
+    auto profiler = TraceProfiler::getInstance();
+    profiler->stop();
+    if (profiler->dumpChromeTrace(fullPath))
+        Console::Utility::mydprintf(fd, "Trace written to: %s\n", fullPath.c_str());
+    else
+        Console::Utility::mydprintf(fd, "Failed to write trace to: %s\n", fullPath.c_str());
+}
+
 void Console::commandTouchSubCommandTap(int fd, const std::string& args)
 {
     auto argv = Console::Utility::split(args,' ');
@@ -1594,7 +1639,7 @@ void Console::printFileUtils(int fd)
     Console::Utility::mydprintf(fd, "%s\n", fu->getWritablePath().c_str());
     
     Console::Utility::mydprintf(fd, "\nFull Path Cache:\n");
-    auto& cache = fu->getFullPathCache();
+    auto cache = fu->getFullPathCache();
     for( const auto &item : cache) {
         Console::Utility::mydprintf(fd, "%s -> %s\n", item.first.c_str(), item.second.c_str());
     }
@@ -61,7 +61,10 @@ THE SOFTWARE.
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCJobSystem.h"
+#include "base/CCRefPool.h"
 #include "base/ObjectFactory.h"
+#include "base/CCProfiling.h"
 #include "platform/CCApplication.h"
 
 #if CC_ENABLE_SCRIPT_BINDING
@@ -89,6 +92,9 @@ NS_CC_BEGIN
 // singleton stuff
 static Director *s_SharedDirector = nullptr;
 
+// modelview stack of a thread visiting nodes for Renderer::visitConcurrently(), nullptr on other threads
+static thread_local std::stack<Mat4>* s_modelViewMatrixStack = nullptr;
+
 #define kDefaultFPS        60  // 60 frames per second
 extern const char* cocos2dVersion(void);
 
@@ -133,10 +139,15 @@ bool Director::init(void)
 
     _scenesStack.reserve(15);
 
+#if CC_ENABLE_TRACE_PROFILER
+    // Label the thread the director runs on in trace captures
+    TraceProfiler::getInstance()->setCurrentThreadName("cocos");
+#endif
+
     // FPS
     _accumDt = 0.0f;
     _frameRate = 0.0f;
-    _FPSLabel = _drawnBatchesLabel = _drawnVerticesLabel = nullptr;
+    _FPSLabel = _drawnBatchesLabel = _drawnVerticesLabel = _refAllocationsLabel = nullptr;
     _totalFrames = 0;
     _lastUpdate = std::chrono::steady_clock::now();
     
@@ -208,6 +219,7 @@ Director::~Director(void)
 
     CC_SAFE_RELEASE(_FPSLabel);
     CC_SAFE_RELEASE(_drawnVerticesLabel);
+    CC_SAFE_RELEASE(_refAllocationsLabel);
     CC_SAFE_RELEASE(_drawnBatchesLabel);
 
     CC_SAFE_RELEASE(_runningScene);
@@ -286,6 +298,8 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    CC_PROFILER_TRACE("Director::drawScene");
+
     // calculate "global" dt
     calculateDeltaTime();
     
@@ -480,6 +494,16 @@ void Director::setNextDeltaTimeZero(bool nextDeltaTimeZero)
 // MUST BE moved outside.
 // Why the Director must have this code ?
 //
+void Director::setModelViewMatrixStackForThread(std::stack<Mat4>* stack)
+{
+    s_modelViewMatrixStack = stack;
+}
+
+std::stack<Mat4>& Director::getModelViewMatrixStack()
+{
+    return s_modelViewMatrixStack ? *s_modelViewMatrixStack : _modelViewMatrixStack;
+}
+
 void Director::initMatrixStack()
 {
     while (!_modelViewMatrixStack.empty())
@@ -524,7 +548,7 @@ void Director::popMatrix(MATRIX_STACK_TYPE type)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.pop();
+        getModelViewMatrixStack().pop();
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -549,7 +573,7 @@ void Director::loadIdentityMatrix(MATRIX_STACK_TYPE type)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = Mat4::IDENTITY;
+        getModelViewMatrixStack().top() = Mat4::IDENTITY;
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -574,7 +598,7 @@ void Director::loadMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = mat;
+        getModelViewMatrixStack().top() = mat;
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -599,7 +623,7 @@ void Director::multiplyMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() *= mat;
+        getModelViewMatrixStack().top() *= mat;
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -624,7 +648,8 @@ void Director::pushMatrix(MATRIX_STACK_TYPE type)
 {
     if(type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        _modelViewMatrixStack.push(_modelViewMatrixStack.top());
+        auto& stack = getModelViewMatrixStack();
+        stack.push(stack.top());
     }
     else if(type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -649,7 +674,7 @@ const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type) const
 {
     if(type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        return _modelViewMatrixStack.top();
+        return s_modelViewMatrixStack ? s_modelViewMatrixStack->top() : _modelViewMatrixStack.top();
     }
     else if(type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -1108,6 +1133,7 @@ void Director::reset()
     CC_SAFE_RELEASE_NULL(_FPSLabel);
     CC_SAFE_RELEASE_NULL(_drawnBatchesLabel);
     CC_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+    CC_SAFE_RELEASE_NULL(_refAllocationsLabel);
     
     // purge bitmap cache
     FontFNT::purgeCachedData();
@@ -1138,6 +1164,7 @@ void Director::reset()
     GLProgramStateCache::destroyInstance();
     FileUtils::destroyInstance();
     AsyncTaskPool::destroyInstance();
+    JobSystem::destroyInstance();
     
     // cocos2d-x specific data structures
     UserDefault::destroyInstance();
@@ -1292,6 +1319,10 @@ void Director::showStats()
 
     static unsigned long prevCalls = 0;
     static unsigned long prevVerts = 0;
+#if CC_ENABLE_REF_POOL
+    static uint64_t prevAllocations = 0;
+    static unsigned long prevFrameAllocations = 0;
+#endif
 
     ++_frames;
     _accumDt += _deltaTime;
@@ -1326,6 +1357,22 @@ void Director::showStats()
         }
 
         const Mat4& identity = Mat4::IDENTITY;
+#if CC_ENABLE_REF_POOL
+        // allocations since the last frame, and Refs alive right now
+        auto refStats = RefPool::getStats();
+        auto currentAllocations = (unsigned long)(refStats.allocations - prevAllocations);
+        if (_refAllocationsLabel && currentAllocations != prevFrameAllocations)
+        {
+            sprintf(buffer, "Refs:%5lu/%7lu", currentAllocations,
+                    (unsigned long)(refStats.allocations - refStats.deallocations));
+            _refAllocationsLabel->setString(buffer);
+            prevFrameAllocations = currentAllocations;
+        }
+        prevAllocations = refStats.allocations;
+
+        if (_refAllocationsLabel)
+            _refAllocationsLabel->visit(_renderer, identity, 0);
+#endif
         _drawnVerticesLabel->visit(_renderer, identity, 0);
         _drawnBatchesLabel->visit(_renderer, identity, 0);
         _FPSLabel->visit(_renderer, identity, 0);
@@ -1355,15 +1402,19 @@ void Director::createStatsLabel()
     std::string fpsString = "00.0";
     std::string drawBatchString = "000";
     std::string drawVerticesString = "00000";
+    std::string refAllocationsString = "00000";
     if (_FPSLabel)
     {
         fpsString = _FPSLabel->getString();
         drawBatchString = _drawnBatchesLabel->getString();
         drawVerticesString = _drawnVerticesLabel->getString();
+        if (_refAllocationsLabel)
+            refAllocationsString = _refAllocationsLabel->getString();
         
         CC_SAFE_RELEASE_NULL(_FPSLabel);
         CC_SAFE_RELEASE_NULL(_drawnBatchesLabel);
         CC_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+        CC_SAFE_RELEASE_NULL(_refAllocationsLabel);
         _textureCache->removeTextureForKey("/cc_fps_images");
         FileUtils::getInstance()->purgeCachedEntries();
     }
@@ -1414,10 +1465,19 @@ void Director::createStatsLabel()
     _drawnVerticesLabel->initWithString(drawVerticesString, texture, 12, 32, '.');
     _drawnVerticesLabel->setScale(scaleFactor);
 
+#if CC_ENABLE_REF_POOL
+    _refAllocationsLabel = LabelAtlas::create();
+    _refAllocationsLabel->retain();
+    _refAllocationsLabel->setIgnoreContentScaleFactor(true);
+    _refAllocationsLabel->initWithString(refAllocationsString, texture, 12, 32, '.');
+    _refAllocationsLabel->setScale(scaleFactor);
+#endif
 
     Texture2D::setDefaultAlphaPixelFormat(currentFormat);
 
     const int height_spacing = 22 / CC_CONTENT_SCALE_FACTOR();
+    if (_refAllocationsLabel)
+        _refAllocationsLabel->setPosition(Vec2(0, height_spacing*3) + CC_DIRECTOR_STATS_POSITION);
     _drawnVerticesLabel->setPosition(Vec2(0, height_spacing*2) + CC_DIRECTOR_STATS_POSITION);
     _drawnBatchesLabel->setPosition(Vec2(0, height_spacing*1) + CC_DIRECTOR_STATS_POSITION);
     _FPSLabel->setPosition(Vec2(0, height_spacing*0)+CC_DIRECTOR_STATS_POSITION);
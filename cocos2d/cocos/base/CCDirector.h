@@ -546,6 +546,14 @@ public:
      */
     const Mat4& getMatrix(MATRIX_STACK_TYPE type) const;
 
+    /**
+     * Makes the modelview matrix functions use `stack` when called from the calling thread, or the Director's
+     * own stack again if `stack` is nullptr. Used by Renderer::visitConcurrently() so nodes visited on worker
+     * threads don't share the stack.
+     * @js NA
+     */
+    void setModelViewMatrixStackForThread(std::stack<Mat4>* stack);
+
     /**
      * Gets the top matrix of projection matrix stack.
      * @param index The index of projection matrix stack.
@@ -615,6 +623,9 @@ protected:
 
     void initMatrixStack();
 
+    // the modelview stack of the calling thread, see setModelViewMatrixStackForThread()
+    std::stack<Mat4>& getModelViewMatrixStack();
+
     std::stack<Mat4> _modelViewMatrixStack;
     /** In order to support GL MultiView features, we need to use the matrix array,
         but we don't know the number of MultiView, so using the vector instead.
@@ -662,6 +673,8 @@ protected:
     LabelAtlas *_FPSLabel;
     LabelAtlas *_drawnBatchesLabel;
     LabelAtlas *_drawnVerticesLabel;
+    /* Ref allocations per frame, only shown when CC_ENABLE_REF_POOL is enabled */
+    LabelAtlas *_refAllocationsLabel;
     
     /** Whether or not the Director is paused */
     bool _paused;
@@ -108,10 +108,107 @@ static EventListener::ListenerID __getListenerID(Event* event)
     return ret;
 }
 
+// Gets the nodes from `node` up to the root of its scene graph.
+static void getPathToRoot(Node* node, std::vector<Node*>& path)
+{
+    path.clear();
+    for (; node != nullptr; node = node->getParent())
+    {
+        path.push_back(node);
+    }
+}
+
+bool EventDispatcher::isSceneGraphOrderedBefore(Node* n1, Node* n2, Node* rootNode)
+{
+    static std::vector<Node*> path1;
+    static std::vector<Node*> path2;
+    getPathToRoot(n1, path1);
+    getPathToRoot(n2, path2);
+    
+    if (path1.empty() || path1.back() != rootNode)
+        return false;
+    if (path2.empty() || path2.back() != rootNode)
+        return true;
+    
+    if (n1->getGlobalZOrder() != n2->getGlobalZOrder())
+        return n1->getGlobalZOrder() > n2->getGlobalZOrder();
+    
+    // Walk down from the root to the lowest common ancestor.
+    auto i1 = path1.size() - 1;
+    auto i2 = path2.size() - 1;
+    while (i1 > 0 && i2 > 0 && path1[i1 - 1] == path2[i2 - 1])
+    {
+        --i1;
+        --i2;
+    }
+    
+    if (i1 == 0 && i2 == 0)
+        return false;
+    
+    // One node is an ancestor of the other.
+    if (i1 == 0)
+        return path2[i2 - 1]->getLocalZOrder() < 0;
+    if (i2 == 0)
+        return path1[i1 - 1]->getLocalZOrder() >= 0;
+    
+    // Siblings, which Node::sortNodes orders by local Z order and then order of arrival.
+    return path1[i1 - 1]->_localZOrder$Arrival > path2[i2 - 1]->_localZOrder$Arrival;
+}
+
+// The touch grid splits the screen in 8 x 8 cells, so the cells a node covers fit in the bits of a uint64_t.
+static const int TOUCH_GRID_SIZE = 8;
+
+// Gets the column or row of the touch grid a coordinate falls in. Coordinates off screen fall in the border cells.
+static int getTouchGridIndex(float coordinate, float length)
+{
+    return clampf(coordinate * TOUCH_GRID_SIZE / length, 0, TOUCH_GRID_SIZE - 1);
+}
+
+// Gets the cells of the touch grid covered by the content rect of `node` as seen by `camera`.
+static uint64_t getTouchGridCells(Node* node, const Camera* camera)
+{
+    const uint64_t allCells = ~uint64_t(0);
+    
+    const auto& size = node->getContentSize();
+    if (size.width <= 0 || size.height <= 0)
+        return allCells;
+    
+    const auto winSize = Director::getInstance()->getWinSize();
+    const auto transform = camera->getViewProjectionMatrix() * node->getNodeToWorldTransform();
+    const Vec2 corners[] = { Vec2::ZERO, Vec2(size.width, 0), Vec2(0, size.height), Vec2(size.width, size.height) };
+    
+    // Same projection as Camera::projectGL. The box of the projected corners is all the hit test can accept.
+    Vec2 min(FLT_MAX, FLT_MAX);
+    Vec2 max(-FLT_MAX, -FLT_MAX);
+    for (const auto& corner : corners)
+    {
+        Vec4 clip;
+        transform.transformVector(Vec4(corner.x, corner.y, 0, 1), &clip);
+        if (clip.w <= 0)
+            return allCells;
+        
+        const Vec2 screen(winSize.width * (clip.x / clip.w + 1) * 0.5f, winSize.height * (clip.y / clip.w + 1) * 0.5f);
+        min.set(std::min(min.x, screen.x), std::min(min.y, screen.y));
+        max.set(std::max(max.x, screen.x), std::max(max.y, screen.y));
+    }
+    
+    const int x0 = getTouchGridIndex(min.x, winSize.width);
+    const int x1 = getTouchGridIndex(max.x, winSize.width);
+    const uint64_t row = ((uint64_t(1) << (x1 - x0 + 1)) - 1) << x0;
+    
+    uint64_t cells = 0;
+    for (int y = getTouchGridIndex(min.y, winSize.height), y1 = getTouchGridIndex(max.y, winSize.height); y <= y1; ++y)
+    {
+        cells |= row << (y * TOUCH_GRID_SIZE);
+    }
+    return cells;
+}
+
 EventDispatcher::EventListenerVector::EventListenerVector() :
  _fixedListeners(nullptr),
  _sceneGraphListeners(nullptr),
- _gt0Index(0)
+ _gt0Index(0),
+ _sceneGraphRoot(nullptr)
 {
 }
 
@@ -202,7 +299,7 @@ void EventDispatcher::EventListenerVector::clear()
 EventDispatcher::EventDispatcher()
 : _inDispatch(0)
 , _isEnabled(false)
-, _nodePriorityIndex(0)
+, _touchHitStamp(0)
 {
     _toAddedListeners.reserve(50);
     _toRemovedListeners.reserve(50);
@@ -222,75 +319,6 @@ EventDispatcher::~EventDispatcher()
     removeAllEventListeners();
 }
 
-void EventDispatcher::visitTarget(Node* node, bool isRootNode)
-{
-    node->sortAllChildren();
-    
-    int i = 0;
-    auto& children = node->getChildren();
-    
-    auto childrenCount = children.size();
-    
-    if(childrenCount > 0)
-    {
-        Node* child = nullptr;
-        // visit children zOrder < 0
-        for( ; i < childrenCount; i++ )
-        {
-            child = children.at(i);
-            
-            if ( child && child->getLocalZOrder() < 0 )
-                visitTarget(child, false);
-            else
-                break;
-        }
-        
-        if (_nodeListenersMap.find(node) != _nodeListenersMap.end())
-        {
-            _globalZOrderNodeMap[node->getGlobalZOrder()].push_back(node);
-        }
-        
-        for( ; i < childrenCount; i++ )
-        {
-            child = children.at(i);
-            if (child)
-                visitTarget(child, false);
-        }
-    }
-    else
-    {
-        if (_nodeListenersMap.find(node) != _nodeListenersMap.end())
-        {
-            _globalZOrderNodeMap[node->getGlobalZOrder()].push_back(node);
-        }
-    }
-    
-    if (isRootNode)
-    {
-        std::vector<float> globalZOrders;
-        globalZOrders.reserve(_globalZOrderNodeMap.size());
-        
-        for (const auto& e : _globalZOrderNodeMap)
-        {
-            globalZOrders.push_back(e.first);
-        }
-        
-        std::stable_sort(globalZOrders.begin(), globalZOrders.end(), [](const float a, const float b){
-            return a < b;
-        });
-        
-        for (const auto& globalZ : globalZOrders)
-        {
-            for (const auto& n : _globalZOrderNodeMap[globalZ])
-            {
-                _nodePriorityMap[n] = ++_nodePriorityIndex;
-            }
-        }
-        
-        _globalZOrderNodeMap.clear();
-    }
-}
-
 void EventDispatcher::pauseEventListenersForTarget(Node* target, bool recursive/* = false */)
 {
     auto listenerIter = _nodeListenersMap.find(target);
@@ -300,6 +328,10 @@ void EventDispatcher::pauseEventListenersForTarget(Node* target, bool recursive/
         for (auto& l : *listeners)
         {
             l->setPaused(true);
+
+            // The node is usually leaving the scene, so the listener can't be kept where it was when sorting
+            l->_sceneGraphOrderDirty = true;
+            setDirty(l->getListenerID(), DirtyFlag::SCENE_GRAPH_PRIORITY);
         }
     }
 
@@ -341,7 +373,11 @@ void EventDispatcher::resumeEventListenersForTarget(Node* target, bool recursive
         }
     }
 
-    setDirtyForNode(target);
+    // Only the listeners of the target need to find their place again, its children are resumed on their own.
+    if (listenerIter != _nodeListenersMap.end())
+    {
+        _dirtyNodes.insert(target);
+    }
     
     if (recursive)
     {
@@ -357,7 +393,6 @@ void EventDispatcher::removeEventListenersForTarget(Node* target, bool recursive
 {
     // Ensure the node is removed from these immediately also.
     // Don't want any dangling pointers or the possibility of dealing with deleted objects..
-    _nodePriorityMap.erase(target);
     _dirtyNodes.erase(target);
 
     auto listenerIter = _nodeListenersMap.find(target);
@@ -481,6 +516,7 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
     
     if (listener->getFixedPriority() == 0)
     {
+        listener->_sceneGraphOrderDirty = true;
         setDirty(listenerID, DirtyFlag::SCENE_GRAPH_PRIORITY);
         
         auto node = listener->getAssociatedNode();
@@ -552,13 +588,6 @@ void EventDispatcher::debugCheckNodeHasNoEventListenersOnDestruction(Node* node)
         }
     }
     
-    // Check the node priority map
-    for (const auto & keyValuePair : _nodePriorityMap)
-    {
-        CCASSERT(keyValuePair.first != node,
-                 "Node should have no event listeners registered for it upon destruction!");
-    }
-    
     // Check the to be added list
     for (EventListener * listener : _toAddedListeners)
     {
@@ -965,6 +994,9 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
     
     bool isNeedsMutableSet = (oneByOneListeners && allAtOnceListeners);
     
+    // Nodes may have moved since the last touch.
+    ++_touchHitStamp;
+    
     const std::vector<Touch*>& originalTouches = event->getTouches();
     std::vector<Touch*> mutableTouches(originalTouches.size());
     std::copy(originalTouches.begin(), originalTouches.end(), mutableTouches.begin());
@@ -996,8 +1028,11 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
                 
                 if (eventCode == EventTouch::EventCode::BEGAN)
                 {
-                    if (listener->onTouchBegan)
+                    // Hit test filtered listeners would reject touches outside of their cells anyway.
+                    if (listener->onTouchBegan && (!listener->_hitTestFiltered || isTouchInHitCells(listener, touches)))
                     {
+                        // The callback may move nodes around.
+                        ++_touchHitStamp;
                         isClaimed = listener->onTouchBegan(touches, event);
                         if (isClaimed && listener->_isRegistered)
                         {
@@ -1144,6 +1179,25 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
     updateListeners(event);
 }
 
+bool EventDispatcher::isTouchInHitCells(EventListenerTouchOneByOne* listener, Touch* touch)
+{
+    auto camera = Camera::getVisitingCamera();
+    if (camera == nullptr || listener->_node == nullptr)
+        return true;
+    
+    if (listener->_hitCellsStamp != _touchHitStamp || listener->_hitCellsCamera != camera)
+    {
+        listener->_hitCells = getTouchGridCells(listener->_node, camera);
+        listener->_hitCellsCamera = camera;
+        listener->_hitCellsStamp = _touchHitStamp;
+    }
+    
+    const auto winSize = Director::getInstance()->getWinSize();
+    const auto& location = touch->getLocation();
+    const int cell = getTouchGridIndex(location.y, winSize.height) * TOUCH_GRID_SIZE + getTouchGridIndex(location.x, winSize.width);
+    return (listener->_hitCells >> cell) & 1;
+}
+
 void EventDispatcher::updateListeners(Event* event)
 {
     CCASSERT(_inDispatch > 0, "If program goes here, there should be event in dispatch.");
@@ -1267,6 +1321,7 @@ void EventDispatcher::updateDirtyFlagForSceneGraph()
             {
                 for (auto& l : *iter->second)
                 {
+                    l->_sceneGraphOrderDirty = true;
                     setDirty(l->getListenerID(), DirtyFlag::SCENE_GRAPH_PRIORITY);
                 }
             }
@@ -1322,22 +1377,39 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(const EventListener
     if (sceneGraphListeners == nullptr)
         return;
 
-    // Reset priority index
-    _nodePriorityIndex = 0;
-    _nodePriorityMap.clear();
-
-    visitTarget(rootNode, true);
+    // Listeners whose node hasn't moved in the scene graph are still in order, only the others need to find
+    // their place again. Removed listeners that are still waiting to be cleaned up have no node and go last.
+    auto moved = sceneGraphListeners->begin();
+    if (listeners->getSceneGraphRoot() == rootNode)
+    {
+        auto isInOrder = [](const EventListener* l) {
+            return !l->_sceneGraphOrderDirty && l->_node != nullptr;
+        };
+        
+        if (std::all_of(sceneGraphListeners->begin(), sceneGraphListeners->end(), isInOrder))
+            return;
+        
+        moved = std::stable_partition(sceneGraphListeners->begin(), sceneGraphListeners->end(), isInOrder);
+    }
+    listeners->setSceneGraphRoot(rootNode);
     
     // After sort: priority < 0, > 0
-    std::stable_sort(sceneGraphListeners->begin(), sceneGraphListeners->end(), [this](const EventListener* l1, const EventListener* l2) {
-        return _nodePriorityMap[l1->getAssociatedNode()] > _nodePriorityMap[l2->getAssociatedNode()];
-    });
+    auto isDrawnAfter = [rootNode](const EventListener* l1, const EventListener* l2) {
+        return isSceneGraphOrderedBefore(l1->_node, l2->_node, rootNode);
+    };
+    std::stable_sort(moved, sceneGraphListeners->end(), isDrawnAfter);
+    std::inplace_merge(sceneGraphListeners->begin(), moved, sceneGraphListeners->end(), isDrawnAfter);
+    
+    for (auto& l : *sceneGraphListeners)
+    {
+        l->_sceneGraphOrderDirty = false;
+    }
     
 #if DUMP_LISTENER_ITEM_PRIORITY_INFO
     log("-----------------------------------");
     for (auto& l : *sceneGraphListeners)
     {
-        log("listener priority: node ([%s]%p), priority (%d)", typeid(*l->_node).name(), l->_node, _nodePriorityMap[l->_node]);
+        log("listener priority: node ([%s]%p)", l->_node ? typeid(*l->_node).name() : "null", l->_node);
     }
 #endif
 }
@@ -49,6 +49,8 @@ class EventTouch;
 class Node;
 class EventCustom;
 class EventListenerCustom;
+class EventListenerTouchOneByOne;
+class Touch;
 
 /** @class EventDispatcher
 * @brief This class manages event listener subscriptions
@@ -231,10 +233,14 @@ protected:
         std::vector<EventListener*>* getSceneGraphPriorityListeners() const { return _sceneGraphListeners; }
         ssize_t getGt0Index() const { return _gt0Index; }
         void setGt0Index(ssize_t index) { _gt0Index = index; }
+        Node* getSceneGraphRoot() const { return _sceneGraphRoot; }
+        void setSceneGraphRoot(Node* root) { _sceneGraphRoot = root; }
     private:
         std::vector<EventListener*>* _fixedListeners;
         std::vector<EventListener*>* _sceneGraphListeners;
         ssize_t _gt0Index;
+        Node* _sceneGraphRoot; // the scene _sceneGraphListeners were last sorted for, only compared against
+
     };
     
     /** Adds an event listener with item
@@ -261,9 +267,17 @@ protected:
     /** Sort event listener */
     void sortEventListeners(const EventListener::ListenerID& listenerID);
     
-    /** Sorts the listeners of specified type by scene graph priority */
+    /** Sorts the listeners of specified type by scene graph priority.
+     *  Only listeners whose node moved in the scene graph are placed again, unless the running scene changed.
+     */
     void sortEventListenersOfSceneGraphPriority(const EventListener::ListenerID& listenerID, Node* rootNode);
     
+    /** Checks whether the listeners of n1 go before the ones of n2. Nodes go by global Z order and then in the
+     *  order the scene graph is drawn: a node after its children with a negative local Z order and before the
+     *  others. Nodes outside of the running scene go last.
+     */
+    static bool isSceneGraphOrderedBefore(Node* n1, Node* n2, Node* rootNode);
+    
     /** Sorts the listeners of specified type by fixed priority */
     void sortEventListenersOfFixedPriority(const EventListener::ListenerID& listenerID);
     
@@ -309,8 +323,10 @@ protected:
     /** Sets the dirty flag for a specified listener ID */
     void setDirty(const EventListener::ListenerID& listenerID, DirtyFlag flag);
     
-    /** Walks though scene graph to get the draw order for each node, it's called before sorting event listener with scene graph priority */
-    void visitTarget(Node* node, bool isRootNode);
+    /** Checks whether a touch lands in the cells of the touch grid covered by the node of a hit test filtered
+     *  listener, as seen by the visiting camera. Touches that don't can be skipped without calling onTouchBegan.
+     */
+    bool isTouchInHitCells(EventListenerTouchOneByOne* listener, Touch* touch);
 
     /** Remove all listeners in _toRemoveListeners list and cleanup */
     void cleanToRemovedListeners();
@@ -324,12 +340,6 @@ protected:
     /** The map of node and event listeners */
     std::unordered_map<Node*, std::vector<EventListener*>*> _nodeListenersMap;
     
-    /** The map of node and its event priority */
-    std::unordered_map<Node*, int> _nodePriorityMap;
-    
-    /** key: Global Z Order, value: Sorted Nodes */
-    std::unordered_map<float, std::vector<Node*>> _globalZOrderNodeMap;
-    
     /** The listeners to be added after dispatching event */
     std::vector<EventListener*> _toAddedListeners;
 
@@ -345,7 +355,8 @@ protected:
     /** Whether to enable dispatching event */
     bool _isEnabled;
     
-    int _nodePriorityIndex;
+    /** Changes whenever nodes may have moved during touch dispatch, which invalidates the hit cells of listeners */
+    unsigned int _touchHitStamp;
     
     std::set<std::string> _internalCustomListenerIDs;
 };
@@ -174,6 +174,7 @@ protected:
     Node* _node;            // scene graph based priority
     bool _paused;           // Whether the listener is paused
     bool _isEnabled;        // Whether the listener is enabled
+    bool _sceneGraphOrderDirty; // Whether the listener needs to be moved to its place in the scene graph order
     friend class EventDispatcher;
 };
 
@@ -40,6 +40,10 @@ EventListenerTouchOneByOne::EventListenerTouchOneByOne()
 , onTouchEnded(nullptr)
 , onTouchCancelled(nullptr)
 , _needSwallow(false)
+, _hitTestFiltered(false)
+, _hitCells(0)
+, _hitCellsCamera(nullptr)
+, _hitCellsStamp(0)
 {
 }
 
@@ -68,6 +72,16 @@ bool EventListenerTouchOneByOne::isSwallowTouches()
     return _needSwallow;
 }
 
+void EventListenerTouchOneByOne::setHitTestFiltered(bool hitTestFiltered)
+{
+    _hitTestFiltered = hitTestFiltered;
+}
+
+bool EventListenerTouchOneByOne::isHitTestFiltered() const
+{
+    return _hitTestFiltered;
+}
+
 EventListenerTouchOneByOne* EventListenerTouchOneByOne::create()
 {
     auto ret = new (std::nothrow) EventListenerTouchOneByOne();
@@ -109,6 +123,7 @@ EventListenerTouchOneByOne* EventListenerTouchOneByOne::clone()
         
         ret->_claimedTouches = _claimedTouches;
         ret->_needSwallow = _needSwallow;
+        ret->_hitTestFiltered = _hitTestFiltered;
     }
     else
     {
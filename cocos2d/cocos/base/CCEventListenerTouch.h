@@ -38,6 +38,7 @@
 NS_CC_BEGIN
 
 class Touch;
+class Camera;
 
 /** @class EventListenerTouchOneByOne
  * @brief Single touch event listener.
@@ -68,6 +69,21 @@ public:
      * @return True if needs to swall touches.
      */
     bool isSwallowTouches();
+
+    /** Whether or not to skip touches outside of the associated node.
+     *
+     * When enabled, onTouchBegan is only called for touches that land near the content rect of the associated
+     * node, as seen by the visiting camera. This saves the callback for listeners that reject those touches
+     * anyway, like the ones of ui::Widget, and keeps touch dispatch fast with many of them.
+     *
+     * @param hitTestFiltered True if touches outside of the associated node can be skipped.
+     */
+    void setHitTestFiltered(bool hitTestFiltered);
+    /** Whether or not touches outside of the associated node are skipped.
+     *
+     * @return True if touches outside of the associated node are skipped.
+     */
+    bool isHitTestFiltered() const;
     
     /// Overrides
     virtual EventListenerTouchOneByOne* clone() override;
@@ -91,6 +107,13 @@ CC_CONSTRUCTOR_ACCESS:
 private:
     std::vector<Touch*> _claimedTouches;
     bool _needSwallow;
+    bool _hitTestFiltered;
+    
+    // Cells of the EventDispatcher touch grid covered by the associated node, and the camera and dispatch they
+    // were computed for.
+    uint64_t _hitCells;
+    const Camera* _hitCellsCamera;
+    unsigned int _hitCellsStamp;
     
     friend class EventDispatcher;
 };
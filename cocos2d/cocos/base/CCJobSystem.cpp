@@ -0,0 +1,145 @@
+/****************************************************************************
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CCJobSystem.h"
+#include "base/ccConfig.h"
+
+#include <algorithm>
+
+NS_CC_BEGIN
+
+JobSystem* JobSystem::s_jobSystem = nullptr;
+
+// set while a thread runs jobs, so parallelFor() called from inside a job doesn't wait on itself
+static thread_local bool s_insideJob = false;
+
+JobSystem* JobSystem::getInstance()
+{
+    if (s_jobSystem == nullptr)
+    {
+        s_jobSystem = new (std::nothrow) JobSystem();
+    }
+    return s_jobSystem;
+}
+
+void JobSystem::destroyInstance()
+{
+    delete s_jobSystem;
+    s_jobSystem = nullptr;
+}
+
+JobSystem::JobSystem()
+: _job(nullptr)
+, _count(0)
+, _next(0)
+, _generation(0)
+, _busy(0)
+, _quit(false)
+{
+    // one core is left for the other threads of the process, the calling thread is counted as a worker
+    unsigned int cores = std::thread::hardware_concurrency();
+    unsigned int count = std::min(cores > 2 ? cores - 2 : 0u, (unsigned int)CC_JOB_SYSTEM_THREADS);
+
+    for (unsigned int i = 0; i < count; ++i)
+        _workers.emplace_back(&JobSystem::workerLoop, this);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _workAvailable.notify_all();
+
+    for (auto& worker : _workers)
+        worker.join();
+}
+
+void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& job)
+{
+    if (count == 0)
+        return;
+
+    if (_workers.empty() || count == 1 || s_insideJob)
+    {
+        for (size_t i = 0; i < count; ++i)
+            job(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = &job;
+        _count = count;
+        _next = 0;
+        ++_generation;
+    }
+    _workAvailable.notify_all();
+
+    runJobs();
+
+    // Workers that wake up after `_job` is cleared skip this generation, so `job` isn't used after returning.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _workDone.wait(lock, [this]() { return _busy == 0; });
+    _job = nullptr;
+}
+
+void JobSystem::runJobs()
+{
+    s_insideJob = true;
+    for (size_t i = _next++; i < _count; i = _next++)
+        (*_job)(i);
+    s_insideJob = false;
+}
+
+void JobSystem::workerLoop()
+{
+    unsigned int generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workAvailable.wait(lock, [&]() { return _quit || generation != _generation; });
+            if (_quit)
+                return;
+
+            generation = _generation;
+            if (_job == nullptr)
+                continue;
+            ++_busy;
+        }
+
+        runJobs();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_busy;
+        }
+        _workDone.notify_one();
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCJOB_SYSTEM_H_
+#define __CCJOB_SYSTEM_H_
+
+#include "platform/CCPlatformMacros.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+* @addtogroup base
+* @{
+*/
+NS_CC_BEGIN
+
+/**
+ * @class JobSystem
+ * @brief Runs short, data-parallel jobs on a fixed set of worker threads, e.g. to visit parts of the scene
+ * graph concurrently. Unlike AsyncTaskPool, the caller blocks until the jobs are done and takes part in them.
+ * @js NA
+ */
+class CC_DLL JobSystem
+{
+public:
+    /**
+     * Returns the shared instance of the job system. Worker threads are started on the first call, see
+     * CC_JOB_SYSTEM_THREADS.
+     */
+    static JobSystem* getInstance();
+
+    /**
+     * Stops the worker threads and destroys the job system.
+     */
+    static void destroyInstance();
+
+    /**
+     * Calls `job(index)` for every index in [0, count) and returns once all calls have finished. Indices are
+     * handed out to the worker threads and the calling thread in increasing order, but may complete in any
+     * order. Must only be called from one thread at a time; nested calls from inside a job run serially.
+     *
+     * @param count Number of indices.
+     * @param job Function to call for each index.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& job);
+
+    /**
+     * Returns the number of threads jobs run on, including the calling thread.
+     */
+    unsigned int getThreadCount() const { return (unsigned int)_workers.size() + 1; }
+
+protected:
+    JobSystem();
+    ~JobSystem();
+
+    void workerLoop();
+    void runJobs();
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _workDone;
+
+    // the jobs being run, only changed while no worker is busy with them
+    const std::function<void(size_t)>* _job;
+    size_t _count;
+    std::atomic<size_t> _next;
+    unsigned int _generation;
+    unsigned int _busy;
+    bool _quit;
+
+    static JobSystem* s_jobSystem;
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CCJOB_SYSTEM_H_
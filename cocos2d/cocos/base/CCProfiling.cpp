@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "base/CCProfiling.h"
+#include "platform/CCFileUtils.h"
 
 using namespace std;
 
@@ -181,5 +182,163 @@ void ProfilingResetTimingBlock(const char *timerName)
     timer->reset();
 }
 
-NS_CC_END
+// implementation of TraceProfiler
+
+std::atomic<bool> TraceProfiler::s_tracing(false);
 
+TraceProfiler* TraceProfiler::getInstance()
+{
+    // Markers may fire on any thread, function-local statics are initialized exactly once
+    static TraceProfiler* s_sharedTraceProfiler = new (std::nothrow) TraceProfiler();
+    return s_sharedTraceProfiler;
+}
+
+TraceProfiler::TraceProfiler()
+: _captureStart(0)
+{
+}
+
+void TraceProfiler::start()
+{
+    stop();
+
+    // Heads belong to their threads, which may still be recording. Older events stay in the buffers and are
+    // skipped by getChromeTrace, which only dumps events that started after the capture.
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    _captureStart = now();
+    s_tracing.store(true, std::memory_order_release);
+}
+
+void TraceProfiler::stop()
+{
+    s_tracing.store(false, std::memory_order_release);
+}
+
+TraceProfiler::ThreadBuffer* TraceProfiler::getCurrentThreadBuffer()
+{
+    // Each thread registers its buffer once; after that recording never takes the lock.
+    static thread_local ThreadBuffer* s_threadBuffer = nullptr;
+    if (!s_threadBuffer)
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        _buffers.emplace_back(new (std::nothrow) ThreadBuffer(static_cast<unsigned int>(_buffers.size()) + 1));
+        s_threadBuffer = _buffers.back().get();
+    }
+
+    return s_threadBuffer;
+}
+
+void TraceProfiler::record(const char* name, const char* category, int64_t start, int64_t end)
+{
+    auto buffer = getCurrentThreadBuffer();
+
+    // The event storage is only allocated once a thread actually records something. It is swapped in under
+    // the lock getChromeTrace holds, the owning thread is the only one that checks it without.
+    if (!buffer->_slots)
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        buffer->_slots.reset(new (std::nothrow) Slot[BUFFER_CAPACITY]());
+        if (!buffer->_slots)
+            return;
+    }
+
+    auto head = buffer->_head.load(std::memory_order_relaxed);
+    auto& slot = buffer->_slots[head % BUFFER_CAPACITY];
+    slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(end - start, std::memory_order_relaxed);
+    slot.sequence.store(2 * head + 2, std::memory_order_release);
+    buffer->_head.store(head + 1, std::memory_order_release);
+}
+
+void TraceProfiler::setCurrentThreadName(const std::string& name)
+{
+    auto buffer = getCurrentThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    buffer->_name = name;
+}
+
+static void appendJSONString(std::string& out, const char* str)
+{
+    out += '"';
+    for (const char* c = str; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            out += '\\';
+        out += *c;
+    }
+    out += '"';
+}
+
+std::string TraceProfiler::getChromeTrace()
+{
+    std::string out;
+    out.reserve(256 * 1024);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    char buf[128];
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (const auto& buffer : _buffers)
+    {
+        if (!buffer->_name.empty())
+        {
+            snprintf(buf, sizeof(buf), "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":",
+                     first ? "" : ",", buffer->_tid);
+            out += buf;
+            appendJSONString(out, buffer->_name.c_str());
+            out += "}}";
+            first = false;
+        }
+
+        if (!buffer->_slots)
+            continue;
+
+        // Only the most recent BUFFER_CAPACITY events survive a wrapped buffer.
+        const auto head = buffer->_head.load(std::memory_order_acquire);
+        const auto count = std::min<uint64_t>(head, BUFFER_CAPACITY);
+        for (auto i = head - count; i < head; ++i)
+        {
+            const auto& slot = buffer->_slots[i % BUFFER_CAPACITY];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+            TraceEvent event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.category = slot.category.load(std::memory_order_relaxed);
+            event.start = slot.start.load(std::memory_order_relaxed);
+            event.duration = slot.duration.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // The thread wrapped around and started overwriting the slot while it was copied
+            if (sequence != 2 * i + 2 || slot.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            if (event.start < _captureStart)
+                continue;
+
+            out += first ? "{\"name\":" : ",{\"name\":";
+            appendJSONString(out, event.name);
+            out += ",\"cat\":";
+            appendJSONString(out, event.category);
+            snprintf(buf, sizeof(buf), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->_tid,
+                     (event.start - _captureStart) / 1000.0, event.duration / 1000.0);
+            out += buf;
+            first = false;
+        }
+    }
+
+    out += "]}";
+    return out;
+}
+
+bool TraceProfiler::dumpChromeTrace(const std::string& fullPath)
+{
+    return FileUtils::getInstance()->writeStringToFile(getChromeTrace(), fullPath);
+}
+
+NS_CC_END
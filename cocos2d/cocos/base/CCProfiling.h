@@ -31,6 +31,10 @@ THE SOFTWARE.
 
 #include <string>
 #include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "base/ccConfig.h"
 #include "base/CCRef.h"
 #include "base/CCMap.h"
@@ -159,6 +163,136 @@ extern bool kProfilerCategorySprite;
 extern bool kProfilerCategoryBatchSprite;
 extern bool kProfilerCategoryParticles;
 
+/** TraceProfiler
+ Frame-phase tracer that records scoped begin/end markers into per-thread ring buffers and dumps them in
+ the Chrome trace event format (chrome://tracing, ui.perfetto.dev).
+
+ Every thread that emits a marker owns a fixed-size ring buffer. Only the owning thread writes to it, so
+ recording is lock-free; the oldest events are overwritten once a buffer wraps. When tracing is stopped the
+ cost of a marker is a single relaxed atomic load.
+
+ To compile the markers out completely set CC_ENABLE_TRACE_PROFILER=0 in the ccConfig.h file.
+ */
+class CC_DLL TraceProfiler
+{
+public:
+    /** Number of events kept per thread before the ring buffer wraps. */
+    static const unsigned int BUFFER_CAPACITY = 8192;
+
+    struct TraceEvent
+    {
+        const char* name;
+        const char* category;
+        int64_t start;
+        int64_t duration;
+    };
+
+    /** returns the singleton
+     * @js NA
+     * @lua NA
+     */
+    static TraceProfiler* getInstance();
+
+    /** Whether markers are currently being recorded. This is what the scoped markers check on entry. */
+    static bool isTracing() { return s_tracing.load(std::memory_order_relaxed); }
+
+    /** Starts a new capture. Events recorded before it are left out of the dump. */
+    void start();
+
+    /** Stops the current capture. Recorded events are kept until the next start(). */
+    void stop();
+
+    /** Records a complete event. Timestamps are nanoseconds of the steady clock. */
+    void record(const char* name, const char* category, int64_t start, int64_t end);
+
+    /** Names the calling thread in the dumped trace. */
+    void setCurrentThreadName(const std::string& name);
+
+    /** Serializes the current capture as a Chrome trace / Perfetto JSON document. */
+    std::string getChromeTrace();
+
+    /** Writes getChromeTrace() to `fullPath`. Returns false if the file could not be written. */
+    bool dumpChromeTrace(const std::string& fullPath);
+
+    /** Current time in nanoseconds of the clock used by the markers. */
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    // One event of a ring buffer. The dump may read a slot while its thread overwrites it, so the fields are
+    // atomics and `sequence` works as a seqlock: odd while event `index` is written, 2 * index + 2 once done.
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence;
+        std::atomic<const char*> name;
+        std::atomic<const char*> category;
+        std::atomic<int64_t> start;
+        std::atomic<int64_t> duration;
+    };
+
+    class ThreadBuffer
+    {
+    public:
+        ThreadBuffer(unsigned int tid) : _tid(tid), _head(0) {}
+
+        unsigned int _tid;
+        std::string _name;
+        std::unique_ptr<Slot[]> _slots;
+        std::atomic<uint64_t> _head;
+    };
+
+    TraceProfiler();
+
+    ThreadBuffer* getCurrentThreadBuffer();
+
+    static std::atomic<bool> s_tracing;
+
+    std::mutex _buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    int64_t _captureStart;
+};
+
+/** Scoped marker used by CC_PROFILER_TRACE. Records from construction to destruction while tracing. */
+class CC_DLL ProfilingScopedTrace
+{
+public:
+    ProfilingScopedTrace(const char* name, const char* category = "cocos")
+    : _name(nullptr)
+    {
+        if (TraceProfiler::isTracing())
+        {
+            _name = name;
+            _category = category;
+            _start = TraceProfiler::now();
+        }
+    }
+
+    ~ProfilingScopedTrace()
+    {
+        if (_name)
+            TraceProfiler::getInstance()->record(_name, _category, _start, TraceProfiler::now());
+    }
+
+private:
+    const char* _name;
+    const char* _category;
+    int64_t _start;
+};
+
+#if CC_ENABLE_TRACE_PROFILER
+#define CC_PROFILER_TRACE_VAR_CONCAT(__a__, __b__) __a__##__b__
+#define CC_PROFILER_TRACE_VAR(__line__) CC_PROFILER_TRACE_VAR_CONCAT(__cc_trace_, __line__)
+#define CC_PROFILER_TRACE(__name__) NS_CC::ProfilingScopedTrace CC_PROFILER_TRACE_VAR(__LINE__)(__name__)
+#define CC_PROFILER_TRACE_CATEGORY(__cat__, __name__) \
+    NS_CC::ProfilingScopedTrace CC_PROFILER_TRACE_VAR(__LINE__)(__name__, __cat__)
+#else
+#define CC_PROFILER_TRACE(__name__) do {} while (0)
+#define CC_PROFILER_TRACE_CATEGORY(__cat__, __name__) do {} while (0)
+#endif
+
 // end of global group
 /// @}
 
@@ -29,6 +29,10 @@ THE SOFTWARE.
 #include "base/ccMacros.h"
 #include "base/CCScriptSupport.h"
 
+#if CC_ENABLE_REF_POOL
+#include "base/CCRefPool.h"
+#endif
+
 #if CC_REF_LEAK_DETECTION
 #include <algorithm>    // std::find
 #include <thread>
@@ -38,6 +42,32 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+#if CC_ENABLE_REF_POOL
+void* Ref::operator new(std::size_t size)
+{
+    void* ptr = RefPool::allocate(size);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* Ref::operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return RefPool::allocate(size);
+}
+
+void Ref::operator delete(void* ptr, std::size_t size) noexcept
+{
+    RefPool::deallocate(ptr, size);
+}
+
+void Ref::operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    // only called when a constructor throws, which doesn't give the size
+    RefPool::deallocate(ptr);
+}
+#endif
+
 #if CC_REF_LEAK_DETECTION
 static void trackRef(Ref* ref);
 static void untrackRef(Ref* ref);
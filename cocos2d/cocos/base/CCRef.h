@@ -30,6 +30,10 @@ THE SOFTWARE.
 #include "platform/CCPlatformMacros.h"
 #include "base/ccConfig.h"
 
+#if CC_ENABLE_REF_POOL
+#include <new>
+#endif
+
 #define CC_REF_LEAK_DETECTION 0
 
 /**
@@ -169,6 +173,28 @@ public:
 public:
     static void printLeaks();
 #endif
+
+    // Allocation of every Ref from RefPool (only included when CC_ENABLE_REF_POOL is defined and its value isn't zero)
+#if CC_ENABLE_REF_POOL
+public:
+    /**
+     * Allocates Ref and the classes derived from it from RefPool.
+     * @js NA
+     * @lua NA
+     */
+    static void* operator new(std::size_t size);
+    static void* operator new(std::size_t size, const std::nothrow_t&) noexcept;
+    static void* operator new(std::size_t, void* where) noexcept { return where; }
+
+    /**
+     * Returns a Ref to RefPool. The size is the size of the most derived class, since ~Ref is virtual.
+     * @js NA
+     * @lua NA
+     */
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept;
+    static void operator delete(void*, void*) noexcept {}
+#endif
 };
 
 class Node;
@@ -0,0 +1,280 @@
+/****************************************************************************
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CCRefPool.h"
+
+#include <stdlib.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+NS_CC_BEGIN
+
+static const size_t SIZE_CLASS_COUNT = RefPool::MAX_BLOCK_SIZE / RefPool::GRANULARITY;
+
+// heap memory is reserved this many bytes at a time, and carved into blocks of a single size class
+static const size_t SLAB_SIZE = 16 * 1024;
+
+// blocks moved between a thread and the shared lists at once, a thread keeps at most twice as many per class
+static const unsigned int BATCH_SIZE = 32;
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+struct Slab
+{
+    char* begin;
+    char* end;
+    size_t sizeClass;
+};
+
+// free lists shared by every thread, and the slabs their blocks were carved from
+struct SharedLists
+{
+    std::mutex mutex;
+    FreeBlock* heads[SIZE_CLASS_COUNT];
+    std::vector<Slab> slabs;
+};
+
+// free lists of one thread, only touched by that thread
+struct ThreadCache
+{
+    FreeBlock* heads[SIZE_CLASS_COUNT];
+    unsigned int counts[SIZE_CLASS_COUNT];
+
+    ~ThreadCache();
+};
+
+static std::atomic<uint64_t> s_allocations(0);
+static std::atomic<uint64_t> s_deallocations(0);
+static std::atomic<uint64_t> s_cacheMisses(0);
+static std::atomic<size_t> s_reservedBytes(0);
+
+// set once the thread's cache is destroyed, later frees on the thread go to the shared lists
+static thread_local bool s_threadCacheReleased = false;
+
+static SharedLists& getSharedLists()
+{
+    // never destroyed, Refs may still be released by static destructors
+    static SharedLists* lists = new SharedLists();
+    return *lists;
+}
+
+static ThreadCache* getThreadCache()
+{
+    if (s_threadCacheReleased)
+        return nullptr;
+
+    static thread_local ThreadCache s_threadCache;
+    return &s_threadCache;
+}
+
+static size_t getSizeClass(size_t size)
+{
+    return size > 0 ? (size - 1) / RefPool::GRANULARITY : 0;
+}
+
+// cuts up to `count` blocks off the front of a list, and returns the last block that was cut
+static FreeBlock* cutBlocks(FreeBlock*& head, unsigned int count, unsigned int& cut)
+{
+    FreeBlock* last = head;
+    cut = 1;
+    while (cut < count && last->next)
+    {
+        last = last->next;
+        ++cut;
+    }
+
+    head = last->next;
+    last->next = nullptr;
+    return last;
+}
+
+// carves a new slab into the shared list of a size class, must be called with the lock held
+static bool addSlab(SharedLists& lists, size_t sizeClass)
+{
+    auto memory = static_cast<char*>(malloc(SLAB_SIZE + RefPool::GRANULARITY));
+    if (!memory)
+        return false;
+
+    const auto alignment = RefPool::GRANULARITY - 1;
+    auto begin = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(memory) + alignment) & ~uintptr_t(alignment));
+    const auto blockSize = (sizeClass + 1) * RefPool::GRANULARITY;
+    const auto count = SLAB_SIZE / blockSize;
+
+    // linked back to front, so blocks are handed out in address order
+    for (auto i = count; i > 0; --i)
+    {
+        auto block = reinterpret_cast<FreeBlock*>(begin + (i - 1) * blockSize);
+        block->next = lists.heads[sizeClass];
+        lists.heads[sizeClass] = block;
+    }
+
+    lists.slabs.push_back({begin, begin + count * blockSize, sizeClass});
+    s_reservedBytes.fetch_add(SLAB_SIZE + RefPool::GRANULARITY, std::memory_order_relaxed);
+    return true;
+}
+
+ThreadCache::~ThreadCache()
+{
+    auto& lists = getSharedLists();
+    std::lock_guard<std::mutex> lock(lists.mutex);
+    for (size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass)
+    {
+        if (!heads[sizeClass])
+            continue;
+
+        auto last = heads[sizeClass];
+        while (last->next)
+            last = last->next;
+
+        last->next = lists.heads[sizeClass];
+        lists.heads[sizeClass] = heads[sizeClass];
+        heads[sizeClass] = nullptr;
+        counts[sizeClass] = 0;
+    }
+
+    s_threadCacheReleased = true;
+}
+
+void* RefPool::allocate(size_t size)
+{
+    void* ptr = nullptr;
+    if (size > MAX_BLOCK_SIZE)
+    {
+        ptr = malloc(size);
+    }
+    else
+    {
+        const auto sizeClass = getSizeClass(size);
+        auto cache = getThreadCache();
+        if (cache && cache->heads[sizeClass])
+        {
+            ptr = cache->heads[sizeClass];
+            cache->heads[sizeClass] = cache->heads[sizeClass]->next;
+            --cache->counts[sizeClass];
+        }
+        else
+        {
+            s_cacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+            auto& lists = getSharedLists();
+            std::lock_guard<std::mutex> lock(lists.mutex);
+            if (!lists.heads[sizeClass] && !addSlab(lists, sizeClass))
+                return nullptr;
+
+            ptr = lists.heads[sizeClass];
+            lists.heads[sizeClass] = lists.heads[sizeClass]->next;
+
+            // take a batch along, so the next allocations of this size are served without the lock
+            if (cache && lists.heads[sizeClass])
+            {
+                cache->heads[sizeClass] = lists.heads[sizeClass];
+                cutBlocks(lists.heads[sizeClass], BATCH_SIZE, cache->counts[sizeClass]);
+            }
+        }
+    }
+
+    if (ptr)
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+}
+
+void RefPool::deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    s_deallocations.fetch_add(1, std::memory_order_relaxed);
+    if (size > MAX_BLOCK_SIZE)
+    {
+        free(ptr);
+        return;
+    }
+
+    const auto sizeClass = getSizeClass(size);
+    auto block = static_cast<FreeBlock*>(ptr);
+    auto cache = getThreadCache();
+    if (!cache)
+    {
+        auto& lists = getSharedLists();
+        std::lock_guard<std::mutex> lock(lists.mutex);
+        block->next = lists.heads[sizeClass];
+        lists.heads[sizeClass] = block;
+        return;
+    }
+
+    block->next = cache->heads[sizeClass];
+    cache->heads[sizeClass] = block;
+    if (++cache->counts[sizeClass] <= 2 * BATCH_SIZE)
+        return;
+
+    // hand a batch back, so blocks freed on one thread can be reused by others
+    auto first = cache->heads[sizeClass];
+    unsigned int cut = 0;
+    auto last = cutBlocks(cache->heads[sizeClass], BATCH_SIZE, cut);
+    cache->counts[sizeClass] -= cut;
+
+    auto& lists = getSharedLists();
+    std::lock_guard<std::mutex> lock(lists.mutex);
+    last->next = lists.heads[sizeClass];
+    lists.heads[sizeClass] = first;
+}
+
+void RefPool::deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    size_t size = MAX_BLOCK_SIZE + 1;
+    {
+        auto& lists = getSharedLists();
+        std::lock_guard<std::mutex> lock(lists.mutex);
+        auto block = static_cast<char*>(ptr);
+        for (const auto& slab : lists.slabs)
+        {
+            if (block >= slab.begin && block < slab.end)
+            {
+                size = (slab.sizeClass + 1) * GRANULARITY;
+                break;
+            }
+        }
+    }
+
+    deallocate(ptr, size);
+}
+
+RefPool::Stats RefPool::getStats()
+{
+    Stats stats;
+    stats.allocations = s_allocations.load(std::memory_order_relaxed);
+    stats.deallocations = s_deallocations.load(std::memory_order_relaxed);
+    stats.cacheMisses = s_cacheMisses.load(std::memory_order_relaxed);
+    stats.reservedBytes = s_reservedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+NS_CC_END
@@ -0,0 +1,104 @@
+/****************************************************************************
+Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCREF_POOL_H_
+#define __CCREF_POOL_H_
+
+#include "platform/CCPlatformMacros.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* @addtogroup base
+* @{
+*/
+NS_CC_BEGIN
+
+/**
+ * @class RefPool
+ * @brief Allocator behind Ref::operator new when CC_ENABLE_REF_POOL is enabled. Blocks of up to MAX_BLOCK_SIZE
+ * bytes are rounded up to a multiple of GRANULARITY and recycled through a free list per size class. Each
+ * thread keeps its own free lists, so most allocations and frees don't take a lock; blocks only move between
+ * a thread and the shared lists in batches. Larger blocks go straight to malloc.
+ * @js NA
+ */
+class CC_DLL RefPool
+{
+public:
+    /** Size classes are multiples of this many bytes, which is also the alignment of every block. */
+    static const size_t GRANULARITY = 16;
+
+    /** Size of the largest pooled block. */
+    static const size_t MAX_BLOCK_SIZE = 1024;
+
+    /** Counters of the pool since launch. Allocation and free counts wrap around. */
+    struct Stats
+    {
+        /** Number of blocks allocated, pooled or not. */
+        uint64_t allocations;
+
+        /** Number of blocks freed. */
+        uint64_t deallocations;
+
+        /** Number of pooled allocations the calling thread's free list couldn't serve. */
+        uint64_t cacheMisses;
+
+        /** Bytes reserved from the heap for pooled blocks. */
+        size_t reservedBytes;
+    };
+
+    /**
+     * Allocates a block.
+     *
+     * @param size Size of the block in bytes.
+     * @return The block, or nullptr if the heap is out of memory.
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * Frees a block returned by allocate().
+     *
+     * @param ptr The block, may be nullptr.
+     * @param size Size the block was allocated with.
+     */
+    static void deallocate(void* ptr, size_t size);
+
+    /**
+     * Frees a block returned by allocate() when its size is unknown. This has to search the pool, so it is
+     * only meant for rare paths such as a constructor that throws.
+     *
+     * @param ptr The block, may be nullptr.
+     */
+    static void deallocate(void* ptr);
+
+    /**
+     * Returns a snapshot of the pool counters.
+     */
+    static Stats getStats();
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CCREF_POOL_H_
@@ -29,45 +29,12 @@ THE SOFTWARE.
 #include "base/CCScheduler.h"
 #include "base/ccMacros.h"
 #include "base/CCDirector.h"
-#include "base/utlist.h"
-#include "base/ccCArray.h"
+#include <algorithm>
 #include "base/CCScriptSupport.h"
+#include "base/CCProfiling.h"
 
 NS_CC_BEGIN
 
-// data structures
-
-// A list double-linked list used for "updates with priority"
-typedef struct _listEntry
-{
-    struct _listEntry   *prev, *next;
-    ccSchedulerFunc     callback;
-    void                *target;
-    int                 priority;
-    bool                paused;
-    bool                markedForDeletion; // selector will no longer be called and entry will be removed at end of the next tick
-} tListEntry;
-
-typedef struct _hashUpdateEntry
-{
-    tListEntry          **list;        // Which list does it belong to ?
-    tListEntry          *entry;        // entry in the list
-    void                *target;
-    ccSchedulerFunc     callback;
-    UT_hash_handle      hh;
-} tHashUpdateEntry;
-
-// Hash Element used for "selectors with interval"
-typedef struct _hashSelectorEntry
-{
-    ccArray             *timers;
-    void                *target;
-    int                 timerIndex;
-    Timer               *currentTimer;
-    bool                paused;
-    UT_hash_handle      hh;
-} tHashTimerEntry;
-
 // implementation Timer
 
 Timer::Timer()
@@ -252,229 +219,194 @@ const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
 Scheduler::Scheduler(void)
 : _timeScale(1.0f)
-, _updatesNegList(nullptr)
-, _updates0List(nullptr)
-, _updatesPosList(nullptr)
-, _hashForUpdates(nullptr)
-, _hashForTimers(nullptr)
-, _currentTarget(nullptr)
-, _currentTargetSalvaged(false)
+, _ordersDirty(false)
 , _updateHashLocked(false)
 #if CC_ENABLE_SCRIPT_BINDING
 , _scriptHandlerEntries(20)
 #endif
+, _functionsToPerform(nullptr)
 {
-    // I don't expect to have more than 30 functions to all per frame
-    _functionsToPerform.reserve(30);
 }
 
 Scheduler::~Scheduler(void)
 {
     unscheduleAll();
+    removeAllFunctionsToBePerformedInCocosThread();
 }
 
-void Scheduler::removeHashElement(_hashSelectorEntry *element)
+Scheduler::TimerTarget& Scheduler::getTimerTarget(void *target, bool paused)
 {
-    ccArrayFree(element->timers);
-    HASH_DEL(_hashForTimers, element);
-    free(element);
-}
+    auto it = _timerTargets.find(target);
+    if (it == _timerTargets.end())
+    {
+        // Is this the 1st timer ? Then set the pause level to all the timers of this target
+        it = _timerTargets.emplace(target, TimerTarget()).first;
+        it->second.paused = paused;
+    }
+    else
+    {
+        CCASSERT(it->second.paused == paused, "element's paused should be paused!");
+    }
 
-void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, bool paused, const std::string& key)
-{
-    this->schedule(callback, target, interval, CC_REPEAT_FOREVER, 0.0f, paused, key);
+    return it->second;
 }
 
-void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, unsigned int repeat, float delay, bool paused, const std::string& key)
+void Scheduler::addTimer(TimerTarget& owner, Timer *timer)
 {
-    CCASSERT(target, "Argument target must be non-nullptr");
-    CCASSERT(!key.empty(), "key should not be empty!");
+    unsigned int index;
+    if (_freeTimerSlots.empty())
+    {
+        index = static_cast<unsigned int>(_timerSlots.size());
+        _timerSlots.push_back({nullptr, nullptr, 0});
+    }
+    else
+    {
+        index = _freeTimerSlots.back();
+        _freeTimerSlots.pop_back();
+    }
 
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
+    auto& slot = _timerSlots[index];
+    slot.timer = timer;
+    slot.owner = &owner;
 
-    if (! element)
-    {
-        element = (tHashTimerEntry *)calloc(sizeof(*element), 1);
-        element->target = target;
+    owner.timers.push_back(index);
+    _timerOrder.push_back({index, slot.generation});
+}
 
-        HASH_ADD_PTR(_hashForTimers, target, element);
+void Scheduler::removeTimer(std::unordered_map<void*, TimerTarget>::iterator owner, size_t position)
+{
+    const unsigned int index = owner->second.timers[position];
+    auto& slot = _timerSlots[index];
 
-        // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        element->paused = paused;
+    // The timer may be the one being updated. It stops repeating once aborted, and isn't released before its
+    // step is done.
+    slot.timer->setAborted();
+    if (_updateHashLocked)
+    {
+        _timersToRelease.push_back(slot.timer);
     }
     else
     {
-        CCASSERT(element->paused == paused, "element's paused should be paused!");
+        slot.timer->release();
     }
 
-    if (element->timers == nullptr)
+    slot.timer = nullptr;
+    slot.owner = nullptr;
+    ++slot.generation;
+    _freeTimerSlots.push_back(index);
+    _ordersDirty = true;
+
+    owner->second.timers.erase(owner->second.timers.begin() + position);
+    if (owner->second.timers.empty())
     {
-        element->timers = ccArrayNew(10);
+        _timerTargets.erase(owner);
     }
-    else 
-    {
-        for (int i = 0; i < element->timers->num; ++i)
-        {
-            TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(element->timers->arr[i]);
+}
 
-            if (timer && !timer->isExhausted() && key == timer->getKey())
-            {
-                CCLOG("CCScheduler#schedule. Reiniting timer with interval %.4f, repeat %u, delay %.4f", interval, repeat, delay);
-                timer->setupTimerWithInterval(interval, repeat, delay);
-                return;
-            }
-        }
-        ccArrayEnsureExtraCapacity(element->timers, 1);
+void Scheduler::insertUpdate(const SlotHandle& handle)
+{
+    const int priority = _updateSlots[handle.index].priority;
+
+    // Most of the updates are going to be 0 and appended, so look from the back.
+    auto position = _updateOrder.end();
+    while (position != _updateOrder.begin() && _updateSlots[(position - 1)->index].priority > priority)
+    {
+        --position;
     }
 
-    TimerTargetCallback *timer = new (std::nothrow) TimerTargetCallback();
-    timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
-    ccArrayAppendObject(element->timers, timer);
-    timer->release();
+    _updateOrder.insert(position, handle);
 }
 
-void Scheduler::unschedule(const std::string &key, void *target)
+void Scheduler::freeUpdate(unsigned int index)
 {
-    // explicit handle nil arguments when removing an object
-    if (target == nullptr || key.empty())
+    auto& slot = _updateSlots[index];
+    slot.callback = nullptr;
+    slot.target = nullptr;
+    ++slot.generation;
+    _freeUpdateSlots.push_back(index);
+    _ordersDirty = true;
+}
+
+void Scheduler::compactOrders()
+{
+    if (!_ordersDirty)
     {
         return;
     }
 
-    //CCASSERT(target);
-    //CCASSERT(selector);
+    _updateOrder.erase(std::remove_if(_updateOrder.begin(), _updateOrder.end(), [this](const SlotHandle& handle) {
+        return _updateSlots[handle.index].generation != handle.generation;
+    }), _updateOrder.end());
 
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
+    _timerOrder.erase(std::remove_if(_timerOrder.begin(), _timerOrder.end(), [this](const SlotHandle& handle) {
+        return _timerSlots[handle.index].generation != handle.generation;
+    }), _timerOrder.end());
 
-    if (element)
-    {
-        for (int i = 0; i < element->timers->num; ++i)
-        {
-            TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(element->timers->arr[i]);
+    _ordersDirty = false;
+}
 
-            if (timer && key == timer->getKey())
-            {
-                if (timer == element->currentTimer && (! timer->isAborted()))
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
-                ccArrayRemoveObjectAtIndex(element->timers, i, true);
-
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i)
-                {
-                    element->timerIndex--;
-                }
-
-                if (element->timers->num == 0)
-                {
-                    if (_currentTarget == element)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        removeHashElement(element);
-                    }
-                }
-
-                return;
-            }
-        }
-    }
+void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, bool paused, const std::string& key)
+{
+    this->schedule(callback, target, interval, CC_REPEAT_FOREVER, 0.0f, paused, key);
 }
 
-void Scheduler::priorityIn(tListEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused)
+void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, unsigned int repeat, float delay, bool paused, const std::string& key)
 {
-    tListEntry *listElement = new (std::nothrow) tListEntry();
+    CCASSERT(target, "Argument target must be non-nullptr");
+    CCASSERT(!key.empty(), "key should not be empty!");
 
-    listElement->callback = callback;
-    listElement->target = target;
-    listElement->priority = priority;
-    listElement->paused = paused;
-    listElement->next = listElement->prev = nullptr;
-    listElement->markedForDeletion = false;
+    TimerTarget& owner = getTimerTarget(target, paused);
 
-    // empty list ?
-    if (! *list)
+    for (auto index : owner.timers)
     {
-        DL_APPEND(*list, listElement);
-    }
-    else
-    {
-        bool added = false;
-
-        for (tListEntry *element = *list; element; element = element->next)
-        {
-            if (priority < element->priority)
-            {
-                if (element == *list)
-                {
-                    DL_PREPEND(*list, listElement);
-                }
-                else
-                {
-                    listElement->next = element;
-                    listElement->prev = element->prev;
-
-                    element->prev->next = listElement;
-                    element->prev = listElement;
-                }
-
-                added = true;
-                break;
-            }
-        }
+        TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(_timerSlots[index].timer);
 
-        // Not added? priority has the higher value. Append it.
-        if (! added)
+        if (timer && !timer->isExhausted() && key == timer->getKey())
         {
-            DL_APPEND(*list, listElement);
+            CCLOG("CCScheduler#schedule. Reiniting timer with interval %.4f, repeat %u, delay %.4f", interval, repeat, delay);
+            timer->setupTimerWithInterval(interval, repeat, delay);
+            return;
         }
     }
 
-    // update hash entry for quick access
-    tHashUpdateEntry *hashElement = (tHashUpdateEntry *)calloc(sizeof(*hashElement), 1);
-    hashElement->target = target;
-    hashElement->list = list;
-    hashElement->entry = listElement;
-    memset(&hashElement->hh, 0, sizeof(hashElement->hh));
-    HASH_ADD_PTR(_hashForUpdates, target, hashElement);
+    TimerTargetCallback *timer = new (std::nothrow) TimerTargetCallback();
+    timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
+    addTimer(owner, timer);
 }
 
-void Scheduler::appendIn(_listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused)
+void Scheduler::unschedule(const std::string &key, void *target)
 {
-    tListEntry *listElement = new (std::nothrow) tListEntry();
-
-    listElement->callback = callback;
-    listElement->target = target;
-    listElement->paused = paused;
-    listElement->priority = 0;
-    listElement->markedForDeletion = false;
-
-    DL_APPEND(*list, listElement);
-
-    // update hash entry for quicker access
-    tHashUpdateEntry *hashElement = (tHashUpdateEntry *)calloc(sizeof(*hashElement), 1);
-    hashElement->target = target;
-    hashElement->list = list;
-    hashElement->entry = listElement;
-    memset(&hashElement->hh, 0, sizeof(hashElement->hh));
-    HASH_ADD_PTR(_hashForUpdates, target, hashElement);
+    // explicit handle nil arguments when removing an object
+    if (target == nullptr || key.empty())
+    {
+        return;
+    }
+
+    auto owner = _timerTargets.find(target);
+    if (owner == _timerTargets.end())
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < owner->second.timers.size(); ++i)
+    {
+        TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(_timerSlots[owner->second.timers[i]].timer);
+
+        if (timer && key == timer->getKey())
+        {
+            removeTimer(owner, i);
+            return;
+        }
+    }
 }
 
 void Scheduler::schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused)
 {
-    tHashUpdateEntry *hashElement = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, hashElement);
-    if (hashElement)
+    auto it = _updateTargets.find(target);
+    if (it != _updateTargets.end())
     {
         // change priority: should unschedule it first
-        if (hashElement->entry->priority != priority)
+        if (_updateSlots[it->second].priority != priority)
         {
             unscheduleUpdate(target);
         }
@@ -486,20 +418,35 @@ void Scheduler::schedulePerFrame(const ccSchedulerFunc& callback, void *target,
         }
     }
 
-    // most of the updates are going to be 0, that's way there
-    // is an special list for updates with priority 0
-    if (priority == 0)
+    unsigned int index;
+    if (_freeUpdateSlots.empty())
     {
-        appendIn(&_updates0List, callback, target, paused);
+        index = static_cast<unsigned int>(_updateSlots.size());
+        _updateSlots.push_back({nullptr, nullptr, 0, 0, false, false});
     }
-    else if (priority < 0)
+    else
     {
-        priorityIn(&_updatesNegList, callback, target, priority, paused);
+        index = _freeUpdateSlots.back();
+        _freeUpdateSlots.pop_back();
+    }
+
+    auto& slot = _updateSlots[index];
+    slot.callback = callback;
+    slot.target = target;
+    slot.priority = priority;
+    slot.paused = paused;
+    slot.markedForDeletion = false;
+    _updateTargets[target] = index;
+
+    // Inserting while update() walks _updateOrder could make it skip or repeat an entry.
+    if (_updateHashLocked)
+    {
+        _pendingUpdates.push_back({index, slot.generation});
     }
     else
     {
-        // priority > 0
-        priorityIn(&_updatesPosList, callback, target, priority, paused);
+        compactOrders();
+        insertUpdate({index, slot.generation});
     }
 }
 
@@ -508,22 +455,15 @@ bool Scheduler::isScheduled(const std::string& key, const void *target) const
     CCASSERT(!key.empty(), "Argument key must not be empty");
     CCASSERT(target, "Argument target must be non-nullptr");
     
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    
-    if (!element)
-    {
-        return false;
-    }
-    
-    if (element->timers == nullptr)
+    auto owner = _timerTargets.find(const_cast<void*>(target));
+    if (owner == _timerTargets.end())
     {
         return false;
     }
     
-    for (int i = 0; i < element->timers->num; ++i)
+    for (auto index : owner->second.timers)
     {
-        TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(element->timers->arr[i]);
+        TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(_timerSlots[index].timer);
         
         if (timer && !timer->isExhausted() && key == timer->getKey())
         {
@@ -534,40 +474,32 @@ bool Scheduler::isScheduled(const std::string& key, const void *target) const
     return false;
 }
 
-void Scheduler::removeUpdateFromHash(struct _listEntry *entry)
+void Scheduler::unscheduleUpdate(void *target)
 {
-    tHashUpdateEntry *element = nullptr;
-
-    HASH_FIND_PTR(_hashForUpdates, &entry->target, element);
-    if (element)
+    if (target == nullptr)
     {
-        // list entry
-        DL_DELETE(*element->list, element->entry);
-        if (!_updateHashLocked)
-            CC_SAFE_DELETE(element->entry);
-        else
-        {
-            element->entry->markedForDeletion = true;
-            _updateDeleteVector.push_back(element->entry);
-        }
-
-        // hash entry
-        HASH_DEL(_hashForUpdates, element);
-        free(element);
+        return;
     }
-}
 
-void Scheduler::unscheduleUpdate(void *target)
-{
-    if (target == nullptr)
+    auto it = _updateTargets.find(target);
+    if (it == _updateTargets.end())
     {
         return;
     }
 
-    tHashUpdateEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, element);
-    if (element)
-        this->removeUpdateFromHash(element->entry);
+    const unsigned int index = it->second;
+    _updateTargets.erase(it);
+
+    // The callback may be the one running, so while updating it is only freed at the end of the tick.
+    if (_updateHashLocked)
+    {
+        _updateSlots[index].markedForDeletion = true;
+        _updatesToFree.push_back(index);
+    }
+    else
+    {
+        freeUpdate(index);
+    }
 }
 
 void Scheduler::unscheduleAll(void)
@@ -578,44 +510,31 @@ void Scheduler::unscheduleAll(void)
 void Scheduler::unscheduleAllWithMinPriority(int minPriority)
 {
     // Custom Selectors
-    tHashTimerEntry *element = nullptr;
-    tHashTimerEntry *nextElement = nullptr;
-    for (element = _hashForTimers; element != nullptr;)
+    std::vector<void*> targets;
+    targets.reserve(_timerTargets.size());
+    for (const auto& owner : _timerTargets)
     {
-        // element may be removed in unscheduleAllSelectorsForTarget
-        nextElement = (tHashTimerEntry *)element->hh.next;
-        unscheduleAllForTarget(element->target);
-
-        element = nextElement;
+        targets.push_back(owner.first);
     }
 
-    // Updates selectors
-    tListEntry *entry, *tmp;
-    if(minPriority < 0)
+    for (auto target : targets)
     {
-        DL_FOREACH_SAFE(_updatesNegList, entry, tmp)
-        {
-            if(entry->priority >= minPriority)
-            {
-                unscheduleUpdate(entry->target);
-            }
-        }
+        unscheduleAllForTarget(target);
     }
 
-    if(minPriority <= 0)
+    // Updates selectors
+    targets.clear();
+    for (const auto& update : _updateTargets)
     {
-        DL_FOREACH_SAFE(_updates0List, entry, tmp)
+        if (_updateSlots[update.second].priority >= minPriority)
         {
-            unscheduleUpdate(entry->target);
+            targets.push_back(update.first);
         }
     }
 
-    DL_FOREACH_SAFE(_updatesPosList, entry, tmp)
+    for (auto target : targets)
     {
-        if(entry->priority >= minPriority)
-        {
-            unscheduleUpdate(entry->target);
-        }
+        unscheduleUpdate(target);
     }
 #if CC_ENABLE_SCRIPT_BINDING
     _scriptHandlerEntries.clear();
@@ -631,27 +550,15 @@ void Scheduler::unscheduleAllForTarget(void *target)
     }
 
     // Custom Selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-
-    if (element)
+    auto owner = _timerTargets.find(target);
+    if (owner != _timerTargets.end())
     {
-        if (ccArrayContainsObject(element->timers, element->currentTimer)
-            && (! element->currentTimer->isAborted()))
-        {
-            element->currentTimer->retain();
-            element->currentTimer->setAborted();
-        }
-        ccArrayRemoveAllObjects(element->timers);
-
-        if (_currentTarget == element)
+        // The last removal erases the target.
+        for (size_t i = owner->second.timers.size(); i > 1; --i)
         {
-            _currentTargetSalvaged = true;
-        }
-        else
-        {
-            removeHashElement(element);
+            removeTimer(owner, i - 1);
         }
+        removeTimer(owner, 0);
     }
 
     // update selector
@@ -686,20 +593,17 @@ void Scheduler::resumeTarget(void *target)
     CCASSERT(target != nullptr, "target can't be nullptr!");
 
     // custom selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    if (element)
+    auto owner = _timerTargets.find(target);
+    if (owner != _timerTargets.end())
     {
-        element->paused = false;
+        owner->second.paused = false;
     }
 
     // update selector
-    tHashUpdateEntry *elementUpdate = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, elementUpdate);
-    if (elementUpdate)
+    auto update = _updateTargets.find(target);
+    if (update != _updateTargets.end())
     {
-        CCASSERT(elementUpdate->entry != nullptr, "elementUpdate's entry can't be nullptr!");
-        elementUpdate->entry->paused = false;
+        _updateSlots[update->second].paused = false;
     }
 }
 
@@ -708,20 +612,17 @@ void Scheduler::pauseTarget(void *target)
     CCASSERT(target != nullptr, "target can't be nullptr!");
 
     // custom selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    if (element)
+    auto owner = _timerTargets.find(target);
+    if (owner != _timerTargets.end())
     {
-        element->paused = true;
+        owner->second.paused = true;
     }
 
     // update selector
-    tHashUpdateEntry *elementUpdate = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, elementUpdate);
-    if (elementUpdate)
+    auto update = _updateTargets.find(target);
+    if (update != _updateTargets.end())
     {
-        CCASSERT(elementUpdate->entry != nullptr, "elementUpdate's entry can't be nullptr!");
-        elementUpdate->entry->paused = true;
+        _updateSlots[update->second].paused = true;
     }
 }
 
@@ -730,19 +631,17 @@ bool Scheduler::isTargetPaused(void *target)
     CCASSERT( target != nullptr, "target must be non nil" );
 
     // Custom selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    if( element )
+    auto owner = _timerTargets.find(target);
+    if (owner != _timerTargets.end())
     {
-        return element->paused;
+        return owner->second.paused;
     }
     
     // We should check update selectors if target does not have custom selectors
-    tHashUpdateEntry *elementUpdate = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, elementUpdate);
-    if ( elementUpdate )
+    auto update = _updateTargets.find(target);
+    if (update != _updateTargets.end())
     {
-        return elementUpdate->entry->paused;
+        return _updateSlots[update->second].paused;
     }
     
     return false;  // should never get here
@@ -758,42 +657,20 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     std::set<void*> idsWithSelectors;
 
     // Custom Selectors
-    for(tHashTimerEntry *element = _hashForTimers; element != nullptr;
-        element = (tHashTimerEntry*)element->hh.next)
+    for (auto& owner : _timerTargets)
     {
-        element->paused = true;
-        idsWithSelectors.insert(element->target);
+        owner.second.paused = true;
+        idsWithSelectors.insert(owner.first);
     }
 
     // Updates selectors
-    tListEntry *entry, *tmp;
-    if(minPriority < 0)
+    for (const auto& update : _updateTargets)
     {
-        DL_FOREACH_SAFE( _updatesNegList, entry, tmp ) 
+        auto& slot = _updateSlots[update.second];
+        if (slot.priority >= minPriority)
         {
-            if(entry->priority >= minPriority)
-            {
-                entry->paused = true;
-                idsWithSelectors.insert(entry->target);
-            }
-        }
-    }
-
-    if(minPriority <= 0)
-    {
-        DL_FOREACH_SAFE( _updates0List, entry, tmp )
-        {
-            entry->paused = true;
-            idsWithSelectors.insert(entry->target);
-        }
-    }
-
-    DL_FOREACH_SAFE( _updatesPosList, entry, tmp ) 
-    {
-        if(entry->priority >= minPriority) 
-        {
-            entry->paused = true;
-            idsWithSelectors.insert(entry->target);
+            slot.paused = true;
+            idsWithSelectors.insert(update.first);
         }
     }
 
@@ -809,19 +686,32 @@ void Scheduler::resumeTargets(const std::set<void*>& targetsToResume)
 
 void Scheduler::performFunctionInCocosThread(std::function<void ()> function)
 {
-    std::lock_guard<std::mutex> lock(_performMutex);
-    _functionsToPerform.push_back(std::move(function));
+    PerformEntry *entry = new (std::nothrow) PerformEntry();
+    entry->function = std::move(function);
+    entry->next = _functionsToPerform.load(std::memory_order_relaxed);
+
+    while (!_functionsToPerform.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
 }
 
 void Scheduler::removeAllFunctionsToBePerformedInCocosThread()
 {
-    std::unique_lock<std::mutex> lock(_performMutex);
-    _functionsToPerform.clear();
+    PerformEntry *entry = _functionsToPerform.exchange(nullptr, std::memory_order_acquire);
+    while (entry)
+    {
+        PerformEntry *next = entry->next;
+        delete entry;
+        entry = next;
+    }
 }
 
 // main loop
 void Scheduler::update(float dt)
 {
+    CC_PROFILER_TRACE("Scheduler::update");
+
+    compactOrders();
     _updateHashLocked = true;
 
     if (_timeScale != 1.0f)
@@ -833,85 +723,60 @@ void Scheduler::update(float dt)
     // Selector callbacks
     //
 
-    // Iterate over all the Updates' selectors
-    tListEntry *entry, *tmp;
-
-    // updates with priority < 0
-    DL_FOREACH_SAFE(_updatesNegList, entry, tmp)
+    // Iterate over all the Updates' selectors, lowest priority first. _updateOrder doesn't change while
+    // iterating, and callbacks don't move since the slots are in a deque.
+    for (size_t i = 0, count = _updateOrder.size(); i < count; ++i)
     {
-        if ((! entry->paused) && (! entry->markedForDeletion))
+        const SlotHandle handle = _updateOrder[i];
+        UpdateSlot& slot = _updateSlots[handle.index];
+        if (slot.generation == handle.generation && !slot.paused && !slot.markedForDeletion)
         {
-            entry->callback(dt);
+            slot.callback(dt);
         }
     }
 
-    // updates with priority == 0
-    DL_FOREACH_SAFE(_updates0List, entry, tmp)
+    // Iterate over all the custom selectors. Timers scheduled while iterating are appended and still get
+    // their first update this tick.
+    for (size_t i = 0; i < _timerOrder.size(); ++i)
     {
-        if ((! entry->paused) && (! entry->markedForDeletion))
+        const SlotHandle handle = _timerOrder[i];
+        const TimerSlot& slot = _timerSlots[handle.index];
+        if (slot.generation != handle.generation || slot.owner->paused)
         {
-            entry->callback(dt);
+            continue;
         }
-    }
 
-    // updates with priority > 0
-    DL_FOREACH_SAFE(_updatesPosList, entry, tmp)
-    {
-        if ((! entry->paused) && (! entry->markedForDeletion))
-        {
-            entry->callback(dt);
-        }
+        // The slot may be reallocated or reused by the time update returns, don't touch it after this.
+        Timer *timer = slot.timer;
+        CCASSERT(!timer->isAborted(), "An aborted timer should not be updated");
+        timer->update(dt);
     }
-
-    // Iterate over all the custom selectors
-    for (tHashTimerEntry *elt = _hashForTimers; elt != nullptr; )
+ 
+    // Removed timers were kept alive until their step was done, and removed updates until their callback
+    // returned. It's safe to free them now.
+    for (auto timer : _timersToRelease)
     {
-        _currentTarget = elt;
-        _currentTargetSalvaged = false;
+        timer->release();
+    }
+    _timersToRelease.clear();
 
-        if (! _currentTarget->paused)
-        {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers->num; ++(elt->timerIndex))
-            {
-                elt->currentTimer = (Timer*)(elt->timers->arr[elt->timerIndex]);
-                CCASSERT
-                  ( !elt->currentTimer->isAborted(),
-                    "An aborted timer should not be updated" );
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
-            }
-        }
+    _updateHashLocked = false;
 
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashTimerEntry *)elt->hh.next;
+    for (auto index : _updatesToFree)
+    {
+        freeUpdate(index);
+    }
+    _updatesToFree.clear();
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers->num == 0)
+    compactOrders();
+    for (const auto& handle : _pendingUpdates)
+    {
+        if (_updateSlots[handle.index].generation == handle.generation)
         {
-            removeHashElement(_currentTarget);
+            insertUpdate(handle);
         }
     }
- 
-    // delete all updates that are removed in update
-    for (auto &e : _updateDeleteVector)
-        delete e;
-
-    _updateDeleteVector.clear();
-
-    _updateHashLocked = false;
-    _currentTarget = nullptr;
+    _pendingUpdates.clear();
 
 #if CC_ENABLE_SCRIPT_BINDING
     //
@@ -939,16 +804,29 @@ void Scheduler::update(float dt)
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
+    // Testing the head is faster than exchanging it.
     // And almost never there will be functions scheduled to be called.
-    if( !_functionsToPerform.empty() ) {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if new functions are added in callback, it will cause thread deadlock.
-        auto temp = std::move(_functionsToPerform);
-        _performMutex.unlock();
-        
-        for (const auto &function : temp) {
-            function();
+    if (_functionsToPerform.load(std::memory_order_relaxed))
+    {
+        // Take every queued function at once, so functions queued by these callbacks wait for the next tick.
+        PerformEntry *entry = _functionsToPerform.exchange(nullptr, std::memory_order_acquire);
+
+        // The stack hands them back newest first.
+        PerformEntry *ordered = nullptr;
+        while (entry)
+        {
+            PerformEntry *next = entry->next;
+            entry->next = ordered;
+            ordered = entry;
+            entry = next;
+        }
+
+        while (ordered)
+        {
+            PerformEntry *next = ordered->next;
+            ordered->function();
+            delete ordered;
+            ordered = next;
         }
     }
 }
@@ -957,48 +835,23 @@ void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, uns
 {
     CCASSERT(target, "Argument target must be non-nullptr");
     
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
+    TimerTarget& owner = getTimerTarget(target, paused);
     
-    if (! element)
+    for (auto index : owner.timers)
     {
-        element = (tHashTimerEntry *)calloc(sizeof(*element), 1);
-        element->target = target;
+        TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(_timerSlots[index].timer);
         
-        HASH_ADD_PTR(_hashForTimers, target, element);
-        
-        // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        element->paused = paused;
-    }
-    else
-    {
-        CCASSERT(element->paused == paused, "element's paused should be paused.");
-    }
-    
-    if (element->timers == nullptr)
-    {
-        element->timers = ccArrayNew(10);
-    }
-    else
-    {
-        for (int i = 0; i < element->timers->num; ++i)
+        if (timer && !timer->isExhausted() && selector == timer->getSelector())
         {
-            TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(element->timers->arr[i]);
-            
-            if (timer && !timer->isExhausted() && selector == timer->getSelector())
-            {
-                CCLOG("CCScheduler#schedule. Reiniting timer with interval %.4f, repeat %u, delay %.4f", interval, repeat, delay);
-                timer->setupTimerWithInterval(interval, repeat, delay);
-                return;
-            }
+            CCLOG("CCScheduler#schedule. Reiniting timer with interval %.4f, repeat %u, delay %.4f", interval, repeat, delay);
+            timer->setupTimerWithInterval(interval, repeat, delay);
+            return;
         }
-        ccArrayEnsureExtraCapacity(element->timers, 1);
     }
     
     TimerTargetSelector *timer = new (std::nothrow) TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
-    ccArrayAppendObject(element->timers, timer);
-    timer->release();
+    addTimer(owner, timer);
 }
 
 void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, bool paused)
@@ -1011,22 +864,15 @@ bool Scheduler::isScheduled(SEL_SCHEDULE selector, const Ref *target) const
     CCASSERT(selector, "Argument selector must be non-nullptr");
     CCASSERT(target, "Argument target must be non-nullptr");
     
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    
-    if (!element)
-    {
-        return false;
-    }
-    
-    if (element->timers == nullptr)
+    auto owner = _timerTargets.find(const_cast<Ref*>(target));
+    if (owner == _timerTargets.end())
     {
         return false;
     }
 
-    for (int i = 0; i < element->timers->num; ++i)
+    for (auto index : owner->second.timers)
     {
-        TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(element->timers->arr[i]);
+        TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(_timerSlots[index].timer);
         
         if (timer && !timer->isExhausted() && selector == timer->getSelector())
         {
@@ -1045,45 +891,20 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Ref *target)
         return;
     }
     
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    
-    if (element)
+    auto owner = _timerTargets.find(target);
+    if (owner == _timerTargets.end())
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < owner->second.timers.size(); ++i)
     {
-        for (int i = 0; i < element->timers->num; ++i)
+        TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(_timerSlots[owner->second.timers[i]].timer);
+        
+        if (timer && selector == timer->getSelector())
         {
-            TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(element->timers->arr[i]);
-            
-            if (timer && selector == timer->getSelector())
-            {
-                if (timer == element->currentTimer && !timer->isAborted())
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-                
-                ccArrayRemoveObjectAtIndex(element->timers, i, true);
-                
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i)
-                {
-                    element->timerIndex--;
-                }
-                
-                if (element->timers->num == 0)
-                {
-                    if (_currentTarget == element)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        removeHashElement(element);
-                    }
-                }
-                
-                return;
-            }
+            removeTimer(owner, i);
+            return;
         }
     }
 }
@@ -29,13 +29,16 @@ THE SOFTWARE.
 #ifndef __CCSCHEDULER_H__
 #define __CCSCHEDULER_H__
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "base/CCRef.h"
 #include "base/CCVector.h"
-#include "base/uthash.h"
 
 NS_CC_BEGIN
 
@@ -140,10 +143,6 @@ private:
  * @{
  */
 
-struct _listEntry;
-struct _hashSelectorEntry;
-struct _hashUpdateEntry;
-
 #if CC_ENABLE_SCRIPT_BINDING
 class SchedulerScriptHandlerEntry;
 #endif
@@ -507,40 +506,89 @@ protected:
      */
     void schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused);
     
-    void removeHashElement(struct _hashSelectorEntry *element);
-    void removeUpdateFromHash(struct _listEntry *entry);
-
-    // update specific
+    // Slot maps. Slots are reused, so everything that refers to a slot from outside keeps a handle with the
+    // generation it saw: a slot that has been removed (and maybe reused) since then has a newer generation.
+    // That makes removal O(1) and safe while the scheduler is iterating; stale handles are compacted away once
+    // per frame.
+    struct SlotHandle
+    {
+        unsigned int index;
+        unsigned int generation;
+    };
 
-    void priorityIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused);
-    void appendIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused);
+    // A callback called every frame.
+    struct UpdateSlot
+    {
+        ccSchedulerFunc callback;
+        void *target;
+        int priority;
+        unsigned int generation;
+        bool paused;
+        bool markedForDeletion; // will no longer be called and will be freed at the end of the current tick
+    };
+
+    // The timers of a target, which share its paused state.
+    struct TimerTarget
+    {
+        std::vector<unsigned int> timers; // slots, in the order the timers were scheduled
+        bool paused;
+    };
 
+    // A timer with an interval. Holds the only reference to the Timer.
+    struct TimerSlot
+    {
+        Timer *timer;
+        TimerTarget *owner;
+        unsigned int generation;
+    };
+
+    /** Gets the timers of a target, creating an empty entry if there is none. */
+    TimerTarget& getTimerTarget(void *target, bool paused);
+    /** Puts a new timer in a slot of a target. */
+    void addTimer(TimerTarget& owner, Timer *timer);
+    /** Removes the timer at position of a target's timers, and the target itself when it has no timers left. */
+    void removeTimer(std::unordered_map<void*, TimerTarget>::iterator owner, size_t position);
+    /** Adds an update slot to _updateOrder, keeping it sorted by priority. */
+    void insertUpdate(const SlotHandle& handle);
+    /** Frees an update slot. */
+    void freeUpdate(unsigned int index);
+    /** Drops stale handles from _updateOrder and _timerOrder. */
+    void compactOrders();
 
     float _timeScale;
 
     //
     // "updates with priority" stuff
     //
-    struct _listEntry *_updatesNegList;        // list of priority < 0
-    struct _listEntry *_updates0List;            // list priority == 0
-    struct _listEntry *_updatesPosList;        // list priority > 0
-    struct _hashUpdateEntry *_hashForUpdates; // hash used to fetch quickly the list entries for pause,delete,etc
-    std::vector<struct _listEntry *> _updateDeleteVector; // the vector holds list entries that needs to be deleted after update
+    std::deque<UpdateSlot> _updateSlots;                 // a deque, so callbacks don't move while they run
+    std::vector<unsigned int> _freeUpdateSlots;
+    std::vector<SlotHandle> _updateOrder;                // sorted by priority, same priorities in the order they were scheduled
+    std::unordered_map<void*, unsigned int> _updateTargets; // slot of each target, for quick access on pause, delete, etc
+    std::vector<SlotHandle> _pendingUpdates;             // scheduled during update, added to _updateOrder at the end of it
+    std::vector<unsigned int> _updatesToFree;            // unscheduled during update, freed at the end of it
 
     // Used for "selectors with interval"
-    struct _hashSelectorEntry *_hashForTimers;
-    struct _hashSelectorEntry *_currentTarget;
-    bool _currentTargetSalvaged;
-    // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
+    std::vector<TimerSlot> _timerSlots;
+    std::vector<unsigned int> _freeTimerSlots;
+    std::vector<SlotHandle> _timerOrder;                 // every timer, in the order it was scheduled
+    std::unordered_map<void*, TimerTarget> _timerTargets;
+    std::vector<Timer*> _timersToRelease;                // removed during update, may still be running
+    bool _ordersDirty;
+    // If true unschedule will not free anything. Slots will only be marked for deletion.
     bool _updateHashLocked;
     
 #if CC_ENABLE_SCRIPT_BINDING
     Vector<SchedulerScriptHandlerEntry*> _scriptHandlerEntries;
 #endif
     
-    // Used for "perform Function"
-    std::vector<std::function<void()>> _functionsToPerform;
-    std::mutex _performMutex;
+    // Used for "perform Function". A lock free stack that update() empties and reverses, so functions are
+    // still called in the order they were queued.
+    struct PerformEntry
+    {
+        std::function<void()> function;
+        PerformEntry *next;
+    };
+    std::atomic<PerformEntry*> _functionsToPerform;
 };
 
 // end of base group
@@ -41,6 +41,7 @@
 #include "base/ccMacros.h"
 #include "platform/CCFileUtils.h"
 #include <map>
+#include <mutex>
 
 // FIXME: Other platforms should use upstream minizip like mingw-w64  
 #ifdef MINIZIP_FROM_SYSTEM
@@ -56,6 +57,9 @@ bool ZipUtils::s_bEncryptionKeyIsValid = false;
 
 // --------------------- ZipUtils ---------------------
 
+// Guards the expansion of the long key, since CCZ files may be decoded on several threads at once
+static std::mutex s_encryptionKeyMutex;
+
 inline void ZipUtils::decodeEncodedPvr(unsigned int *data, ssize_t len)
 {
     const int enclen = 1024;
@@ -70,6 +74,7 @@ inline void ZipUtils::decodeEncodedPvr(unsigned int *data, ssize_t len)
     CCASSERT(s_uEncryptedPvrKeyParts[3] != 0, "Cocos2D: CCZ file is encrypted but key part 3 is not set. Did you call ZipUtils::setPvrEncryptionKeyPart(...)?");
     
     // create long key
+    std::unique_lock<std::mutex> lock(s_encryptionKeyMutex);
     if(!s_bEncryptionKeyIsValid)
     {
         unsigned int y, p, e;
@@ -98,6 +103,7 @@ inline void ZipUtils::decodeEncodedPvr(unsigned int *data, ssize_t len)
         
         s_bEncryptionKeyIsValid = true;
     }
+    lock.unlock();
     
     int b = 0;
     int i = 0;
@@ -242,10 +248,73 @@ ssize_t ZipUtils::inflateMemoryWithHint(unsigned char *in, ssize_t inLength, uns
     return outLength;
 }
 
+ssize_t ZipUtils::inflateMemoryTo(unsigned char *in, ssize_t inLength, unsigned char *out, ssize_t outLength)
+{
+    z_stream d_stream; /* decompression stream */
+    d_stream.zalloc = (alloc_func)0;
+    d_stream.zfree = (free_func)0;
+    d_stream.opaque = (voidpf)0;
+
+    d_stream.next_in  = in;
+    d_stream.avail_in = static_cast<unsigned int>(inLength);
+    d_stream.next_out = out;
+    d_stream.avail_out = static_cast<unsigned int>(outLength);
+
+    if (inflateInit2(&d_stream, 15 + 32) != Z_OK)
+    {
+        CCLOG("cocos2d: ZipUtils: Incompatible zlib version!");
+        return -1;
+    }
+
+    // The whole output buffer is available, so a single Z_FINISH either reaches the end of the stream or fails.
+    int err = inflate(&d_stream, Z_FINISH);
+    inflateEnd(&d_stream);
+
+    if (err != Z_STREAM_END)
+    {
+        if (err == Z_BUF_ERROR)
+        {
+            CCLOG("cocos2d: ZipUtils: Compressed data is truncated or inflates to more than %ld bytes!", static_cast<long>(outLength));
+        }
+        else
+        {
+            CCLOG("cocos2d: ZipUtils: Incorrect zlib compressed data!");
+        }
+        return -1;
+    }
+
+    return outLength - d_stream.avail_out;
+}
+
+ssize_t ZipUtils::getInflatedSize(const unsigned char *in, ssize_t inLength)
+{
+    // 10 bytes of header and 8 of trailer
+    if (!isGZipBuffer(in, inLength) || inLength < 18)
+    {
+        return -1;
+    }
+
+    // ISIZE, little endian in the last 4 bytes
+    const unsigned char *trailer = in + inLength - 4;
+    ssize_t size = (ssize_t)((unsigned int)trailer[0]
+                             | ((unsigned int)trailer[1] << 8)
+                             | ((unsigned int)trailer[2] << 16)
+                             | ((unsigned int)trailer[3] << 24));
+
+    // deflate can't do better than about 1032:1, anything above that is a corrupt or concatenated stream
+    if (size <= 0 || size / 1032 > inLength)
+    {
+        return -1;
+    }
+
+    return size;
+}
+
 ssize_t ZipUtils::inflateMemory(unsigned char *in, ssize_t inLength, unsigned char **out)
 {
-    // 256k for hint
-    return inflateMemoryWithHint(in, inLength, out, 256 * 1024);
+    // gzip knows its inflated size, so the buffer is allocated once. 256k for hint otherwise
+    ssize_t hint = getInflatedSize(in, inLength);
+    return inflateMemoryWithHint(in, inLength, out, hint > 0 ? hint : 256 * 1024);
 }
 
 int ZipUtils::inflateGZipFile(const char *path, unsigned char **out)
@@ -480,6 +549,7 @@ void ZipUtils::setPvrEncryptionKeyPart(int index, unsigned int value)
     CCASSERT(index >= 0, "Cocos2d: key part index cannot be less than 0");
     CCASSERT(index <= 3, "Cocos2d: key part index cannot be greater than 3");
     
+    std::lock_guard<std::mutex> lock(s_encryptionKeyMutex);
     if(s_uEncryptedPvrKeyParts[index] != value)
     {
         s_uEncryptedPvrKeyParts[index] = value;
@@ -495,6 +565,93 @@ void ZipUtils::setPvrEncryptionKey(unsigned int keyPart1, unsigned int keyPart2,
     setPvrEncryptionKeyPart(3, keyPart4);
 }
 
+// --------------------- InflateStream ---------------------
+
+InflateStream::InflateStream(const unsigned char *in, ssize_t inLength)
+: _stream(new (std::nothrow) z_stream())
+, _finished(false)
+, _failed(false)
+{
+    if (!_stream)
+    {
+        _failed = true;
+        return;
+    }
+
+    _stream->zalloc = (alloc_func)0;
+    _stream->zfree = (free_func)0;
+    _stream->opaque = (voidpf)0;
+
+    _stream->next_in = const_cast<unsigned char*>(in);
+    _stream->avail_in = static_cast<unsigned int>(inLength);
+
+    if (inflateInit2(_stream, 15 + 32) != Z_OK)
+    {
+        CCLOG("cocos2d: ZipUtils: Incompatible zlib version!");
+        delete _stream;
+        _stream = nullptr;
+        _failed = true;
+    }
+}
+
+InflateStream::~InflateStream()
+{
+    if (_stream)
+    {
+        inflateEnd(_stream);
+        delete _stream;
+    }
+}
+
+ssize_t InflateStream::read(unsigned char *out, ssize_t outLength)
+{
+    if (_failed)
+    {
+        return -1;
+    }
+
+    if (_finished || outLength <= 0)
+    {
+        return 0;
+    }
+
+    _stream->next_out = out;
+    _stream->avail_out = static_cast<unsigned int>(outLength);
+
+    for (;;)
+    {
+        int err = inflate(_stream, Z_NO_FLUSH);
+        ssize_t written = outLength - _stream->avail_out;
+
+        if (err == Z_STREAM_END)
+        {
+            _finished = true;
+            return written;
+        }
+
+        // Z_BUF_ERROR means no progress was possible with room left in out, so the input ran out early
+        if (err != Z_OK)
+        {
+            if (err == Z_BUF_ERROR)
+            {
+                CCLOG("cocos2d: ZipUtils: Compressed data is truncated!");
+            }
+            else
+            {
+                CCLOG("cocos2d: ZipUtils: Incorrect zlib compressed data!");
+            }
+            _failed = true;
+            return -1;
+        }
+
+        // headers can be consumed without producing anything, keep going so 0 only ever means the end
+        if (written > 0)
+        {
+            return written;
+        }
+    }
+}
+
 // --------------------- ZipFile ---------------------
 // from unzip.cpp
 #define UNZ_MAXFILENAMEINZIP 256
@@ -610,68 +767,136 @@ bool ZipFile::fileExists(const std::string &fileName) const
     return ret;
 }
 
+ssize_t ZipFile::getFileSize(const std::string &fileName) const
+{
+    ssize_t size = -1;
+    do
+    {
+        CC_BREAK_IF(!_data);
+
+        ZipFilePrivate::FileListContainer::const_iterator it = _data->fileList.find(fileName);
+        CC_BREAK_IF(it == _data->fileList.end());
+
+        size = static_cast<ssize_t>(it->second.uncompressed_size);
+    } while (0);
+
+    return size;
+}
+
 unsigned char *ZipFile::getFileData(const std::string &fileName, ssize_t *size)
 {
     unsigned char * buffer = nullptr;
     if (size)
         *size = 0;
 
+    do
+    {
+        ssize_t fileSize = getFileSize(fileName);
+        CC_BREAK_IF(fileSize < 0);
+
+        buffer = (unsigned char*)malloc(fileSize);
+        CC_BREAK_IF(!buffer);
+
+        if (getFileData(fileName, buffer, fileSize) < 0)
+        {
+            free(buffer);
+            buffer = nullptr;
+            break;
+        }
+
+        if (size)
+        {
+            *size = fileSize;
+        }
+    } while (0);
+
+    return buffer;
+}
+
+bool ZipFile::getFileData(const std::string &fileName, ResizableBuffer* buffer)
+{
+    bool res = false;
+    do
+    {
+        ssize_t fileSize = getFileSize(fileName);
+        CC_BREAK_IF(fileSize < 0);
+
+        // sized once from the zip header, then inflated in place
+        buffer->resize(fileSize);
+        res = getFileData(fileName, static_cast<unsigned char*>(buffer->buffer()), fileSize) >= 0;
+    } while (0);
+
+    return res;
+}
+
+ssize_t ZipFile::getFileData(const std::string &fileName, unsigned char *out, ssize_t outLength)
+{
+    ssize_t size = -1;
     do
     {
         CC_BREAK_IF(!_data->zipFile);
         CC_BREAK_IF(fileName.empty());
-        
+
         ZipFilePrivate::FileListContainer::const_iterator it = _data->fileList.find(fileName);
         CC_BREAK_IF(it ==  _data->fileList.end());
-        
+
         ZipEntryInfo fileInfo = it->second;
-        
+        CC_BREAK_IF(outLength < (ssize_t)fileInfo.uncompressed_size);
+
         int nRet = unzGoToFilePos(_data->zipFile, &fileInfo.pos);
         CC_BREAK_IF(UNZ_OK != nRet);
-        
+
         nRet = unzOpenCurrentFile(_data->zipFile);
         CC_BREAK_IF(UNZ_OK != nRet);
-        
-        buffer = (unsigned char*)malloc(fileInfo.uncompressed_size);
-        int CC_UNUSED nSize = unzReadCurrentFile(_data->zipFile, buffer, static_cast<unsigned int>(fileInfo.uncompressed_size));
-        CCASSERT(nSize == 0 || nSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
-        
-        if (size)
-        {
-            *size = fileInfo.uncompressed_size;
-        }
+
+        int nSize = unzReadCurrentFile(_data->zipFile, out, static_cast<unsigned int>(fileInfo.uncompressed_size));
         unzCloseCurrentFile(_data->zipFile);
+        CC_BREAK_IF(nSize != (int)fileInfo.uncompressed_size);
+
+        size = fileInfo.uncompressed_size;
     } while (0);
-    
-    return buffer;
+
+    return size;
 }
 
-bool ZipFile::getFileData(const std::string &fileName, ResizableBuffer* buffer)
+bool ZipFile::readFileInChunks(const std::string &fileName, unsigned char *chunk, ssize_t chunkSize,
+                               const std::function<bool(const unsigned char*, ssize_t)>& callback)
 {
     bool res = false;
     do
     {
         CC_BREAK_IF(!_data->zipFile);
         CC_BREAK_IF(fileName.empty());
-        
+        CC_BREAK_IF(!chunk || chunkSize <= 0);
+
         ZipFilePrivate::FileListContainer::const_iterator it = _data->fileList.find(fileName);
         CC_BREAK_IF(it ==  _data->fileList.end());
-        
+
         ZipEntryInfo fileInfo = it->second;
-        
+
         int nRet = unzGoToFilePos(_data->zipFile, &fileInfo.pos);
         CC_BREAK_IF(UNZ_OK != nRet);
-        
+
         nRet = unzOpenCurrentFile(_data->zipFile);
         CC_BREAK_IF(UNZ_OK != nRet);
-        
-        buffer->resize(fileInfo.uncompressed_size);
-        int CC_UNUSED nSize = unzReadCurrentFile(_data->zipFile, buffer->buffer(), static_cast<unsigned int>(fileInfo.uncompressed_size));
-        CCASSERT(nSize == 0 || nSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
-        unzCloseCurrentFile(_data->zipFile);
-        res = true;
+
+        ssize_t remaining = fileInfo.uncompressed_size;
+        while (remaining > 0)
+        {
+            ssize_t toRead = remaining < chunkSize ? remaining : chunkSize;
+            int nSize = unzReadCurrentFile(_data->zipFile, chunk, static_cast<unsigned int>(toRead));
+            if (nSize <= 0 || !callback(chunk, nSize))
+            {
+                break;
+            }
+            remaining -= nSize;
+        }
+
+        // the crc is only checked once the whole file has been read
+        nRet = unzCloseCurrentFile(_data->zipFile);
+        res = remaining == 0 && nRet == UNZ_OK;
     } while (0);
-    
+
     return res;
 }
 
@@ -29,6 +29,7 @@ THE SOFTWARE.
 /// @cond DO_NOT_SHOW
 
 #include <string>
+#include <functional>
 #include "platform/CCPlatformConfig.h"
 #include "platform/CCPlatformMacros.h"
 #include "platform/CCPlatformDefine.h"
@@ -46,6 +47,9 @@ THE SOFTWARE.
  * @{
  */
 
+// zlib's stream, so zlib.h doesn't have to be included here
+struct z_stream_s;
+
 namespace cocos2d
 {
 #ifndef _unz64_H
@@ -94,6 +98,28 @@ typedef struct unz_file_info_s unz_file_info;
         CC_DEPRECATED_ATTRIBUTE static ssize_t ccInflateMemoryWithHint(unsigned char *in, ssize_t inLength, unsigned char **out, ssize_t outLengthHint) { return inflateMemoryWithHint(in, inLength, out, outLengthHint); }
         static ssize_t inflateMemoryWithHint(unsigned char *in, ssize_t inLength, unsigned char **out, ssize_t outLengthHint);
 
+        /**
+        * Inflates either zlib or gzip deflated memory into a buffer owned by the caller, in a single pass.
+        *
+        * Use it when the inflated size is known up front (e.g. TMX layer data), it never allocates or reallocates.
+        *
+        * @param out Buffer that receives the inflated data.
+        * @param outLength Size of out in bytes.
+        *
+        * @return The length of the inflated data, or -1 if the data is corrupt or doesn't fit in out.
+        */
+        static ssize_t inflateMemoryTo(unsigned char *in, ssize_t inLength, unsigned char *out, ssize_t outLength);
+
+        /**
+        * Gets the inflated size of deflated memory when the format records it, so the output can be allocated
+        * exactly once, or handed to inflateMemoryTo.
+        *
+        * Gzip stores the size in its trailer (modulo 2^32, which is fine for any asset), zlib doesn't store it.
+        *
+        * @return The inflated size, or -1 if it isn't known.
+        */
+        static ssize_t getInflatedSize(const unsigned char *in, ssize_t inLength);
+
         /** 
          * Inflates a GZip file into memory.
          *
@@ -219,6 +245,45 @@ typedef struct unz_file_info_s unz_file_info;
         static bool s_bEncryptionKeyIsValid;
     };
 
+    /**
+    * Inflates zlib or gzip deflated memory a piece at a time, into buffers owned by the caller.
+    *
+    * Use it for payloads too large to hold inflated all at once, or to inflate straight into slices of
+    * buffers that already exist. Each read() continues where the previous one stopped.
+    */
+    class CC_DLL InflateStream
+    {
+    public:
+        /**
+        * @param in Deflated memory, which must stay valid while the stream is used.
+        * @param inLength Size of in in bytes.
+        */
+        InflateStream(const unsigned char *in, ssize_t inLength);
+        ~InflateStream();
+
+        /**
+        * Inflates the next part of the stream.
+        *
+        * @param out Buffer that receives the inflated data.
+        * @param outLength Size of out in bytes.
+        *
+        * @return The number of bytes written to out, 0 once the stream has ended, or -1 if the data is corrupt
+        *         or truncated.
+        */
+        ssize_t read(unsigned char *out, ssize_t outLength);
+
+        /** Returns true once the whole stream has been inflated. */
+        bool isFinished() const { return _finished; }
+
+    private:
+        InflateStream(const InflateStream&) = delete;
+        InflateStream& operator=(const InflateStream&) = delete;
+
+        z_stream_s *_stream;
+        bool _finished;
+        bool _failed;
+    };
+
     // forward declaration
     class ZipFilePrivate;
     struct unz_file_info_s;
@@ -286,6 +351,34 @@ typedef struct unz_file_info_s unz_file_info;
         */
         bool getFileData(const std::string &fileName, ResizableBuffer* buffer);
 
+        /**
+        * Get resource file data from a zip file, into a buffer owned by the caller.
+        * Nothing is allocated, so out can be a slice of a larger buffer.
+        * @param fileName File name
+        * @param out Buffer that receives the file data, at least getFileSize() bytes.
+        * @param outLength Size of out in bytes.
+        * @return The size of the file, or -1 if it doesn't exist, can't be read or doesn't fit in out.
+        */
+        ssize_t getFileData(const std::string &fileName, unsigned char *out, ssize_t outLength);
+
+        /**
+        * Read a file from a zip file a chunk at a time, so large files never have to be held in memory whole.
+        * @param fileName File name
+        * @param chunk Buffer owned by the caller that each chunk is read into.
+        * @param chunkSize Size of chunk in bytes.
+        * @param callback Called with each chunk and its size, in order. Return false to stop reading.
+        * @return True if the whole file was read.
+        */
+        bool readFileInChunks(const std::string &fileName, unsigned char *chunk, ssize_t chunkSize,
+                              const std::function<bool(const unsigned char*, ssize_t)>& callback);
+
+        /**
+        * Get the uncompressed size of a file from the zip header.
+        * @param fileName File name
+        * @return The size of the file, or -1 if it doesn't exist.
+        */
+        ssize_t getFileSize(const std::string &fileName) const;
+
         std::string getFirstFilename();
         std::string getNextFilename();
         
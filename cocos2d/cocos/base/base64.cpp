@@ -32,29 +32,67 @@ namespace cocos2d {
 
 unsigned char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     
-int _base64Decode(const unsigned char *input, unsigned int input_len, unsigned char *output, unsigned int *output_len )
+// Maps each character to its 6 bit value, or to 255 if it isn't part of the alphabet ('=' included).
+static const unsigned char decoder[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+int _base64Decode(const unsigned char *input, unsigned int input_len, unsigned char *output, unsigned int output_capacity, unsigned int *output_len )
 {
-    static char inalphabet[256], decoder[256];
-    int i, bits, c = 0, char_count, errors = 0;
+    int bits, c = 0, char_count, errors = 0;
     unsigned int input_idx = 0;
     unsigned int output_idx = 0;
 
-    for (i = (sizeof alphabet) - 1; i >= 0 ; i--) {
-        inalphabet[alphabet[i]] = 1;
-        decoder[alphabet[i]] = i;
-    }
-
     char_count = 0;
     bits = 0;
     for( input_idx=0; input_idx < input_len ; input_idx++ ) {
+        // Fast path: whole quanta of valid characters decode straight to 3 bytes. Whitespace, padding and
+        // anything else outside of the alphabet drop back to the character by character loop below.
+        if (char_count == 0) {
+            while (input_idx + 4 <= input_len && output_idx + 3 <= output_capacity) {
+                const unsigned char *quantum = input + input_idx;
+                unsigned int c0 = decoder[quantum[0]], c1 = decoder[quantum[1]], c2 = decoder[quantum[2]], c3 = decoder[quantum[3]];
+                if ((c0 | c1 | c2 | c3) & 0x80)
+                    break;
+
+                unsigned int value = (c0 << 18) | (c1 << 12) | (c2 << 6) | c3;
+                output[ output_idx++ ] = (value >> 16);
+                output[ output_idx++ ] = ((value >> 8) & 0xff);
+                output[ output_idx++ ] = ( value & 0xff);
+                input_idx += 4;
+            }
+            if (input_idx >= input_len)
+                break;
+        }
+
         c = input[ input_idx ];
         if (c == '=')
             break;
-        if (c > 255 || ! inalphabet[c])
+        if (decoder[c] == 255)
             continue;
         bits += decoder[c];
         char_count++;
         if (char_count == 4) {
+            if (output_idx + 3 > output_capacity) {
+                char_count = 0;
+                errors++;
+                break;
+            }
             output[ output_idx++ ] = (bits >> 16);
             output[ output_idx++ ] = ((bits >> 8) & 0xff);
             output[ output_idx++ ] = ( bits & 0xff);
@@ -66,6 +104,10 @@ int _base64Decode(const unsigned char *input, unsigned int input_len, unsigned c
     }
     
     if( c == '=' ) {
+        if (char_count > 1 && output_idx + char_count - 1 > output_capacity) {
+            char_count = 0;
+            errors++;
+        }
         switch (char_count) {
             case 1:
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_BADA)
@@ -145,7 +187,7 @@ int base64Decode(const unsigned char *in, unsigned int inLength, unsigned char *
     //should be enough to store 6-bit buffers in 8-bit buffers
     *out = (unsigned char*)malloc(inLength / 4 * 3 + 1);
     if( *out ) {
-        int ret = _base64Decode(in, inLength, *out, &outLength);
+        int ret = _base64Decode(in, inLength, *out, inLength / 4 * 3 + 1, &outLength);
         
         if (ret > 0 )
         {
@@ -160,6 +202,19 @@ int base64Decode(const unsigned char *in, unsigned int inLength, unsigned char *
     return outLength;
 }
 
+int base64DecodeTo(const unsigned char *in, unsigned int inLength, unsigned char *out, unsigned int outLength)
+{
+    unsigned int decodedLength = 0;
+    if (_base64Decode(in, inLength, out, outLength, &decodedLength) > 0)
+    {
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_BADA)
+        printf("Base64Utils: error decoding");
+#endif
+        return -1;
+    }
+    return decodedLength;
+}
+
 int base64Encode(const unsigned char *in, unsigned int inLength, char **out) {
     unsigned int outLength = (inLength + 2) / 3 * 4;
     
@@ -50,6 +50,14 @@ namespace cocos2d {
  */
 int CC_DLL base64Decode(const unsigned char *in, unsigned int inLength, unsigned char **out);
     
+/**
+ * Decodes a 64base encoded memory into a buffer owned by the caller, without allocating.
+ * `in` and `out` may point to the same memory, in which case the data is decoded in place.
+ *
+ * @returns the length of the decoded data, or -1 if the input is invalid or doesn't fit in `outLength` bytes
+ */
+int CC_DLL base64DecodeTo(const unsigned char *in, unsigned int inLength, unsigned char *out, unsigned int outLength);
+
 /**
  * Encodes bytes into a 64base encoded memory with terminating '\0' character. 
  * The encoded memory is expected to be freed by the caller by calling `free()`
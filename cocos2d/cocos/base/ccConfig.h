@@ -165,6 +165,53 @@ THE SOFTWARE.
 #define CC_TEXTURE_ATLAS_USE_VAO 1
 #endif
 
+/** @def CC_TEXTURE_CACHE_LOADING_THREADS
+ * Maximum number of threads TextureCache::addImageAsync decodes images on. One core is left for the GL thread,
+ * so fewer threads are used on devices with fewer cores.
+ */
+#ifndef CC_TEXTURE_CACHE_LOADING_THREADS
+#define CC_TEXTURE_CACHE_LOADING_THREADS 4
+#endif
+
+/** @def CC_TEXTURE_CACHE_UPLOAD_BUDGET
+ * Microseconds per frame TextureCache spends uploading asynchronously loaded images. Uncompressed images are
+ * uploaded in bands of rows so a large atlas is spread over several frames instead of stalling one. At least
+ * one band is uploaded every frame.
+ */
+#ifndef CC_TEXTURE_CACHE_UPLOAD_BUDGET
+#define CC_TEXTURE_CACHE_UPLOAD_BUDGET 4000
+#endif
+
+/** @def CC_JOB_SYSTEM_THREADS
+ * Maximum number of worker threads JobSystem runs jobs on, besides the thread that starts them. Two cores are
+ * left for the rest of the process, so fewer threads are used on devices with fewer cores.
+ */
+#ifndef CC_JOB_SYSTEM_THREADS
+#define CC_JOB_SYSTEM_THREADS 3
+#endif
+
+/** @def CC_RENDERER_STREAM_BUFFER
+ * If enabled, Renderer streams batched triangles into a ring buffer mapped with glMapBufferRange when the GL
+ * supports it, instead of reallocating its vertex and index buffers for every batch. The ring is orphaned when
+ * it wraps, so a region is never written while a draw that reads it may still be in flight.
+ */
+#ifndef CC_RENDERER_STREAM_BUFFER
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID || CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 || CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+#define CC_RENDERER_STREAM_BUFFER 1
+#else
+#define CC_RENDERER_STREAM_BUFFER 0
+#endif
+#endif
+
+/** @def CC_TMX_BAKED_LAYERS
+ * If enabled, TMXTiledMap creates TMXBakedLayer for orthogonal layers. Their tiles are baked once into static
+ * vertex buffers and culled in chunks, instead of being pushed through the TextureAtlas every frame.
+ * To disable it set it to 0. Enabled by default.
+ */
+#ifndef CC_TMX_BAKED_LAYERS
+#define CC_TMX_BAKED_LAYERS 1
+#endif
+
 
 /** @def CC_USE_LA88_LABELS
  * If enabled, it will use LA88 (Luminance Alpha 16-bit textures) for LabelTTF objects.
@@ -247,6 +294,16 @@ THE SOFTWARE.
 #define CC_ENABLE_PROFILERS 0
 #endif
 
+/** @def CC_ENABLE_TRACE_PROFILER
+ * If enabled, the frame-phase trace markers (CC_PROFILER_TRACE) are compiled in. They record nothing until a
+ * capture is started with TraceProfiler::start() or the `trace start` console command, and cost one relaxed
+ * atomic load each while idle.
+ * To disable set it to 0. Enabled by default.
+ */
+#ifndef CC_ENABLE_TRACE_PROFILER
+#define CC_ENABLE_TRACE_PROFILER 1
+#endif
+
 /** Enable Lua engine debug log. */
 #ifndef CC_LUA_ENGINE_DEBUG
 #define CC_LUA_ENGINE_DEBUG 0
@@ -386,6 +443,16 @@ THE SOFTWARE.
 # define CC_ALLOCATOR_GLOBAL_NEW_DELETE cocos2d::allocator::AllocatorStrategyGlobalSmallBlock
 #endif
 
+/** @def CC_ENABLE_REF_POOL
+ * If enabled, every Ref is allocated from RefPool instead of the global heap. Blocks are grouped in size
+ * classes, cached per thread and recycled, so the short lived objects created every frame (actions,
+ * events, ...) don't go through malloc and free. The stats overlay then shows Ref allocations per frame.
+ * Memory given to the pool is kept for reuse and never returned to the heap.
+ */
+#ifndef CC_ENABLE_REF_POOL
+# define CC_ENABLE_REF_POOL 0
+#endif
+
 #ifndef CC_FILEUTILS_APPLE_ENABLE_OBJC
 #define CC_FILEUTILS_APPLE_ENABLE_OBJC  1
 #endif
@@ -40,6 +40,7 @@ THE SOFTWARE.
 
 // base
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCJobSystem.h"
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCConsole.h"
@@ -275,6 +276,7 @@ THE SOFTWARE.
 // tilemap_parallax_nodes
 #include "2d/CCParallaxNode.h"
 #include "2d/CCTMXLayer.h"
+#include "2d/CCTMXBakedLayer.h"
 #include "2d/CCTMXObjectGroup.h"
 #include "2d/CCTMXTiledMap.h"
 #include "2d/CCTMXXMLParser.h"
@@ -930,6 +930,16 @@ void Mat4::transformVector(const Vec4& vector, Vec4* dst) const
 #endif
 }
 
+void Mat4::transformPoints(Vec3* points, size_t count, size_t stride) const
+{
+    GP_ASSERT(points || count == 0);
+#ifdef __SSE__
+    MathUtil::transformVertices(col, (float*)points, count, stride);
+#else
+    MathUtil::transformVertices(m, (float*)points, count, stride);
+#endif
+}
+
 void Mat4::translate(float x, float y, float z)
 {
     translate(x, y, z, this);
@@ -773,6 +773,19 @@ public:
      */
     inline void transformPoint(const Vec3& point, Vec3* dst) const { GP_ASSERT(dst); transformVector(point.x, point.y, point.z, 1.0f, dst); }
 
+    /**
+     * Transforms a batch of points by this matrix, in place.
+     *
+     * Points may be interleaved with other data: only the x, y and z of each
+     * point are read and written, so e.g. the positions of a vertex array can
+     * be transformed without touching their colors or texture coordinates.
+     *
+     * @param points The first point to transform.
+     * @param count The number of points.
+     * @param stride The distance in bytes from one point to the next.
+     */
+    void transformPoints(Vec3* points, size_t count, size_t stride = sizeof(Vec3)) const;
+
     /**
      * Transforms the specified vector by this matrix by
      * treating the fourth (w) coordinate as zero.
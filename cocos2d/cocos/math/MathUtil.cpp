@@ -262,6 +262,20 @@ void MathUtil::transformVec4(const float* m, const float* v, float* dst)
 #endif
 }
 
+void MathUtil::transformVertices(const float* m, float* vertices, size_t count, size_t stride)
+{
+#ifdef USE_NEON32
+    MathUtilNeon::transformVertices(m, vertices, count, stride);
+#elif defined (USE_NEON64)
+    MathUtilNeon64::transformVertices(m, vertices, count, stride);
+#elif defined (INCLUDE_NEON32)
+    if(isNeon32Enabled()) MathUtilNeon::transformVertices(m, vertices, count, stride);
+    else MathUtilC::transformVertices(m, vertices, count, stride);
+#else
+    MathUtilC::transformVertices(m, vertices, count, stride);
+#endif
+}
+
 void MathUtil::crossVec3(const float* v1, const float* v2, float* dst)
 {
 #ifdef USE_NEON32
@@ -40,6 +40,8 @@ public:
     inline static void transformVec4(const float* m, float x, float y, float z, float w, float* dst);
     
     inline static void transformVec4(const float* m, const float* v, float* dst);
+
+    inline static void transformVertices(const float* m, float* vertices, size_t count, size_t stride);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
 };
@@ -223,6 +225,36 @@ inline void MathUtilNeon64::transformVec4(const float* m, const float* v, float*
     );
 }
 
+inline void MathUtilNeon64::transformVertices(const float* m, float* vertices, size_t count, size_t stride)
+{
+    if (count == 0)
+        return;
+
+    // only x, y and z are loaded and stored, the bytes between vertices are left alone
+    asm volatile
+    (
+        "ld1    {v9.4s, v10.4s, v11.4s, v12.4s}, [%2] \n\t"   // M[m0-m7] M[m8-m15]
+
+        "1:                                 \n\t"
+        "ld1    {v0.2s}, [%0], 8            \n\t"   // V[x, y]
+        "ld1    {v0.s}[2], [%0]             \n\t"   // V[z]
+
+        "mov    v13.16b, v12.16b            \n\t"   // DST->V = M[m12-m15]
+        "fmla   v13.4s, v9.4s, v0.s[0]      \n\t"   // DST->V += M[m0-m3] * V[x]
+        "fmla   v13.4s, v10.4s, v0.s[1]     \n\t"   // DST->V += M[m4-m7] * V[y]
+        "fmla   v13.4s, v11.4s, v0.s[2]     \n\t"   // DST->V += M[m8-m11] * V[z]
+
+        "st1    {v13.s}[2], [%0]            \n\t"   // DST->V[z]
+        "sub    %0, %0, #8                  \n\t"
+        "st1    {v13.2s}, [%0], %3          \n\t"   // DST->V[x, y], then on to the next vertex
+        "subs   %1, %1, #1                  \n\t"
+        "b.ne   1b                          \n\t"
+        : "+r"(vertices), "+r"(count)
+        : "r"(m), "r"(stride)
+        : "v0", "v9", "v10", "v11", "v12", "v13", "cc", "memory"
+    );
+}
+
 inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* dst)
 {
         asm volatile(
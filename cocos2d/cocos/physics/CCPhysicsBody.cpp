@@ -898,11 +898,21 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform, const Mat
     // set position
     auto worldPosition = _ownerCenterOffset;
     nodeToWorldTransform.transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
-    setPosition(worldPosition.x, worldPosition.y);
+
+    bool syncOnlyMoved = _world && _world->isSyncOnlyMovedBodies();
+    bool moved = !syncOnlyMoved || getPosition() != Vec2(worldPosition.x, worldPosition.y);
 
     _recordPosX = worldPosition.x;
     _recordPosY = worldPosition.y;
 
+    // setting the position wakes the body up, so leave it alone if its node is where the body already is
+    if (!moved)
+    {
+        return;
+    }
+
+    setPosition(worldPosition.x, worldPosition.y);
+
     if (_owner->getAnchorPoint() != Vec2::ANCHOR_MIDDLE)
     {
         parentToWorldTransform.getInversed().transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
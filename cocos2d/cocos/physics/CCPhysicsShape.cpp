@@ -260,9 +260,12 @@ void PhysicsShape::setSensor(bool sensor)
 {
     if (sensor != _sensor)
     {
+        // a contact only world keeps every shape a sensor
+        auto world = _body ? _body->getWorld() : nullptr;
+        bool contactOnly = world && world->isContactOnly();
         for (cpShape* shape : _cpShapes)
         {
-            cpShapeSetSensor(shape, sensor);
+            cpShapeSetSensor(shape, sensor || contactOnly);
         }
         _sensor = sensor;
     }
@@ -40,6 +40,7 @@
 #include "base/CCDirector.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventCustom.h"
+#include "base/CCProfiling.h"
 
 NS_CC_BEGIN
 const float PHYSICS_INFINITY = FLT_MAX;
@@ -752,6 +753,7 @@ void PhysicsWorld::addShape(PhysicsShape* physicsShape)
     {
         for (auto shape : physicsShape->_cpShapes)
         {
+            cpShapeSetSensor(shape, _contactOnly || physicsShape->isSensor());
             cpSpaceAddShape(_cpSpace, shape);
         }
     }
@@ -857,6 +859,57 @@ void PhysicsWorld::setSubsteps(int steps)
     }
 }
 
+void PhysicsWorld::useSpatialHash(float cellSize, int count)
+{
+    CCASSERT(!cpSpaceIsLocked(_cpSpace), "the broadphase can not be changed while the world is stepped");
+
+    if (cellSize > 0.0f && count > 0)
+    {
+        _spatialHashCellSize = cellSize;
+        cpSpaceUseSpatialHash(_cpSpace, cellSize, count);
+    }
+}
+
+void PhysicsWorld::setSleepTimeThreshold(float seconds)
+{
+    cpSpaceSetSleepTimeThreshold(_cpSpace, seconds);
+}
+
+float PhysicsWorld::getSleepTimeThreshold() const
+{
+    return cpSpaceGetSleepTimeThreshold(_cpSpace);
+}
+
+void PhysicsWorld::setIdleSpeedThreshold(float speed)
+{
+    cpSpaceSetIdleSpeedThreshold(_cpSpace, speed);
+}
+
+float PhysicsWorld::getIdleSpeedThreshold() const
+{
+    return cpSpaceGetIdleSpeedThreshold(_cpSpace);
+}
+
+void PhysicsWorld::setContactOnly(bool contactOnly)
+{
+    if (_contactOnly == contactOnly)
+    {
+        return;
+    }
+
+    _contactOnly = contactOnly;
+    for (auto& body : _bodies)
+    {
+        for (auto& shape : body->getShapes())
+        {
+            for (auto cps : shape->_cpShapes)
+            {
+                cpShapeSetSensor(cps, contactOnly || shape->isSensor());
+            }
+        }
+    }
+}
+
 void PhysicsWorld::step(float delta)
 {
     if (_autoStep)
@@ -871,6 +924,8 @@ void PhysicsWorld::step(float delta)
 
 void PhysicsWorld::update(float delta, bool userCall/* = false*/)
 {
+    CC_PROFILER_TRACE("PhysicsWorld::update");
+
     if(!_delayAddBodies.empty())
     {
         updateBodies();
@@ -974,6 +1029,9 @@ PhysicsWorld::PhysicsWorld()
 , _substeps(1)
 , _fixedRate(0)
 , _cpSpace(nullptr)
+, _spatialHashCellSize(0.0f)
+, _syncOnlyMovedBodies(false)
+, _contactOnly(false)
 , _updateBodyTransform(false)
 , _scene(nullptr)
 , _autoStep(true)
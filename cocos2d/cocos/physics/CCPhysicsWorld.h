@@ -302,6 +302,85 @@ public:
     /** get the number of substeps */
     int getFixedUpdateRate() const { return _fixedRate; }
 
+    /**
+     * Use a spatial hash instead of the default bounding box tree to find shapes that may touch.
+     *
+     * The hash is faster when most shapes are about the same size, like the actors of a tile map. It can be
+     * called again to change the cell size, but there is no way back to the tree.
+     * @attention Don't call it from a contact callback, the space is locked while it is stepped.
+     * @param cellSize A float number, about the size of an average shape.
+     * @param count An integer number, the minimum number of cells. About 10 times the number of shapes.
+     */
+    void useSpatialHash(float cellSize, int count);
+
+    /**
+     * Get the cell size of the spatial hash.
+     *
+     * @return A float number, 0 while the bounding box tree is used.
+     */
+    float getSpatialHashCellSize() const { return _spatialHashCellSize; }
+
+    /**
+     * Set how long bodies have to stay idle before they fall asleep.
+     *
+     * Sleeping bodies aren't simulated until something touches or moves them. Nodes are synced to their
+     * bodies every frame, which keeps them awake unless setSyncOnlyMovedBodies(true) is used as well.
+     * @param seconds A float number, default value is PHYSICS_INFINITY, which disables sleeping.
+     */
+    void setSleepTimeThreshold(float seconds);
+
+    /**
+     * Get how long bodies have to stay idle before they fall asleep.
+     *
+     * @return A float number.
+     */
+    float getSleepTimeThreshold() const;
+
+    /**
+     * Set the speed under which a body counts as idle.
+     *
+     * @param speed A float number, default value is 0, which derives it from the gravity.
+     */
+    void setIdleSpeedThreshold(float speed);
+
+    /**
+     * Get the speed under which a body counts as idle.
+     *
+     * @return A float number.
+     */
+    float getIdleSpeedThreshold() const;
+
+    /**
+     * Only push node transforms to bodies whose node moved since the last step.
+     *
+     * Bodies of nodes that stayed in place are left alone, so they don't wake up and aren't re-indexed.
+     * @param syncOnlyMoved A bool object, default value is false.
+     */
+    void setSyncOnlyMovedBodies(bool syncOnlyMoved) { _syncOnlyMovedBodies = syncOnlyMoved; }
+
+    /**
+     * Get whether only bodies whose node moved are synced.
+     *
+     * @return A bool object.
+     */
+    bool isSyncOnlyMovedBodies() const { return _syncOnlyMovedBodies; }
+
+    /**
+     * Make every shape of this physics world a sensor.
+     *
+     * Contact listeners are still called, but no collision response is solved. Use it when contacts are only
+     * used to find out what touched what. Shapes get their own sensor setting back when it is turned off.
+     * @param contactOnly A bool object, default value is false.
+     */
+    void setContactOnly(bool contactOnly);
+
+    /**
+     * Get whether every shape of this physics world is a sensor.
+     *
+     * @return A bool object.
+     */
+    bool isContactOnly() const { return _contactOnly; }
+
     /**
     * Set the debug draw mask of this physics world.
     * 
@@ -377,6 +456,9 @@ protected:
     int _substeps;
     int _fixedRate;
     cpSpace* _cpSpace;
+    float _spatialHashCellSize;
+    bool _syncOnlyMovedBodies;
+    bool _contactOnly;
     
     bool _updateBodyTransform;
     Vector<PhysicsBody*> _bodies;
@@ -42,6 +42,13 @@ THE SOFTWARE.
 #endif
 #include <sys/stat.h>
 
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32) && (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+#define CC_FILEUTILS_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 NS_CC_BEGIN
 
 // Implement DictMaker
@@ -103,7 +110,12 @@ public:
         CCASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
         parser.setDelegator(this);
 
-        parser.parse(fileName);
+        // The file is read into memory we own anyway, so parse it in place rather than building a DOM.
+        Data data = FileUtils::getInstance()->getDataFromFile(fileName);
+        if (!data.isNull())
+        {
+            parser.parseIntrusive((char*)data.getBytes(), data.getSize());
+        }
         return _rootDict;
     }
 
@@ -115,7 +127,12 @@ public:
         CCASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
         parser.setDelegator(this);
 
-        parser.parse(filedata, filesize);
+        // One copy to parse in place is still cheaper than the DOM the tinyxml2 parser would build.
+        std::string buffer(filedata, filesize);
+        if (!buffer.empty())
+        {
+            parser.parseIntrusive(&buffer.front(), buffer.size());
+        }
         return _rootDict;
     }
 
@@ -127,7 +144,11 @@ public:
         CCASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
         parser.setDelegator(this);
 
-        parser.parse(fileName);
+        Data data = FileUtils::getInstance()->getDataFromFile(fileName);
+        if (!data.isNull())
+        {
+            parser.parseIntrusive((char*)data.getBytes(), data.getSize());
+        }
         return _rootArray;
     }
 
@@ -622,6 +643,56 @@ void FileUtils::purgeCachedEntries()
     _fullPathCache.clear();
 }
 
+bool FileUtils::FullPathCache::find(const std::string& filename, std::string* fullPath) const
+{
+    const Shard& shard = getShard(filename);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto iter = shard.paths.find(filename);
+    if (iter == shard.paths.end())
+        return false;
+
+    *fullPath = iter->second;
+    return true;
+}
+
+void FileUtils::FullPathCache::emplace(const std::string& filename, const std::string& fullPath)
+{
+    Shard& shard = getShard(filename);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.paths.emplace(filename, fullPath);
+}
+
+void FileUtils::FullPathCache::clear()
+{
+    for (auto& shard : _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.paths.clear();
+    }
+}
+
+std::unordered_map<std::string, std::string> FileUtils::FullPathCache::snapshot() const
+{
+    std::unordered_map<std::string, std::string> paths;
+    for (const auto& shard : _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        paths.insert(shard.paths.begin(), shard.paths.end());
+    }
+    return paths;
+}
+
+const FileUtils::FullPathCache::Shard& FileUtils::FullPathCache::getShard(const std::string& filename) const
+{
+    return _shards[std::hash<std::string>()(filename) % SHARD_COUNT];
+}
+
+FileUtils::FullPathCache::Shard& FileUtils::FullPathCache::getShard(const std::string& filename)
+{
+    return _shards[std::hash<std::string>()(filename) % SHARD_COUNT];
+}
+
 std::string FileUtils::getStringFromFile(const std::string& filename)
 {
     std::string s;
@@ -631,8 +702,8 @@ std::string FileUtils::getStringFromFile(const std::string& filename)
 
 void FileUtils::getStringFromFile(const std::string &path, std::function<void (std::string)> callback)
 {
-    // Get the full path on the main thread, to avoid the issue that FileUtil's is not
-    // thread safe, and accessing the fullPath cache and searching the search paths is not thread safe
+    // Get the full path on the main thread, the fullPath cache is thread safe but the search paths are only
+    // meant to be used on the main thread
     auto fullPath = fullPathForFilename(path);
     performOperationOffthread([fullPath]() -> std::string {
         return FileUtils::getInstance()->getStringFromFile(fullPath);
@@ -693,6 +764,63 @@ FileUtils::Status FileUtils::getContents(const std::string& filename, ResizableB
     return Status::OK;
 }
 
+FileView::FileView()
+: _bytes(nullptr)
+, _size(0)
+, _mapped(false)
+{
+}
+
+FileView::~FileView()
+{
+#if CC_FILEUTILS_USE_MMAP
+    if (_mapped)
+        munmap(const_cast<unsigned char*>(_bytes), _size);
+#endif
+}
+
+std::shared_ptr<const FileView> FileUtils::mapFile(const std::string& filename)
+{
+    if (filename.empty())
+        return nullptr;
+
+    std::string fullPath = fullPathForFilename(filename);
+    if (fullPath.empty())
+        return nullptr;
+
+    std::shared_ptr<FileView> view(new FileView());
+#if CC_FILEUTILS_USE_MMAP
+    int descriptor = open(getSuitableFOpen(fullPath).c_str(), O_RDONLY);
+    if (descriptor != -1)
+    {
+        struct stat statBuf;
+        if (fstat(descriptor, &statBuf) == 0 && statBuf.st_size >= FileView::MAP_THRESHOLD)
+        {
+            void* bytes = mmap(nullptr, statBuf.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (bytes != MAP_FAILED)
+            {
+                view->_bytes = static_cast<const unsigned char*>(bytes);
+                view->_size = statBuf.st_size;
+                view->_mapped = true;
+            }
+        }
+
+        // the mapping keeps its own reference to the file
+        close(descriptor);
+        if (view->_mapped)
+            return view;
+    }
+#endif
+
+    // small files, and files that aren't on the file system, are read by the platform
+    if (getContents(fullPath, &view->_data) != Status::OK)
+        return nullptr;
+
+    view->_bytes = view->_data.getBytes();
+    view->_size = view->_data.getSize();
+    return view;
+}
+
 unsigned char* FileUtils::getFileData(const std::string& filename, const char* mode, ssize_t *size)
 {
     CCASSERT(!filename.empty() && size != nullptr && mode != nullptr, "Invalid parameters.");
@@ -819,10 +947,10 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if(cacheIter != _fullPathCache.end())
+    std::string cachedPath;
+    if (_fullPathCache.find(filename, &cachedPath))
     {
-        return cacheIter->second;
+        return cachedPath;
     }
 
     // Get the new file name.
@@ -1084,10 +1212,10 @@ bool FileUtils::isDirectoryExist(const std::string& dirPath) const
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(dirPath);
-    if( cacheIter != _fullPathCache.end() )
+    std::string cachedPath;
+    if (_fullPathCache.find(dirPath, &cachedPath))
     {
-        return isDirectoryExistInternal(cacheIter->second);
+        return isDirectoryExistInternal(cachedPath);
     }
 
     std::string fullpath;
@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include <vector>
 #include <unordered_map>
 #include <type_traits>
+#include <memory>
+#include <mutex>
 
 #include "platform/CCPlatformMacros.h"
 #include "base/ccTypes.h"
@@ -117,6 +119,49 @@ public:
     }
 };
 
+/**
+ * Read-only view of the contents of a file, see FileUtils::mapFile.
+ *
+ * Large files are memory mapped, so they are never copied and their pages are only read from storage when they
+ * are touched. Small files, and files that can't be mapped (e.g. assets inside an Android APK), are read into a
+ * buffer owned by the view. Views are shared through std::shared_ptr, so they can be handed between threads,
+ * and the contents stay valid as long as a reference is held. Files must not be written while they are mapped.
+ */
+class CC_DLL FileView
+{
+public:
+    /** Files smaller than this are read rather than mapped, since a small read costs less than a mapping. */
+    static const ssize_t MAP_THRESHOLD = 64 * 1024;
+
+    ~FileView();
+
+    /** Returns the contents of the file, nullptr if it is empty. */
+    const unsigned char* getBytes() const { return _bytes; }
+
+    /** Returns the size of the file in bytes. */
+    ssize_t getSize() const { return _size; }
+
+    /** Returns true if the file is empty. */
+    bool isNull() const { return _size == 0; }
+
+    /** Returns true if the contents are memory mapped, false if they were read into memory. */
+    bool isMapped() const { return _mapped; }
+
+private:
+    friend class FileUtils;
+
+    FileView();
+    FileView(const FileView&) = delete;
+    FileView& operator=(const FileView&) = delete;
+
+    const unsigned char* _bytes;
+    ssize_t _size;
+    bool _mapped;
+
+    // contents of a file that isn't mapped
+    Data _data;
+};
+
 /** Helper class to handle file operations. */
 class CC_DLL FileUtils
 {
@@ -194,6 +239,16 @@ public:
      */
     virtual void getDataFromFile(const std::string& filename, std::function<void(Data)> callback);
 
+    /**
+     *  Gets a read-only view of the contents of a file. Unlike getDataFromFile, large files are memory mapped
+     *  instead of copied into a new buffer, so reading a texture atlas or an archive only costs the page
+     *  faults of the parts that are used. Can be called from any thread.
+     *
+     *  @param filename The path of the file, it could be a relative or an absolute path.
+     *  @return The view, or nullptr if the file can't be read.
+     */
+    virtual std::shared_ptr<const FileView> mapFile(const std::string& filename);
+
     enum class Status
     {
         OK = 0,
@@ -841,8 +896,8 @@ public:
     */
     virtual void listFilesRecursivelyAsync(const std::string& dirPath, std::function<void(std::vector<std::string>)> callback) const;
 
-    /** Returns the full path cache. */
-    const std::unordered_map<std::string, std::string>& getFullPathCache() const { return _fullPathCache; }
+    /** Returns a copy of the full path cache. */
+    std::unordered_map<std::string, std::string> getFullPathCache() const { return _fullPathCache.snapshot(); }
 
     /**
      *  Gets the new filename from the filename lookup dictionary.
@@ -940,11 +995,45 @@ protected:
      */
     std::string _defaultResRootPath;
 
+    /**
+     *  Cache of full paths, safe to use from several threads. Entries are split between shards that each have
+     *  their own lock, so loader threads resolving paths at the same time rarely wait on each other.
+     */
+    class FullPathCache
+    {
+    public:
+        /** Looks up the full path of a file, returns false if it isn't cached. */
+        bool find(const std::string& filename, std::string* fullPath) const;
+
+        /** Caches the full path of a file, unless it is already cached. */
+        void emplace(const std::string& filename, const std::string& fullPath);
+
+        /** Removes every entry. */
+        void clear();
+
+        /** Returns a copy of every entry. */
+        std::unordered_map<std::string, std::string> snapshot() const;
+
+    private:
+        static const size_t SHARD_COUNT = 16;
+
+        struct Shard
+        {
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, std::string> paths;
+        };
+
+        const Shard& getShard(const std::string& filename) const;
+        Shard& getShard(const std::string& filename);
+
+        Shard _shards[SHARD_COUNT];
+    };
+
     /**
      *  The full path cache. When a file is found, it will be added into this cache.
      *  This variable is used for improving the performance of file search.
      */
-    mutable std::unordered_map<std::string, std::string> _fullPathCache;
+    mutable FullPathCache _fullPathCache;
 
     /**
      * Writable path.
@@ -511,11 +511,12 @@ bool Image::initWithImageFile(const std::string& path)
     bool ret = false;
     _filePath = FileUtils::getInstance()->fullPathForFilename(path);
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    // decoded straight from the file, large images are mapped rather than copied
+    auto view = FileUtils::getInstance()->mapFile(_filePath);
 
-    if (!data.isNull())
+    if (view && !view->isNull())
     {
-        ret = initWithImageData(data.getBytes(), data.getSize());
+        ret = initWithImageData(view->getBytes(), view->getSize());
     }
 
     return ret;
@@ -526,11 +527,11 @@ bool Image::initWithImageFileThreadSafe(const std::string& fullpath)
     bool ret = false;
     _filePath = fullpath;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(fullpath);
+    auto view = FileUtils::getInstance()->mapFile(fullpath);
 
-    if (!data.isNull())
+    if (view && !view->isNull())
     {
-        ret = initWithImageData(data.getBytes(), data.getSize());
+        ret = initWithImageData(view->getBytes(), view->getSize());
     }
 
     return ret;
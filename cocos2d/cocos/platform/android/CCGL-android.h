@@ -66,6 +66,14 @@ extern PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT;
 #define glBindVertexArrayOES glBindVertexArrayOESEXT
 #define glDeleteVertexArraysOES glDeleteVertexArraysOESEXT
 
+extern PFNGLMAPBUFFERRANGEEXTPROC glMapBufferRangeEXTEXT;
+
+#define glMapBufferRange            glMapBufferRangeEXTEXT
+
+#define GL_MAP_WRITE_BIT            GL_MAP_WRITE_BIT_EXT
+#define GL_MAP_INVALIDATE_RANGE_BIT GL_MAP_INVALIDATE_RANGE_BIT_EXT
+#define GL_MAP_UNSYNCHRONIZED_BIT   GL_MAP_UNSYNCHRONIZED_BIT_EXT
+
 
 #endif // CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
 
@@ -40,17 +40,12 @@ int QuadCommand::__indexCapacity = -1;
 GLushort* QuadCommand::__indices = nullptr;
 
 QuadCommand::QuadCommand():
-_indexSize(-1),
-_ownedIndices()
+_indexSize(-1)
 {
 }
 
 QuadCommand::~QuadCommand()
 {
-    for (auto& indices : _ownedIndices)
-    {
-        CC_SAFE_DELETE_ARRAY(indices);
-    }
 }
 
 void QuadCommand::init(float globalOrder, GLuint textureID, GLProgramState* glProgramState, const BlendFunc& blendType, V3F_C4B_T2F_Quad* quads, ssize_t quadCount,
@@ -72,36 +67,28 @@ void QuadCommand::init(float globalOrder, GLuint textureID, GLProgramState* glPr
 
 void QuadCommand::reIndex(int indicesCount)
 {
-    // first time init: create a decent buffer size for indices to prevent too much resizing
-    if (__indexCapacity == -1)
-    {
-        indicesCount = std::max(indicesCount, 2048);
-    }
-
-    if (indicesCount > __indexCapacity)
-    {
-        // if resizing is needed, get needed size plus 25%, but not bigger that max size
-        indicesCount *= 1.25;
-        indicesCount = std::min(indicesCount, 65536);
-
-        CCLOG("cocos2d: QuadCommand: resizing index size from [%d] to [%d]", __indexCapacity, indicesCount);
-
-        _ownedIndices.push_back(__indices);
-        __indices = new (std::nothrow) GLushort[indicesCount];
-        __indexCapacity = indicesCount;
-    }
-
-    for( int i=0; i < __indexCapacity/6; i++)
+    // the first command to get here builds the indices for the most quads a 16 bit index can address, and
+    // every other thread waits for it, so the shared buffer never changes while another command reads it
+    static const bool initialized = []()
     {
-        __indices[i*6+0] = (GLushort) (i*4+0);
-        __indices[i*6+1] = (GLushort) (i*4+1);
-        __indices[i*6+2] = (GLushort) (i*4+2);
-        __indices[i*6+3] = (GLushort) (i*4+3);
-        __indices[i*6+4] = (GLushort) (i*4+2);
-        __indices[i*6+5] = (GLushort) (i*4+1);
-    }
-
-    _indexSize = indicesCount;
+        __indexCapacity = 65536 / 4 * 6;
+        __indices = new (std::nothrow) GLushort[__indexCapacity];
+
+        for( int i=0; i < __indexCapacity/6; i++)
+        {
+            __indices[i*6+0] = (GLushort) (i*4+0);
+            __indices[i*6+1] = (GLushort) (i*4+1);
+            __indices[i*6+2] = (GLushort) (i*4+2);
+            __indices[i*6+3] = (GLushort) (i*4+3);
+            __indices[i*6+4] = (GLushort) (i*4+2);
+            __indices[i*6+5] = (GLushort) (i*4+1);
+        }
+        return true;
+    }();
+    (void)initialized;
+
+    CCASSERT(indicesCount <= __indexCapacity, "QuadCommand: too many quads for 16 bit indices");
+    _indexSize = __indexCapacity;
 }
 
 void QuadCommand::init(float globalOrder, GLuint textureID, GLProgramState* shader, const BlendFunc& blendType, V3F_C4B_T2F_Quad* quads, ssize_t quadCount, const Mat4 &mv)
@@ -75,9 +75,9 @@ protected:
     void reIndex(int indices);
 
     int _indexSize;
-    std::vector<GLushort*> _ownedIndices;
 
-    // shared across all instances
+    // shared across all instances, built once at the largest size a command can use and never reallocated,
+    // since commands are initialized on worker threads while visiting concurrently
     static int __indexCapacity;
     static GLushort* __indices;
 };
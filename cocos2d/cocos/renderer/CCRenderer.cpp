@@ -26,6 +26,7 @@
 #include "renderer/CCRenderer.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "renderer/CCTrianglesCommand.h"
 #include "renderer/CCBatchCommand.h"
@@ -45,8 +46,11 @@
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventType.h"
+#include "base/CCJobSystem.h"
+#include "base/CCProfiling.h"
 #include "2d/CCCamera.h"
 #include "2d/CCScene.h"
+#include "2d/CCNode.h"
 
 NS_CC_BEGIN
 
@@ -61,6 +65,67 @@ static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
     return  a->getDepth() > b->getDepth();
 }
 
+// below this many commands std::stable_sort beats the fixed cost of the radix passes
+static const size_t RADIX_SORT_THRESHOLD = 64;
+
+// maps a float to an unsigned key with the same order, negative values included. -0.0 and 0.0 compare equal,
+// so -0.0 is folded into 0.0 first, otherwise it would sort before it and break the stable order. it is done on
+// the bits since fast-math builds may drop a floating point fold.
+static uint32_t floatToSortKey(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffffu) == 0)
+        bits = 0;
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// stable LSD radix sort of commands by keys, one byte per pass. passes where every key has the same byte are
+// skipped, so a queue where most commands share a globalZ is close to a single linear pass.
+static void radixSort(std::vector<RenderCommand*>& commands, std::vector<uint32_t>& keys,
+                      std::vector<RenderCommand*>& commandBuffer, std::vector<uint32_t>& keyBuffer)
+{
+    size_t count = commands.size();
+    commandBuffer.resize(count);
+    keyBuffer.resize(count);
+
+    size_t histograms[4][256] = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t key = keys[i];
+        ++histograms[0][key & 0xff];
+        ++histograms[1][(key >> 8) & 0xff];
+        ++histograms[2][(key >> 16) & 0xff];
+        ++histograms[3][key >> 24];
+    }
+
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        size_t* histogram = histograms[pass];
+        int shift = pass * 8;
+        if (histogram[(keys[0] >> shift) & 0xff] == count)
+            continue;
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit)
+        {
+            size_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t index = histogram[(keys[i] >> shift) & 0xff]++;
+            commandBuffer[index] = commands[i];
+            keyBuffer[index] = keys[i];
+        }
+
+        commands.swap(commandBuffer);
+        keys.swap(keyBuffer);
+    }
+}
+
 // queue
 RenderQueue::RenderQueue()
 {
@@ -112,9 +177,34 @@ ssize_t RenderQueue::size() const
 void RenderQueue::sort()
 {
     // Don't sort _queue0, it already comes sorted
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]), std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]), compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]), compareRenderCommand);
+    sortQueue(QUEUE_GROUP::TRANSPARENT_3D);
+    sortQueue(QUEUE_GROUP::GLOBALZ_NEG);
+    sortQueue(QUEUE_GROUP::GLOBALZ_POS);
+}
+
+void RenderQueue::sortQueue(QUEUE_GROUP group)
+{
+    auto& commands = _commands[group];
+    if (commands.size() < RADIX_SORT_THRESHOLD)
+    {
+        if (group == QUEUE_GROUP::TRANSPARENT_3D)
+            std::stable_sort(std::begin(commands), std::end(commands), compare3DCommand);
+        else
+            std::stable_sort(std::begin(commands), std::end(commands), compareRenderCommand);
+        return;
+    }
+
+    // transparent 3D commands are drawn back to front, so their keys are inverted to sort by descending depth
+    _sortKeys.resize(commands.size());
+    for (size_t i = 0, count = commands.size(); i < count; ++i)
+    {
+        if (group == QUEUE_GROUP::TRANSPARENT_3D)
+            _sortKeys[i] = ~floatToSortKey(commands[i]->getDepth());
+        else
+            _sortKeys[i] = floatToSortKey(commands[i]->getGlobalOrder());
+    }
+
+    radixSort(commands, _sortKeys, _sortBuffer, _sortKeyBuffer);
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -194,6 +284,12 @@ void RenderQueue::restoreRenderState()
 //
 static const int DEFAULT_RENDER_QUEUE = 0;
 
+// list the calling thread records commands into during Renderer::visitConcurrently()
+static thread_local Renderer::CommandList* s_commandList = nullptr;
+
+// lists visitConcurrently() splits each range of children into, per thread, so uneven subtrees balance out
+static const ssize_t CONCURRENT_VISIT_LISTS_PER_THREAD = 4;
+
 //
 // constructors, destructor, init
 //
@@ -201,11 +297,17 @@ Renderer::Renderer()
 :_lastBatchedMeshCommand(nullptr)
 ,_filledVertex(0)
 ,_filledIndex(0)
+,_streamBuffer(false)
+,_streamVertexOffset(0)
+,_streamIndexOffset(0)
 ,_glViewAssigned(false)
+,_uploadedBytes(0)
 ,_isRendering(false)
 ,_isDepthTestFor2D(false)
 ,_triBatchesToDraw(nullptr)
 ,_triBatchesToDrawCapacity(-1)
+,_batchedTransform(true)
+,_commandListsInUse(0)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
 ,_cacheTextureListener(nullptr)
 #endif
@@ -271,6 +373,8 @@ void Renderer::setupBuffer()
     {
         setupVBO();
     }
+
+    setupStreamBuffer();
 }
 
 void Renderer::setupVBOAndVAO()
@@ -327,6 +431,30 @@ void Renderer::setupVBO()
 //    mapBuffers();
 }
 
+void Renderer::setupStreamBuffer()
+{
+    _streamBuffer = Configuration::getInstance()->supportsMapBufferRange();
+    _streamVertexOffset = 0;
+    _streamIndexOffset = 0;
+
+    if (!_streamBuffer)
+        return;
+
+    // The ring buffer is allocated once at full size and only respecified to orphan it when it wraps. It is
+    // written through unsynchronized mappings rather than glBufferSubData, see issue #15652 above.
+    GL::bindVAO(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERROR_DEBUG();
+}
+
 void Renderer::mapBuffers()
 {
     // Avoid changing the element buffer for whatever VAO might be bound.
@@ -348,6 +476,12 @@ void Renderer::mapBuffers()
 
 void Renderer::addCommand(RenderCommand* command)
 {
+    if (s_commandList)
+    {
+        s_commandList->entries.push_back({CommandList::Type::ADD_COMMAND, command, -1, nullptr, 0});
+        return;
+    }
+
     int renderQueueID =_commandGroupStack.top();
     addCommand(command, renderQueueID);
 }
@@ -358,18 +492,34 @@ void Renderer::addCommand(RenderCommand* command, int renderQueueID)
     CCASSERT(renderQueueID >=0, "Invalid render queue");
     CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
 
+    if (s_commandList)
+    {
+        s_commandList->entries.push_back({CommandList::Type::ADD_COMMAND, command, renderQueueID, nullptr, 0});
+        return;
+    }
+
     _renderGroups[renderQueueID].push_back(command);
 }
 
 void Renderer::pushGroup(int renderQueueID)
 {
     CCASSERT(!_isRendering, "Cannot change render queue while rendering");
+    if (s_commandList)
+    {
+        s_commandList->entries.push_back({CommandList::Type::PUSH_GROUP, nullptr, renderQueueID, nullptr, 0});
+        return;
+    }
     _commandGroupStack.push(renderQueueID);
 }
 
 void Renderer::popGroup()
 {
     CCASSERT(!_isRendering, "Cannot change render queue while rendering");
+    if (s_commandList)
+    {
+        s_commandList->entries.push_back({CommandList::Type::POP_GROUP, nullptr, -1, nullptr, 0});
+        return;
+    }
     _commandGroupStack.pop();
 }
 
@@ -380,6 +530,101 @@ int Renderer::createRenderQueue()
     return (int)_renderGroups.size() - 1;
 }
 
+void Renderer::visitConcurrently(const Vector<Node*>& nodes, ssize_t begin, ssize_t end, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (begin >= end)
+        return;
+
+    CCASSERT(!isRecording(), "Cannot visit concurrently from a concurrent visit");
+    CC_PROFILER_TRACE("Renderer::visitConcurrently");
+
+    auto jobSystem = JobSystem::getInstance();
+    const ssize_t count = end - begin;
+    const ssize_t lists = std::min(count, (ssize_t)jobSystem->getThreadCount() * CONCURRENT_VISIT_LISTS_PER_THREAD);
+
+    const size_t first = _commandListsInUse;
+    while (_commandLists.size() < first + lists)
+        _commandLists.emplace_back();
+    _commandListsInUse += lists;
+
+    // Each list holds a contiguous run of children, so replaying the lists in order keeps the serial order.
+    auto director = Director::getInstance();
+    const Mat4 modelView = director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    jobSystem->parallelFor(lists, [&](size_t list) {
+        auto& commandList = _commandLists[first + list];
+        commandList.entries.clear();
+        commandList.transforms.clear();
+
+        std::stack<Mat4> matrixStack;
+        matrixStack.push(modelView);
+        director->setModelViewMatrixStackForThread(&matrixStack);
+        s_commandList = &commandList;
+
+        for (ssize_t i = begin + count * list / lists, last = begin + count * (list + 1) / lists; i < last; ++i)
+        {
+            auto node = nodes.at(i);
+            if (node)
+                node->visit(this, parentTransform, parentFlags);
+        }
+
+        s_commandList = nullptr;
+        director->setModelViewMatrixStackForThread(nullptr);
+    });
+
+    for (ssize_t list = 0; list < lists; ++list)
+        replay(_commandLists[first + list]);
+
+    _commandListsInUse = first;
+}
+
+bool Renderer::isRecording() const
+{
+    return s_commandList != nullptr;
+}
+
+bool Renderer::deferVisit(Node* node, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (!s_commandList)
+        return false;
+
+    s_commandList->entries.push_back({CommandList::Type::VISIT, nullptr, -1, node, parentFlags});
+    s_commandList->transforms.push_back(parentTransform);
+    return true;
+}
+
+void Renderer::replay(const CommandList& list)
+{
+    auto director = Director::getInstance();
+    auto transform = list.transforms.begin();
+
+    for (const auto& entry : list.entries)
+    {
+        switch (entry.type)
+        {
+            case CommandList::Type::ADD_COMMAND:
+                if (entry.renderQueueID < 0)
+                    addCommand(entry.command);
+                else
+                    addCommand(entry.command, entry.renderQueueID);
+                break;
+            case CommandList::Type::PUSH_GROUP:
+                pushGroup(entry.renderQueueID);
+                break;
+            case CommandList::Type::POP_GROUP:
+                popGroup();
+                break;
+            case CommandList::Type::VISIT:
+                // the parent had its own transform loaded when the node was reached
+                director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+                director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, *transform);
+                entry.node->visit(this, *transform, entry.parentFlags);
+                director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+                ++transform;
+                break;
+        }
+    }
+}
+
 void Renderer::processRenderCommand(RenderCommand* command)
 {
     auto commandType = command->getType();
@@ -631,6 +876,8 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
 
 void Renderer::render()
 {
+    CC_PROFILER_TRACE("Renderer::render");
+
     //Uncomment this once everything is rendered by new renderer
     //glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -710,24 +957,55 @@ void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd)
 {
     memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * cmd->getVertexCount());
 
-    // fill vertex, and convert them to world coordinates
+    // fill vertex, and convert them to world coordinates, in one batch so the SIMD kernels can run over the whole command
     const Mat4& modelView = cmd->getModelView();
-    for(ssize_t i=0; i < cmd->getVertexCount(); ++i)
+    if (_batchedTransform)
     {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
+        modelView.transformPoints(&_verts[_filledVertex].vertices, cmd->getVertexCount(), sizeof(_verts[0]));
+    }
+    else
+    {
+        for(ssize_t i=0; i < cmd->getVertexCount(); ++i)
+        {
+            modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
+        }
     }
 
     // fill index
     const unsigned short* indices = cmd->getIndices();
     for(ssize_t i=0; i< cmd->getIndexCount(); ++i)
     {
-        _indices[_filledIndex + i] = _filledVertex + indices[i];
+        _indices[_filledIndex + i] = _streamVertexOffset + _filledVertex + indices[i];
     }
 
     _filledVertex += cmd->getVertexCount();
     _filledIndex += cmd->getIndexCount();
 }
 
+void Renderer::streamToBuffer(GLenum target, const void* data, GLintptr offset, GLsizeiptr size, GLsizeiptr capacity, bool orphan)
+{
+#if CC_RENDERER_STREAM_BUFFER
+    // Orphaning gives the buffer new storage, so draws still in flight keep reading the old one. Everything
+    // written since the last orphan lies behind `offset`, so mapping the rest unsynchronized is safe.
+    if (orphan)
+        glBufferData(target, capacity, nullptr, GL_DYNAMIC_DRAW);
+
+    if (size == 0)
+        return;
+
+    void* buf = glMapBufferRange(target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (buf)
+    {
+        memcpy(buf, data, size);
+        glUnmapBuffer(target);
+    }
+    else
+    {
+        glBufferSubData(target, offset, size, data);
+    }
+#endif
+}
+
 void Renderer::drawBatchedTriangles()
 {
     if(_queuedTriangleCommands.empty())
@@ -735,12 +1013,22 @@ void Renderer::drawBatchedTriangles()
 
     CCGL_DEBUG_INSERT_EVENT_MARKER("RENDERER_BATCH_TRIANGLES");
 
+    // processRenderCommand() counted what is queued, so room can be claimed in the ring buffer before filling.
+    // Indices are written against where the vertices will be in it, so the attribute pointers never change.
+    bool orphan = false;
+    if (_streamBuffer && (_streamVertexOffset + _filledVertex > VBO_SIZE || _streamIndexOffset + _filledIndex > INDEX_VBO_SIZE))
+    {
+        orphan = true;
+        _streamVertexOffset = 0;
+        _streamIndexOffset = 0;
+    }
+
     _filledVertex = 0;
     _filledIndex = 0;
 
     /************** 1: Setup up vertices/indices *************/
 
-    _triBatchesToDraw[0].offset = 0;
+    _triBatchesToDraw[0].offset = _streamIndexOffset;
     _triBatchesToDraw[0].indicesToDraw = 0;
     _triBatchesToDraw[0].cmd = nullptr;
 
@@ -791,7 +1079,34 @@ void Renderer::drawBatchedTriangles()
 
     /************** 2: Copy vertices/indices to GL objects *************/
     auto conf = Configuration::getInstance();
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    if (_streamBuffer)
+    {
+        if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+        {
+            GL::bindVAO(_buffersVAO);
+            glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+
+            GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
+            glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(_verts[0]), (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
+            glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(_verts[0]), (GLvoid*) offsetof(V3F_C4B_T2F, colors));
+            glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(_verts[0]), (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
+
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+        }
+
+        streamToBuffer(GL_ARRAY_BUFFER, _verts, sizeof(_verts[0]) * _streamVertexOffset, sizeof(_verts[0]) * _filledVertex, sizeof(_verts[0]) * VBO_SIZE, orphan);
+        streamToBuffer(GL_ELEMENT_ARRAY_BUFFER, _indices, sizeof(_indices[0]) * _streamIndexOffset, sizeof(_indices[0]) * _filledIndex, sizeof(_indices[0]) * INDEX_VBO_SIZE, orphan);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        _streamVertexOffset += _filledVertex;
+        _streamIndexOffset += _filledIndex;
+    }
+    else if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
     {
         //Bind VAO
         GL::bindVAO(_buffersVAO);
@@ -841,6 +1156,8 @@ void Renderer::drawBatchedTriangles()
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
     }
 
+    _uploadedBytes += sizeof(_verts[0]) * _filledVertex + sizeof(_indices[0]) * _filledIndex;
+
     /************** 3: Draw *************/
     for (int i=0; i<batchesTotal; ++i)
     {
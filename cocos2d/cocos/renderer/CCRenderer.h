@@ -29,11 +29,13 @@
 
 #include <vector>
 #include <stack>
+#include <deque>
 
 #include "platform/CCPlatformMacros.h"
 #include "renderer/CCRenderCommand.h"
 #include "renderer/CCGLProgram.h"
 #include "platform/CCGL.h"
+#include "base/CCVector.h"
 
 #if !defined(NDEBUG) && CC_TARGET_PLATFORM == CC_PLATFORM_IOS
 
@@ -60,6 +62,7 @@
 NS_CC_BEGIN
 
 class EventListenerCustom;
+class Node;
 class TrianglesCommand;
 class MeshCommand;
 
@@ -114,8 +117,16 @@ public:
     void restoreRenderState();
     
 protected:
+    /**Stable sort of a single queue group by globalZ, or by descending depth for TRANSPARENT_3D.*/
+    void sortQueue(QUEUE_GROUP group);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
+
+    /**Scratch storage for sortQueue(). Kept between frames so sorting doesn't allocate once it has grown.*/
+    std::vector<RenderCommand*> _sortBuffer;
+    std::vector<uint32_t> _sortKeys;
+    std::vector<uint32_t> _sortKeyBuffer;
     
     /**Cull state.*/
     bool _isCullEnabled;
@@ -172,6 +183,32 @@ public:
     /** Creates a render queue and returns its Id */
     int createRenderQueue();
 
+    /**
+     * Visits `nodes[begin, end)` concurrently on the JobSystem. Commands added while visiting are recorded per
+     * thread and merged back in the order a serial visit would have added them, so the result is the same.
+     * Nodes that can't be visited on a worker thread call `deferVisit()` and are visited on this thread when
+     * their commands are merged.
+     *
+     * @param nodes Children to visit.
+     * @param begin Index of the first child to visit.
+     * @param end Index after the last child to visit.
+     * @param parentTransform Transform the children are visited with.
+     * @param parentFlags Flags the children are visited with.
+     */
+    void visitConcurrently(const Vector<Node*>& nodes, ssize_t begin, ssize_t end, const Mat4& parentTransform, uint32_t parentFlags);
+
+    /** Whether commands added on the calling thread are being recorded by `visitConcurrently()` */
+    bool isRecording() const;
+
+    /**
+     * Defers the visit of a node to the thread that called `visitConcurrently()`, keeping its place in the
+     * command order. Called at the top of `visit()` by nodes that create objects, touch GL or rely on the
+     * Director matrix stack while visiting.
+     *
+     * @return Whether the visit was deferred, in which case the caller must return without visiting.
+     */
+    bool deferVisit(Node* node, const Mat4& parentTransform, uint32_t parentFlags);
+
     /** Renders into the GLView all the queued `RenderCommand` objects */
     void render();
 
@@ -191,8 +228,10 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of vertex and index bytes uploaded for batched triangles in the last frame */
+    ssize_t getUploadedBytes() const { return _uploadedBytes; }
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats() { _drawnBatches = _drawnVertices = _uploadedBytes = 0; }
 
     /**
      * Enable/Disable depth test
@@ -200,6 +239,15 @@ public:
      * For 2D object depth test is disabled by default
      */
     void setDepthTest(bool enable);
+
+    /**
+     * Enable/Disable transforming the vertices of each TrianglesCommand in one batch, which lets the SIMD
+     * kernels of Mat4::transformPoints run over the whole command. Enabled by default; disabling it transforms
+     * one vertex at a time, which is only useful to measure the difference.
+     */
+    void setBatchedTransform(bool enable) { _batchedTransform = enable; }
+    /** Whether the vertices of each TrianglesCommand are transformed in one batch */
+    bool isBatchedTransform() const { return _batchedTransform; }
     
     //This will not be used outside.
     GroupCommandManager* getGroupCommandManager() const { return _groupCommandManager; }
@@ -214,6 +262,8 @@ protected:
     void setupVBOAndVAO();
     void setupVBO();
     void mapBuffers();
+    void setupStreamBuffer();
+    void streamToBuffer(GLenum target, const void* data, GLintptr offset, GLsizeiptr size, GLsizeiptr capacity, bool orphan);
     void drawBatchedTriangles();
 
     //Draw the previews queued triangles and flush previous context
@@ -230,6 +280,35 @@ protected:
 
     void fillVerticesAndIndices(const TrianglesCommand* cmd);
 
+public:
+    // Commands recorded by one thread during visitConcurrently(). This will not be used outside.
+    struct CommandList
+    {
+        enum class Type
+        {
+            ADD_COMMAND,
+            PUSH_GROUP,
+            POP_GROUP,
+            VISIT,
+        };
+        struct Entry
+        {
+            Type type;
+            // ADD_COMMAND
+            RenderCommand* command;
+            // ADD_COMMAND, -1 for the current group, and PUSH_GROUP
+            int renderQueueID;
+            // VISIT, with its transform at the same position in `transforms`
+            Node* node;
+            uint32_t parentFlags;
+        };
+        std::vector<Entry> entries;
+        std::vector<Mat4> transforms;
+    };
+
+protected:
+    void replay(const CommandList& list);
+
 
     /* clear color set outside be used in setGLDefaultValues() */
     Color4F _clearColor;
@@ -261,17 +340,32 @@ protected:
     int _filledVertex;
     int _filledIndex;
 
+    // Whether batched triangles are streamed through the ring buffer, see CC_RENDERER_STREAM_BUFFER
+    bool _streamBuffer;
+    // first free vertex/index in the ring buffer
+    int _streamVertexOffset;
+    int _streamIndexOffset;
+
     bool _glViewAssigned;
 
     // stats
     ssize_t _drawnBatches;
     ssize_t _drawnVertices;
+    ssize_t _uploadedBytes;
     //the flag for checking whether renderer is rendering
     bool _isRendering;
     
     bool _isDepthTestFor2D;
+
+    // Whether fillVerticesAndIndices() transforms each command in one batch, see setBatchedTransform()
+    bool _batchedTransform;
     
     GroupCommandManager* _groupCommandManager;
+
+    // Lists recorded by visitConcurrently(), kept between frames to reuse their memory. A deque since a deferred
+    // visit may start a nested visitConcurrently() while the lists of the outer one are being replayed.
+    std::deque<CommandList> _commandLists;
+    size_t _commandListsInUse;
     
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _cacheTextureListener;
@@ -32,6 +32,8 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <atomic>
+#include <algorithm>
 
 #include "renderer/CCTexture2D.h"
 #include "base/ccMacros.h"
@@ -41,6 +43,8 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 #include "base/ccUtils.h"
 #include "base/CCNinePatchImageParser.h"
+#include "base/CCProfiling.h"
+#include "base/CCConfiguration.h"
 
 
 
@@ -50,6 +54,9 @@ NS_CC_BEGIN
 
 std::string TextureCache::s_etc1AlphaFileSuffix = "@alpha";
 
+// bytes of an uncompressed image uploaded at a time, small enough that a band never blows the frame budget
+static const int UPLOAD_BAND_SIZE = 256 * 1024;
+
 // implementation TextureCache
 
 void TextureCache::setETC1AlphaFileSuffix(const std::string& suffix)
@@ -68,8 +75,7 @@ TextureCache * TextureCache::getInstance()
 }
 
 TextureCache::TextureCache()
-: _loadingThread(nullptr)
-, _needQuit(false)
+: _needQuit(false)
 , _asyncRefCount(0)
 {
 }
@@ -81,7 +87,8 @@ TextureCache::~TextureCache()
     for (auto& texture : _textures)
         texture.second->release();
 
-    CC_SAFE_DELETE(_loadingThread);
+    for (auto& thread : _loadingThreads)
+        CC_SAFE_DELETE(thread);
 }
 
 void TextureCache::destroyInstance()
@@ -107,12 +114,21 @@ struct TextureCache::AsyncStruct
 public:
     AsyncStruct
     ( const std::string& fn,const std::function<void(Texture2D*)>& f,
-      const std::string& key )
+      const std::string& key, int p )
       : filename(fn), callback(f),callbackKey( key ),
         pixelFormat(Texture2D::getDefaultAlphaPixelFormat()),
-        loadSuccess(false)
+        loadSuccess(false), priority(p), done(false), source(nullptr),
+        data(nullptr), dataLen(0), dataFormat(Texture2D::PixelFormat::NONE),
+        texture(nullptr), uploadedRows(0)
     {}
 
+    ~AsyncStruct()
+    {
+        if (data != nullptr && data != image.getData())
+            free(data);
+        CC_SAFE_RELEASE(texture);
+    }
+
     std::string filename;
     std::function<void(Texture2D*)> callback;
     std::string callbackKey;
@@ -120,17 +136,29 @@ public:
     Image imageAlpha;
     Texture2D::PixelFormat pixelFormat;
     bool loadSuccess;
+    int priority;
+    // set by the load thread once image is filled in
+    std::atomic<bool> done;
+    // earlier request for the same file that decodes the image for this one, nullptr if it decodes it itself
+    AsyncStruct* source;
+    // image converted to dataFormat by the load thread, nullptr if the image can't be uploaded in bands
+    unsigned char* data;
+    ssize_t dataLen;
+    Texture2D::PixelFormat dataFormat;
+    // texture being uploaded, and how many rows of data it holds so far
+    Texture2D* texture;
+    int uploadedRows;
 };
 
 /**
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
+ - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then mark AsyncStruct as done (Load threads)
+ - on schedule callback, pop done AsyncStructs from the front of _asyncStructQueue, convert image to texture, then delete AsyncStruct (GL thread)
 
  the Critical Area include these members:
  - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
+ - AsyncStruct::done: atomic, publishes the image data to the GL thread
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
@@ -138,12 +166,14 @@ public:
 
  Note:
  - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - images are decoded on several load threads and may finish in any order, but callbacks are invoked in
+ the order of _asyncStructQueue: by priority, then by request order.
 
  How to deal add image many times?
  - At first, this situation is abnormal, we only ensure the logic is correct.
  - If the image has been loaded, the after load image call will return immediately.
- - If the image request is in queue already, there will be more than one request in queue,
- - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
+ - If the image request is in queue already with the same or a higher priority, the new request doesn't
+ decode the image again. It is queued behind the first one and picks up the texture it creates.
 
  Does process all response in addImageAsyncCallback consume more time?
  - Convert image to texture faster than load image from disk, so this isn't a
@@ -160,12 +190,12 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
 /**
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
+ - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then mark AsyncStruct as done (Load threads)
+ - on schedule callback, pop done AsyncStructs from the front of _asyncStructQueue, convert image to texture, then delete AsyncStruct (GL thread)
  
  the Critical Area include these members:
  - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
+ - AsyncStruct::done: atomic, publishes the image data to the GL thread
  
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
@@ -173,12 +203,14 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
  
  Note:
  - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - images are decoded on several load threads and may finish in any order, but callbacks are invoked in
+ the order of _asyncStructQueue: by priority, then by request order.
  
  How to deal add image many times?
  - At first, this situation is abnormal, we only ensure the logic is correct.
  - If the image has been loaded, the after load image call will return immediately.
- - If the image request is in queue already, there will be more than one request in queue,
- - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
+ - If the image request is in queue already with the same or a higher priority, the new request doesn't
+ decode the image again. It is queued behind the first one and picks up the texture it creates.
  
  Does process all response in addImageAsyncCallback consume more time?
  - Convert image to texture faster than load image from disk, so this isn't a
@@ -190,6 +222,11 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
  unbindImageAsync(path) would be ambiguous.
  */
 void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey)
+{
+    addImageAsync( path, callback, callbackKey, 0 );
+}
+
+void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey, int priority)
 {
     Texture2D *texture = nullptr;
 
@@ -211,12 +248,16 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
         return;
     }
 
-    // lazy init
-    if (_loadingThread == nullptr)
+    // lazy init, leaving a core for the GL thread
+    if (_loadingThreads.empty())
     {
-        // create a new thread to load images
+        unsigned int cores = std::thread::hardware_concurrency();
+        unsigned int count = std::min(cores > 1 ? cores - 1 : 1u, (unsigned int)CC_TEXTURE_CACHE_LOADING_THREADS);
+
+        // create new threads to load images
         _needQuit = false;
-        _loadingThread = new (std::nothrow) std::thread(&TextureCache::loadImage, this);
+        for (unsigned int i = 0; i < std::max(count, 1u); ++i)
+            _loadingThreads.push_back(new (std::nothrow) std::thread(&TextureCache::loadImage, this));
     }
 
     if (0 == _asyncRefCount)
@@ -228,12 +269,27 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
 
     // generate async struct
     AsyncStruct *data =
-      new (std::nothrow) AsyncStruct(fullpath, callback, callbackKey);
-    
-    // add async struct into queue
-    _asyncStructQueue.push_back(data);
+      new (std::nothrow) AsyncStruct(fullpath, callback, callbackKey, priority);
+
+    // a request for the same file that is delivered first already decodes the image
+    for (auto& queued : _asyncStructQueue)
+    {
+        if (queued->source == nullptr && queued->filename == fullpath && queued->priority >= priority)
+        {
+            data->source = queued;
+            data->done = true;
+            break;
+        }
+    }
+
+    // add async struct into queue, behind every request with the same or a higher priority
+    auto lowerPriority = [priority](AsyncStruct* queued) { return queued->priority < priority; };
+    _asyncStructQueue.insert(std::find_if(_asyncStructQueue.begin(), _asyncStructQueue.end(), lowerPriority), data);
+    if (data->source != nullptr)
+        return;
+
     std::unique_lock<std::mutex> ul(_requestMutex);
-    _requestQueue.push_back(data);
+    _requestQueue.insert(std::find_if(_requestQueue.begin(), _requestQueue.end(), lowerPriority), data);
     _sleepCondition.notify_one();
 }
 
@@ -266,9 +322,51 @@ void TextureCache::unbindAllImageAsync()
     }
 }
 
+void TextureCache::cancelImageAsync(const std::string& callbackKey)
+{
+    std::unique_lock<std::mutex> ul(_requestMutex);
+    for (auto it = _asyncStructQueue.begin(); it != _asyncStructQueue.end();)
+    {
+        AsyncStruct* asyncStruct = *it;
+        if (asyncStruct->callbackKey != callbackKey)
+        {
+            ++it;
+            continue;
+        }
+
+        asyncStruct->callback = nullptr;
+
+        // a request can only be dropped if no load thread has picked it up and no other request waits on it
+        auto request = std::find(_requestQueue.begin(), _requestQueue.end(), asyncStruct);
+        bool waitedOn = std::any_of(_asyncStructQueue.begin(), _asyncStructQueue.end(),
+                                    [asyncStruct](AsyncStruct* queued) { return queued->source == asyncStruct; });
+        if (asyncStruct->source == nullptr && (request == _requestQueue.end() || waitedOn))
+        {
+            ++it;
+            continue;
+        }
+
+        if (request != _requestQueue.end())
+            _requestQueue.erase(request);
+        it = _asyncStructQueue.erase(it);
+        delete asyncStruct;
+        --_asyncRefCount;
+    }
+    ul.unlock();
+
+    if (0 == _asyncRefCount)
+    {
+        Director::getInstance()->getScheduler()->unschedule(CC_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack), this);
+    }
+}
+
 void TextureCache::loadImage()
 {
     AsyncStruct *asyncStruct = nullptr;
+#if CC_ENABLE_TRACE_PROFILER
+    TraceProfiler::getInstance()->setCurrentThreadName("TextureCache");
+#endif
+
     while (!_needQuit)
     {
         std::unique_lock<std::mutex> ul(_requestMutex);
@@ -292,6 +390,8 @@ void TextureCache::loadImage()
         }
         ul.unlock();
 
+        CC_PROFILER_TRACE("TextureCache::loadImage");
+
         // load image
         asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
 
@@ -302,37 +402,37 @@ void TextureCache::loadImage()
             if (FileUtils::getInstance()->isFileExist(alphaFile))
                 asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
         }
-        // push the asyncStruct to response queue
-        _responseMutex.lock();
-        _responseQueue.push_back(asyncStruct);
-        _responseMutex.unlock();
+
+        // convert uncompressed images here, so the GL thread only has to upload them
+        Image* image = &asyncStruct->image;
+        if (asyncStruct->loadSuccess && !image->isCompressed() && image->getNumberOfMipmaps() <= 1)
+        {
+            auto format = asyncStruct->pixelFormat;
+            if (format == Texture2D::PixelFormat::NONE || format == Texture2D::PixelFormat::AUTO)
+                format = image->getRenderFormat();
+
+            asyncStruct->dataFormat = Texture2D::convertDataToFormat(image->getData(), image->getDataLen(), image->getRenderFormat(),
+                                                                     format, &asyncStruct->data, &asyncStruct->dataLen);
+        }
+        // hand the image over to the GL thread
+        asyncStruct->done.store(true, std::memory_order_release);
     }
 }
 
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    CC_PROFILER_TRACE("TextureCache::addImageAsyncCallBack");
+
+    // whatever doesn't fit in this frame's budget is uploaded next frame
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(CC_TEXTURE_CACHE_UPLOAD_BUDGET);
+
     Texture2D *texture = nullptr;
     AsyncStruct *asyncStruct = nullptr;
-    while (true)
+    while (!_asyncStructQueue.empty())
     {
-        // pop an AsyncStruct from response queue
-        _responseMutex.lock();
-        if (_responseQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
-        {
-            asyncStruct = _responseQueue.front();
-            _responseQueue.pop_front();
-
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            CC_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
-        }
-        _responseMutex.unlock();
-
-        if (nullptr == asyncStruct) {
+        // images finish decoding in any order, so wait on the front one to keep callbacks in queue order
+        asyncStruct = _asyncStructQueue.front();
+        if (!asyncStruct->done.load(std::memory_order_acquire)) {
             break;
         }
 
@@ -347,11 +447,15 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             // convert image to texture
             if (asyncStruct->loadSuccess)
             {
+                // generate texture in render thread, over several frames for large images
+                if (!uploadImage(asyncStruct, deadline)) {
+                    break;
+                }
+
                 Image* image = &(asyncStruct->image);
-                // generate texture in render thread
-                texture = new (std::nothrow) Texture2D();
+                texture = asyncStruct->texture;
+                asyncStruct->texture = nullptr;
 
-                texture->initWithImage(image, asyncStruct->pixelFormat);
                 //parse 9-patch info
                 this->parseNinePatchImage(image, texture, asyncStruct->filename);
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -377,6 +481,7 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
                 CCLOG("cocos2d: failed to call TextureCache::addImageAsync(%s)", asyncStruct->filename.c_str());
             }
         }
+        _asyncStructQueue.pop_front();
 
         // call callback function
         if (asyncStruct->callback)
@@ -387,6 +492,10 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         // release the asyncStruct
         delete asyncStruct;
         --_asyncRefCount;
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
     }
 
     if (0 == _asyncRefCount)
@@ -395,6 +504,48 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
     }
 }
 
+bool TextureCache::uploadImage(AsyncStruct* asyncStruct, const std::chrono::steady_clock::time_point& deadline)
+{
+    Image* image = &(asyncStruct->image);
+    int width = image->getWidth();
+    int height = image->getHeight();
+
+    // compressed and mipmapped images can't be uploaded in parts
+    if (asyncStruct->data == nullptr || width > Configuration::getInstance()->getMaxTextureSize()
+        || height > Configuration::getInstance()->getMaxTextureSize())
+    {
+        asyncStruct->texture = new (std::nothrow) Texture2D();
+        asyncStruct->texture->initWithImage(image, asyncStruct->pixelFormat);
+        return true;
+    }
+
+    // allocate the texture without any data, the rows follow over the next frames
+    if (asyncStruct->texture == nullptr)
+    {
+        asyncStruct->texture = new (std::nothrow) Texture2D();
+        if (!asyncStruct->texture->initWithData(nullptr, asyncStruct->dataLen, asyncStruct->dataFormat, width, height, Size((float)width, (float)height)))
+            return true;
+
+        asyncStruct->texture->_hasPremultipliedAlpha = image->hasPremultipliedAlpha();
+        asyncStruct->texture->_filePath = image->getFilePath();
+    }
+
+    const auto& info = Texture2D::getPixelFormatInfoMap().at(asyncStruct->dataFormat);
+    int bytesPerRow = width * info.bpp / 8;
+    int rowsPerBand = std::max(1, UPLOAD_BAND_SIZE / bytesPerRow);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, bytesPerRow % 4 == 0 ? 4 : 1);
+
+    do
+    {
+        int rows = std::min(rowsPerBand, height - asyncStruct->uploadedRows);
+        asyncStruct->texture->updateWithData(asyncStruct->data + asyncStruct->uploadedRows * bytesPerRow,
+                                             0, asyncStruct->uploadedRows, width, rows);
+        asyncStruct->uploadedRows += rows;
+    } while (asyncStruct->uploadedRows < height && std::chrono::steady_clock::now() < deadline);
+
+    return asyncStruct->uploadedRows == height;
+}
+
 Texture2D * TextureCache::addImage(const std::string &path)
 {
     Texture2D * texture = nullptr;
@@ -662,9 +813,10 @@ void TextureCache::waitForQuit()
     // notify sub thread to quick
     std::unique_lock<std::mutex> ul(_requestMutex);
     _needQuit = true;
-    _sleepCondition.notify_one();
+    _sleepCondition.notify_all();
     ul.unlock();
-    if (_loadingThread) _loadingThread->join();
+    for (auto& thread : _loadingThreads)
+        if (thread) thread->join();
 }
 
 std::string TextureCache::getCachedTextureInfo() const
@@ -31,6 +31,8 @@ THE SOFTWARE.
 
 #include <mutex>
 #include <thread>
+#include <vector>
+#include <chrono>
 #include <condition_variable>
 #include <queue>
 #include <string>
@@ -127,6 +129,15 @@ public:
     
     void addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey );
 
+    /** Loads an image like addImageAsync, but decodes it before any queued image with a lower priority.
+     * Callbacks are invoked in priority order, and in request order for images with the same priority.
+     * @param path It's the related/absolute path of the file image.
+     * @param callback A callback function would be invoked after the image is loaded.
+     * @param callbackKey Key used to unbind or cancel the callback.
+     * @param priority Images with a higher priority are decoded first. addImageAsync uses 0.
+     */
+    void addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, const std::string& callbackKey, int priority);
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is invoked,
      * the object always need to unbind this callback manually.
@@ -140,6 +151,13 @@ public:
      */
     virtual void unbindAllImageAsync();
 
+    /** Cancels the asynchronous loads bound to a callback key.
+     * Loads that haven't started decoding are dropped without their callback being invoked. Loads that are
+     * already decoding finish and are cached, but their callback is unbound.
+     * @param callbackKey The key passed to addImageAsync, the path of the image by default.
+     */
+    virtual void cancelImageAsync(const std::string &callbackKey);
+
     /** Returns a Texture2D object given an Image.
     * If the image was not previously loaded, it will create a new Texture2D object and it will return it.
     * Otherwise it will return a reference of a previously loaded image.
@@ -227,15 +245,20 @@ private:
 public:
 protected:
     struct AsyncStruct;
+
+    /** Uploads the image of an async load to its texture, in bands of rows for uncompressed images.
+     * @param asyncStruct The async load to upload.
+     * @param deadline No band is started past this time, though the first is always uploaded.
+     * @return True once the texture is complete.
+     */
+    bool uploadImage(AsyncStruct* asyncStruct, const std::chrono::steady_clock::time_point& deadline);
     
-    std::thread* _loadingThread;
+    std::vector<std::thread*> _loadingThreads;
 
     std::deque<AsyncStruct*> _asyncStructQueue;
     std::deque<AsyncStruct*> _requestQueue;
-    std::deque<AsyncStruct*> _responseQueue;
 
     std::mutex _requestMutex;
-    std::mutex _responseMutex;
     
     std::condition_variable _sleepCondition;
 
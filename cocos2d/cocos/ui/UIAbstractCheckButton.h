@@ -219,6 +219,12 @@ protected:
     
     virtual void copySpecialProperties(Widget* model) override;
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override
+    {
+        return _backGroundBoxRendererAdaptDirty || _backGroundSelectedBoxRendererAdaptDirty ||
+               _frontCrossRendererAdaptDirty || _backGroundBoxDisabledRendererAdaptDirty ||
+               _frontCrossDisabledRendererAdaptDirty;
+    }
 protected:
     Sprite* _backGroundBoxRenderer;
     Sprite* _backGroundSelectedBoxRenderer;
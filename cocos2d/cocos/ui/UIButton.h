@@ -341,6 +341,10 @@ protected:
     void disabledTextureScaleChangedWithSize();
 
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override
+    {
+        return _normalTextureAdaptDirty || _pressedTextureAdaptDirty || _disabledTextureAdaptDirty;
+    }
     void updateTitleLocation();
     void updateContentSize();
     void createTitleRenderer();
@@ -550,6 +550,7 @@ namespace ui {
             
     protected:
         virtual void adaptRenderers() override;
+        virtual bool isAdaptRenderersDirty() const override { return _contentSizeDirty; }
 
         void updatePosition(float dt);
         EditBoxImpl*      _editBoxImpl;
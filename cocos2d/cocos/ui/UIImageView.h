@@ -157,6 +157,7 @@ protected:
     virtual void onSizeChanged() override;
     
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _imageRendererAdaptDirty; }
     void loadTexture(SpriteFrame* spriteframe);
     void setupTexture();
     
@@ -223,6 +223,10 @@ void Layout::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t par
     {
         return;
     }
+
+    // layout managers are autoreleased and clipping sets up GL state, see Renderer::visitConcurrently()
+    if ((_doLayoutDirty || _clippingEnabled) && renderer->deferVisit(this, parentTransform, parentFlags))
+        return;
     
     adaptRenderers();
     doLayout();
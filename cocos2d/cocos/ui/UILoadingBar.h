@@ -190,6 +190,7 @@ protected:
     void loadTexture(SpriteFrame* spriteframe);
     
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _barRendererAdaptDirty; }
     
     virtual Widget* createCloneInstance() override;
     virtual void copySpecialProperties(Widget* model) override;
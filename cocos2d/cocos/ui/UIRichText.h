@@ -557,6 +557,7 @@ CC_CONSTRUCTOR_ACCESS:
 
 protected:
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _formatTextDirty; }
 
     virtual void initRenderer() override;
     void pushToContainer(Node* renderer);
@@ -483,6 +483,11 @@ bool Slider::hitTest(const cocos2d::Vec2 &pt, const Camera *camera, Vec3* /*p*/)
     return isScreenPointInRect(pt, camera, w2l, rect, nullptr) || isScreenPointInRect(pt, camera, barW2l, sliderBarRect, nullptr);
 }
 
+bool Slider::isHitTestInContentRect() const
+{
+    return false;
+}
+
 bool Slider::onTouchBegan(Touch *touch, Event *unusedEvent)
 {
     bool pass = Widget::onTouchBegan(touch, unusedEvent);
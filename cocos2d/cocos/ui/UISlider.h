@@ -250,6 +250,8 @@ public:
     
     //override the widget's hitTest function to perform its own
     virtual bool hitTest(const Vec2 &pt, const Camera* camera, Vec3 *p) const override;
+    //the ball can stick out of the content rect
+    virtual bool isHitTestInContentRect() const override;
     /**
      * Returns the "class name" of widget.
      */
@@ -302,6 +304,7 @@ protected:
     virtual Widget* createCloneInstance() override;
     virtual void copySpecialProperties(Widget* model) override;
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _barRendererAdaptDirty || _progressBarRendererDirty; }
 protected:
     Scale9Sprite*  _barRenderer;
     Scale9Sprite* _progressBarRenderer;
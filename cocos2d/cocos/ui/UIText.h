@@ -366,6 +366,7 @@ protected:
     virtual Widget* createCloneInstance() override;
     virtual void copySpecialProperties(Widget* model) override;
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _labelRendererAdaptDirty; }
 protected:
     bool _touchScaleChangeEnabled;
     float _normalScaleValueX;
@@ -140,6 +140,7 @@ public:
      * @js NA
      */
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _labelAtlasRendererAdaptDirty; }
 
     ResourceData getRenderFile();
 
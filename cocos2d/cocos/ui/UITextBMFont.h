@@ -111,6 +111,7 @@ protected:
     virtual Widget* createCloneInstance() override;
     virtual void copySpecialProperties(Widget* model) override;
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _labelBMFontRendererAdaptDirty; }
 protected:
     Label* _labelBMFontRenderer;
     std::string _fntFileName;
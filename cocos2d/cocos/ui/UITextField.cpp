@@ -371,6 +371,11 @@ bool TextField::hitTest(const Vec2 &pt, const Camera* camera, Vec3* /*p*/) const
     return isScreenPointInRect(pt, camera, getWorldToNodeTransform(), rect, nullptr);
 }
 
+bool TextField::isHitTestInContentRect() const
+{
+    return false;
+}
+
 Size TextField::getTouchSize()const
 {
     return Size(_touchWidth, _touchHeight);
@@ -323,6 +323,11 @@ public:
     
     virtual bool hitTest(const Vec2 &pt, const Camera* camera, Vec3 *p) const override;
     
+    /**
+     * The touch size can be larger than the content, and touches that miss detach the IME.
+     */
+    virtual bool isHitTestInContentRect() const override;
+    
     
     /**
      * @brief Set placeholder of TextField.
@@ -668,6 +673,7 @@ protected:
     virtual Widget* createCloneInstance() override;
     virtual void copySpecialProperties(Widget* model) override;
     virtual void adaptRenderers() override;
+    virtual bool isAdaptRenderersDirty() const override { return _textFieldRendererAdaptDirty; }
 protected:
     UICCTextField* _textFieldRenderer;
 
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "base/CCDirector.h"
 #include "base/CCEventFocus.h"
 #include "base/CCEventDispatcher.h"
+#include "renderer/CCRenderer.h"
 #include "ui/UILayoutComponent.h"
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCGLProgramState.h"
@@ -257,6 +258,10 @@ void Widget::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t par
 {
     if (_visible)
     {
+        // adapting resizes and swaps the renderers, see Renderer::visitConcurrently()
+        if (isAdaptRenderersDirty() && renderer->deferVisit(this, parentTransform, parentFlags))
+            return;
+
         adaptRenderers();
         ProtectedNode::visit(renderer, parentTransform, parentFlags);
     }
@@ -587,6 +592,7 @@ void Widget::setTouchEnabled(bool enable)
         _touchListener = EventListenerTouchOneByOne::create();
         CC_SAFE_RETAIN(_touchListener);
         _touchListener->setSwallowTouches(true);
+        _touchListener->setHitTestFiltered(isHitTestInContentRect());
         _touchListener->onTouchBegan = CC_CALLBACK_2(Widget::onTouchBegan, this);
         _touchListener->onTouchMoved = CC_CALLBACK_2(Widget::onTouchMoved, this);
         _touchListener->onTouchEnded = CC_CALLBACK_2(Widget::onTouchEnded, this);
@@ -974,6 +980,11 @@ bool Widget::hitTest(const Vec2 &pt, const Camera* camera, Vec3 *p) const
     return isScreenPointInRect(pt, camera, getWorldToNodeTransform(), rect, p);
 }
 
+bool Widget::isHitTestInContentRect() const
+{
+    return true;
+}
+
 bool Widget::isClippingParentContainsPoint(const Vec2 &pt)
 {
     _affectByClipping = false;
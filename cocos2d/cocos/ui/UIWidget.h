@@ -552,6 +552,14 @@ public:
      */
     virtual bool hitTest(const Vec2 &pt, const Camera* camera, Vec3 *p) const;
 
+    /**
+     * Checks whether touches outside of the content rect can be skipped without calling onTouchBegan.
+     * Widgets that hit test a larger area, or handle touches that miss them, should return false.
+     *
+     * @return true if hitTest is false outside of the content rect and missed touches need no handling.
+     */
+    virtual bool isHitTestInContentRect() const;
+
     /**
      * A callback which will be called when touch began event is issued.
      *@param touch The touch info.
@@ -910,6 +918,8 @@ protected:
 
     
     virtual void adaptRenderers(){};
+    /** Whether adaptRenderers() has anything to adapt, which widgets overriding it report from their dirty flags */
+    virtual bool isAdaptRenderersDirty() const { return false; }
     void updateChildrenDisplayedRGBA();
     
     void copyProperties(Widget* model);
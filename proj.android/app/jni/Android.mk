@@ -17,6 +17,7 @@ $(LOCAL_PATH)/../../../Classes/engines/fmod/fmod_engine.cxx \
 $(LOCAL_PATH)/../../../Classes/engines/firebase/firebase_engine.cxx \
 $(LOCAL_PATH)/../../../Classes/engines/language/language_engine.cxx \
 $(LOCAL_PATH)/../../../Classes/engines/tmx/tmx_engine.cxx \
+$(LOCAL_PATH)/../../../Classes/engines/asset/asset_engine.cxx \
 $(LOCAL_PATH)/../../../Classes/entities/llumas/ivory/ivory_lluma.cxx \
 $(LOCAL_PATH)/../../../Classes/entities/llumas/base_lluma.cxx \
 $(LOCAL_PATH)/../../../Classes/entities/llurkers/ximois/ximois_llurker.cxx \
@@ -31,19 +32,30 @@ $(LOCAL_PATH)/../../../Classes/managers/sprite/sprite_manager.cxx \
 $(LOCAL_PATH)/../../../Classes/managers/text /text_manager.cxx \
 $(LOCAL_PATH)/../../../Classes/managers/base_manager.cxx \
 $(LOCAL_PATH)/../../../Classes/objects/tmx/tmx_object.cxx \
+$(LOCAL_PATH)/../../../Classes/objects/random/random_object.cxx \
+$(LOCAL_PATH)/../../../Classes/objects/compact/compact_value.cxx \
+$(LOCAL_PATH)/../../../Classes/objects/tmx/tmx_chunk_map.cxx \
 $(LOCAL_PATH)/../../../Classes/scenes/game/controls/controls_game_scene.cxx \
 $(LOCAL_PATH)/../../../Classes/scenes/game/base_game_scene.cxx \
 $(LOCAL_PATH)/../../../Classes/scenes/intro/intro_scene.cxx \
 $(LOCAL_PATH)/../../../Classes/scenes/levels/levels_scene.cxx \
 $(LOCAL_PATH)/../../../Classes/scenes/modes/modes_scene.cxx \
+$(LOCAL_PATH)/../../../Classes/scenes/benchmark/render_benchmark_scene.cxx \
+$(LOCAL_PATH)/../../../Classes/scenes/benchmark/physics_benchmark_scene.cxx \
+$(LOCAL_PATH)/../../../Classes/scenes/benchmark/map_benchmark_scene.cxx \
+$(LOCAL_PATH)/../../../Classes/scenes/benchmark/particle_benchmark_scene.cxx \
+$(LOCAL_PATH)/../../../Classes/scenes/benchmark/parse_benchmark_scene.cxx \
+$(LOCAL_PATH)/../../../Classes/scenes/benchmark/scheduler_benchmark_scene.cxx \
 $(LOCAL_PATH)/../../../Classes/scenes/base_scene.cxx \
 $(LOCAL_PATH)/../../../Classes/sqleet/sqleet.c \
 $(LOCAL_PATH)/../../../Classes/utils/action/action_utils.cxx \
+$(LOCAL_PATH)/../../../Classes/utils/action/tween_action.cxx \
 $(LOCAL_PATH)/../../../Classes/utils/archive/archive_utils.cxx \
 $(LOCAL_PATH)/../../../Classes/utils/data/data_utils.cxx \
 $(LOCAL_PATH)/../../../Classes/utils/particle/particle_utils.cxx \
 $(LOCAL_PATH)/../../../Classes/utils/path/path_utils.cxx \
 $(LOCAL_PATH)/../../../Classes/utils/scene/scene_utils.cxx \
+$(LOCAL_PATH)/../../../Classes/utils/snapshot/snapshot_utils.cxx \
 $(LOCAL_PATH)/../../../Classes/utils/thread/thread_utils.cxx
 
 LOCAL_CFLAGS := -DSQLITE_HAS_CODEC
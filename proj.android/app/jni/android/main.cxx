@@ -15,4 +15,9 @@ std::unique_ptr<AppDelegate> appDelegate;
 void cocos_android_app_init(JNIEnv* env) {
     LOGD("cocos_android_app_init");
     appDelegate.reset(new AppDelegate());
-}
\ No newline at end of file
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_madebymozart_evermaze_AppActivity_nativeOnLowMemory(JNIEnv* env, jclass clazz) {
+    AppDelegate::applicationDidReceiveMemoryWarning();
+}
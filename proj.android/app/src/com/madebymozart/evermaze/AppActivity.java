@@ -58,6 +58,22 @@ public class AppActivity extends Cocos2dxActivity {
         super.onDestroy();
     }
 
+    @Override
+    public void onTrimMemory(int level) {
+        super.onTrimMemory(level);
+
+        // Only purge while the game is running low, not every time the app is backgrounded.
+        if (level != TRIM_MEMORY_RUNNING_LOW && level != TRIM_MEMORY_RUNNING_CRITICAL) return;
+        runOnGLThread(new Runnable() {
+            @Override
+            public void run() {
+                nativeOnLowMemory();
+            }
+        });
+    }
+
+    private static native void nativeOnLowMemory();
+
     static {
         if (BuildConfig.DEBUG) {
             System.loadLibrary("fmodL");
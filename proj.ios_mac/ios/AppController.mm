@@ -94,7 +94,9 @@ static AppDelegate s_sharedApplication;
 #pragma mark -
 #pragma mark Memory management
 
-- (void)applicationDidReceiveMemoryWarning:(UIApplication *)application {}
+- (void)applicationDidReceiveMemoryWarning:(UIApplication *)application {
+    AppDelegate::applicationDidReceiveMemoryWarning();
+}
 
 #if __has_feature(objc_arc)
 #else
@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+# Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+"""
+Moves the textures embedded in particle plists into the shared particle atlas.
+
+Particle Designer embeds each texture in its plist as a gzipped, base64 encoded image (`textureImageData`),
+which cocos2d-x has to decode every time an emitter is created. This script writes each embedded texture out
+to `particles/` (identical textures are written once), rewrites the plists to reference the texture by sprite
+frame name (`spriteFrameName`) instead, and packs `particles/` with `particles.tps`.
+
+TexturePacker is used when it is installed. Otherwise the atlas is packed here with the settings of
+`particles.tps` (no rotation, no trim, 1 pixel extrude, premultiplied RGBA8888, encrypted pvr.ccz), using a
+simple shelf layout instead of MaxRects. Only uncompressed 8 bit TIFFs and 8 bit PNGs can be read, which is
+what Particle Designer exports.
+
+Run it before xEncrypt so the rewritten plists and `packs/particles.plist` end up in the archive.
+"""
+
+import base64
+import glob
+import hashlib
+import os
+import plistlib
+import shutil
+import struct
+import subprocess
+import sys
+import zlib
+
+BASEDIR = os.path.dirname(os.path.abspath(__file__))
+SCRIPTS = os.path.join(BASEDIR, '..', 'xScripts')
+ASSETS = os.path.join(BASEDIR, 'particles')
+PROJECT = os.path.join(BASEDIR, 'particles.tps')
+TEXTURE = os.path.join(BASEDIR, '..', 'Resources', 'data', 'Tz3qW8nLbYc0RfKd')
+DATA = os.path.join(SCRIPTS, 'packs', 'particles.plist')
+
+# Content protection key of every .tps project, the same one AppDelegate gives ZipUtils.
+KEY = [0x3a701f23, 0xa2af6677, 0x5248175b, 0xe404f08e]
+
+# Pixels each frame is extruded by, as set in particles.tps.
+EXTRUDE = 1
+
+# Every plist that can contain a particle system.
+PLISTS = ['particles/*.plist', 'entities/*/*.plist']
+
+
+def decode(data):
+    """Decodes `textureImageData` the same way ParticleSystem::initWithDictionary does."""
+    raw = base64.b64decode(data)
+
+    # Particle Designer gzips the image, but older exports may be zlib or uncompressed.
+    try:
+        return zlib.decompress(raw, zlib.MAX_WBITS | 32)
+    except zlib.error:
+        return raw
+
+
+def extension(image):
+    """Particle Designer embeds png or tiff images. TexturePacker reads both but needs the extension."""
+    if image.startswith(b'II*\x00') or image.startswith(b'MM\x00*'):
+        return '.tiff'
+    if image.startswith(b'\xff\xd8'):
+        return '.jpg'
+    return '.png'
+
+
+def extract():
+    os.makedirs(ASSETS, exist_ok=True)
+    frames = {}
+    count = 0
+
+    for pattern in PLISTS:
+        for path in sorted(glob.glob(os.path.join(SCRIPTS, pattern))):
+            with open(path, 'rb') as f:
+                plist = plistlib.load(f)
+
+            if 'textureImageData' not in plist:
+                continue
+
+            # Name the frame after the texture, but share it with every plist that embeds the same image.
+            image = decode(plist['textureImageData'])
+            digest = hashlib.sha1(image).hexdigest()
+            if digest not in frames:
+                name = os.path.splitext(os.path.basename(plist.get('textureFileName') or path))[0]
+                frames[digest] = 'particle_' + name
+                with open(os.path.join(ASSETS, frames[digest] + extension(image)), 'wb') as f:
+                    f.write(image)
+
+            del plist['textureImageData']
+            plist['spriteFrameName'] = frames[digest]
+            with open(path, 'wb') as f:
+                plistlib.dump(plist, f)
+
+            print('{0} -> {1}'.format(os.path.relpath(path, SCRIPTS), frames[digest]))
+            count += 1
+
+    print('Extracted {0} textures from {1} plists'.format(len(frames), count))
+
+
+def read_tiff(image):
+    """Reads an uncompressed, 8 bit per sample TIFF into rows of RGBA pixels."""
+    order = '>' if image[:2] == b'MM' else '<'
+    offset = struct.unpack(order + 'I', image[4:8])[0]
+    count = struct.unpack(order + 'H', image[offset:offset + 2])[0]
+
+    tags = {}
+    for i in range(count):
+        entry = image[offset + 2 + i * 12:offset + 14 + i * 12]
+        tag, kind, length = struct.unpack(order + 'HHI', entry[:8])
+        size = {3: 2, 4: 4}.get(kind, 1)
+        fmt = {3: 'H', 4: 'I'}.get(kind, 'B')
+        data = entry[8:8 + length * size] if length * size <= 4 else \
+            image[struct.unpack(order + 'I', entry[8:])[0]:][:length * size]
+        tags[tag] = struct.unpack(order + fmt * length, data)
+
+    width, height = tags[256][0], tags[257][0]
+    samples = tags.get(277, (1,))[0]
+    if tags.get(259, (1,))[0] != 1 or set(tags.get(258, (8,))) != {8} or samples not in (3, 4):
+        raise ValueError('only uncompressed 8 bit RGB(A) TIFFs are supported')
+
+    pixels = b''.join(image[start:start + length] for start, length in zip(tags[273], tags[279]))
+    associated = tags.get(338, (0,))[0] == 1
+    return width, height, rgba(pixels, width, height, samples, associated)
+
+
+def read_png(image):
+    """Reads a non interlaced, 8 bit RGB(A) PNG into rows of RGBA pixels."""
+    offset, chunks = 8, []
+    while offset < len(image):
+        length, kind = struct.unpack('>I4s', image[offset:offset + 8])
+        chunks.append((kind, image[offset + 8:offset + 8 + length]))
+        offset += length + 12
+
+    width, height, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', chunks[0][1])
+    if depth != 8 or color not in (2, 6) or interlace:
+        raise ValueError('only non interlaced 8 bit RGB(A) PNGs are supported')
+
+    samples = 4 if color == 6 else 3
+    stride = width * samples
+    raw = zlib.decompress(b''.join(data for kind, data in chunks if kind == b'IDAT'))
+    pixels, previous = bytearray(), bytearray(stride)
+    for y in range(height):
+        kind, row = raw[y * (stride + 1)], bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for x in range(stride):
+            left = row[x - samples] if x >= samples else 0
+            up, corner = previous[x], previous[x - samples] if x >= samples else 0
+            if kind == 1:
+                row[x] = (row[x] + left) & 0xff
+            elif kind == 2:
+                row[x] = (row[x] + up) & 0xff
+            elif kind == 3:
+                row[x] = (row[x] + (left + up) // 2) & 0xff
+            elif kind == 4:
+                p = left + up - corner
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - corner)
+                row[x] = (row[x] + (left if pa <= pb and pa <= pc else up if pb <= pc else corner)) & 0xff
+        pixels += row
+        previous = row
+    return width, height, rgba(bytes(pixels), width, height, samples, False)
+
+
+def rgba(pixels, width, height, samples, associated):
+    """Splits pixels into rows of premultiplied RGBA, the way cocos2d-x decodes embedded particle textures."""
+    rows = []
+    for y in range(height):
+        row = bytearray()
+        for x in range(width):
+            pixel = pixels[(y * width + x) * samples:(y * width + x + 1) * samples]
+            alpha = pixel[3] if samples == 4 else 255
+            if associated:
+                row += bytes(pixel[:3]) + bytes([alpha])
+            else:
+                row += bytes((c * alpha + 127) // 255 for c in pixel[:3]) + bytes([alpha])
+        rows.append(row)
+    return rows
+
+
+def layout(sizes):
+    """Places the frames on shelves, trying every atlas width and keeping the one with the smallest area."""
+    order = sorted(range(len(sizes)), key=lambda i: (-sizes[i][1], -sizes[i][0]))
+    best = None
+    for width in range(max(w for w, _ in sizes), sum(w for w, _ in sizes) + 1):
+        x, y, shelf, places = 0, 0, 0, {}
+        for i in order:
+            w, h = sizes[i]
+            if x + w > width:
+                x, y, shelf = 0, y + shelf, 0
+            places[i] = (x, y)
+            x, shelf = x + w, max(shelf, h)
+        used = max(x + sizes[i][0] for i, (x, _) in places.items())
+        area = (used, y + shelf)
+        if best is None or area[0] * area[1] < best[0][0] * best[0][1]:
+            best = (area, places)
+    return best
+
+
+def encrypt(data):
+    """Encrypts a ccz body the way ZipUtils::decodeEncodedPvr decrypts it, returning the data and checksum."""
+    mask = 0xffffffff
+    key, total, z = [0] * 1024, 0, 0
+    for _ in range(6):
+        total = (total + 0x9e3779b9) & mask
+        e = (total >> 2) & 3
+        for p in range(1024):
+            y = key[(p + 1) % 1024]
+            mx = ((((z >> 5) ^ (y << 2)) & mask) + (((y >> 3) ^ (z << 4)) & mask)) & mask
+            mx ^= ((total ^ y) + (KEY[(p & 3) ^ e] ^ z)) & mask
+            key[p] = (key[p] + mx) & mask
+            z = key[p]
+
+    length = len(data) // 4
+    ints = list(struct.unpack('<{0}I'.format(length), data[:length * 4]))
+    checksum = 0
+    for value in ints[:128]:
+        checksum ^= value
+
+    # The first 512 ints are encrypted completely, then every 64th one.
+    b = 0
+    for i in list(range(min(length, 512))) + list(range(512, length, 64)):
+        ints[i] ^= key[b]
+        b = (b + 1) % 1024
+    return struct.pack('<{0}I'.format(length), *ints) + data[length * 4:], checksum
+
+
+def pack_manually():
+    names, images = [], []
+    for path in sorted(glob.glob(os.path.join(ASSETS, '*'))):
+        with open(path, 'rb') as f:
+            image = f.read()
+        if extension(image) == '.jpg':
+            raise ValueError('{0}: jpg textures are not supported'.format(path))
+        names.append(os.path.splitext(os.path.basename(path))[0])
+        images.append(read_tiff(image) if extension(image) == '.tiff' else read_png(image))
+
+    # Every frame is surrounded by a copy of its edge pixels so linear filtering doesn't bleed.
+    sizes = [(w + EXTRUDE * 2, h + EXTRUDE * 2) for w, h, _ in images]
+    (width, height), places = layout(sizes)
+    atlas = [bytearray(width * 4) for _ in range(height)]
+    frames = {}
+    for i, (w, h, rows) in enumerate(images):
+        x, y = places[i]
+        for dy in range(h + EXTRUDE * 2):
+            row = rows[min(max(dy - EXTRUDE, 0), h - 1)]
+            line = row[:4] * EXTRUDE + row + row[-4:] * EXTRUDE
+            atlas[y + dy][x * 4:(x + w + EXTRUDE * 2) * 4] = line
+
+        frames[names[i]] = {
+            'aliases': [],
+            'spriteOffset': '{0,0}',
+            'spriteSize': '{{{0},{1}}}'.format(w, h),
+            'spriteSourceSize': '{{{0},{1}}}'.format(w, h),
+            'textureRect': '{{{{{0},{1}}},{{{2},{3}}}}}'.format(x + EXTRUDE, y + EXTRUDE, w, h),
+            'textureRotated': False,
+        }
+
+    # PVR v3 header for premultiplied RGBA8888, then the pixels from the top row down.
+    pvr = struct.pack('<4sI8sIIIIIIIII', b'PVR\x03', 2, b'rgba\x08\x08\x08\x08', 0, 0, height, width, 1, 1, 1,
+                      1, 0) + b''.join(atlas)
+    body, checksum = encrypt(struct.pack('>I', len(pvr)) + zlib.compress(pvr, 9))
+    with open(TEXTURE, 'wb') as f:
+        f.write(b'CCZp' + struct.pack('>HHI', 0, 0, checksum) + body)
+
+    name = os.path.basename(TEXTURE) + '.pvr.ccz'
+    data = {
+        'frames': frames,
+        'metadata': {
+            'format': 3,
+            'pixelFormat': 'RGBA8888',
+            'premultiplyAlpha': True,
+            'realTextureFileName': name,
+            'size': '{{{0},{1}}}'.format(width, height),
+            'textureFileName': name,
+        },
+    }
+    with open(DATA, 'wb') as f:
+        plistlib.dump(data, f)
+
+    print('Packed {0} frames into a {1}x{2} atlas'.format(len(frames), width, height))
+
+
+def pack():
+    packer = shutil.which('TexturePacker')
+    if packer is None:
+        print('TexturePacker not found, packing particles.tps manually')
+        pack_manually()
+        return
+
+    subprocess.check_call([packer, PROJECT])
+
+    # Like every other texture in Resources/data, the atlas is shipped without an extension.
+    os.replace(TEXTURE + '.pvr.ccz', TEXTURE)
+
+
+if __name__ == '__main__':
+    extract()
+    if '--no-pack' not in sys.argv:
+        pack()
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+# Copyright (c) 2018 Mozart Alexander Louis. All rights reserved.
+"""
+Splits a TMX map into the chunked map format streamed by TmxChunkMap.
+
+A chunked map is a directory holding a `manifest.plist` (width, height, chunk_size, tile_size, spawn_x and
+spawn_y) and one `chunk_<x>_<y>.tmx` per chunk, where x and y are the position of the chunk in the chunk grid.
+Every chunk is a complete map with the tilesets of the source map and its own slice of every tile layer, so it
+can be parsed on its own. Chunks on the right and bottom edges are smaller when the map size isn't a multiple
+of the chunk size.
+
+Usage: chunk_tmx.py <map.tmx> <output directory> [--chunk-size 8] [--image HuU8CDaMcCP5WClY] [--spawn x,y]
+
+Maps exported from Tiled reference the tileset image next to the map. Pass `--image` to point the chunks at the
+texture in Resources/data instead, the way the maps in xScripts/tmx do.
+"""
+
+import argparse
+import base64
+import gzip
+import os
+import plistlib
+import shutil
+import xml.etree.ElementTree as ElementTree
+import zlib
+
+# Layer that the spawn point has to be on when it isn't given.
+PATH_LAYER = 'ui_layer'
+
+
+def decode(data):
+    """Reads the GIDs of a layer in any of the encodings Tiled writes."""
+    encoding = data.get('encoding')
+    compression = data.get('compression')
+
+    if encoding == 'csv':
+        return [int(gid) for gid in data.text.replace('\n', '').split(',') if gid.strip()]
+
+    if encoding == 'base64':
+        raw = base64.b64decode(data.text.strip())
+        if compression == 'zlib':
+            raw = zlib.decompress(raw)
+        elif compression == 'gzip':
+            raw = gzip.decompress(raw)
+        return [int.from_bytes(raw[i:i + 4], 'little') for i in range(0, len(raw), 4)]
+
+    return [int(tile.get('gid', 0)) for tile in data.findall('tile')]
+
+
+def spawn(layers, width, height):
+    """Picks the tile on the path layer closest to the center of the map."""
+    gids = layers.get(PATH_LAYER)
+    if gids is None:
+        return width // 2, height // 2
+
+    tiles = [(x, y) for y in range(height) for x in range(width) if gids[y * width + x] != 0]
+    if not tiles:
+        return width // 2, height // 2
+    return min(tiles, key=lambda tile: abs(tile[0] - width // 2) + abs(tile[1] - height // 2))
+
+
+def chunk(source, output, size, image, point):
+    tree = ElementTree.parse(source)
+    root = tree.getroot()
+    width = int(root.get('width'))
+    height = int(root.get('height'))
+    tile = int(root.get('tilewidth'))
+
+    # Read every tile layer once.
+    layers = {}
+    for layer in root.findall('layer'):
+        layers[layer.get('name')] = decode(layer.find('data'))
+
+    if image is not None:
+        for tileset in root.findall('tileset'):
+            tileset.find('image').set('source', image)
+
+    if os.path.isdir(output):
+        shutil.rmtree(output)
+    os.makedirs(output)
+
+    chunks_wide = (width + size - 1) // size
+    chunks_high = (height + size - 1) // size
+    for cy in range(chunks_high):
+        for cx in range(chunks_wide):
+            x0, y0 = cx * size, cy * size
+            w, h = min(size, width - x0), min(size, height - y0)
+
+            # Everything but the layers is copied as is, so tilesets and map properties carry over.
+            map_element = ElementTree.Element('map', dict(root.attrib, width=str(w), height=str(h)))
+            for element in root:
+                if element.tag != 'layer':
+                    map_element.append(element)
+                    continue
+
+                gids = layers[element.get('name')]
+                layer = ElementTree.SubElement(map_element, 'layer', dict(element.attrib, width=str(w),
+                                                                           height=str(h)))
+                data = ElementTree.SubElement(layer, 'data', encoding='csv')
+                rows = [','.join(str(gids[(y0 + y) * width + x0 + x]) for x in range(w)) for y in range(h)]
+                data.text = '\n' + ',\n'.join(rows) + '\n'
+
+            ElementTree.indent(map_element, space=' ')
+            ElementTree.ElementTree(map_element).write(
+                os.path.join(output, 'chunk_{0}_{1}.tmx'.format(cx, cy)), encoding='UTF-8',
+                xml_declaration=True)
+
+    spawn_x, spawn_y = point if point is not None else spawn(layers, width, height)
+    manifest = {
+        'width': width,
+        'height': height,
+        'chunk_size': size,
+        'tile_size': tile,
+        'spawn_x': spawn_x,
+        'spawn_y': spawn_y,
+    }
+    with open(os.path.join(output, 'manifest.plist'), 'wb') as f:
+        plistlib.dump(manifest, f)
+
+    print('{0}: {1}x{2} tiles -> {3}x{4} chunks of {5}'.format(os.path.basename(source), width, height,
+                                                              chunks_wide, chunks_high, size))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Splits a TMX map into streamable chunks.')
+    parser.add_argument('source')
+    parser.add_argument('output')
+    parser.add_argument('--chunk-size', type=int, default=8)
+    parser.add_argument('--image')
+    parser.add_argument('--spawn', type=lambda s: tuple(int(v) for v in s.split(',')))
+    args = parser.parse_args()
+    chunk(args.source, args.output, args.chunk_size, args.image, args.spawn)